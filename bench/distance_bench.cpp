@@ -0,0 +1,79 @@
+#include "distance.hpp"
+#include "scenes.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace perf_boost {
+    namespace {
+        void BM_FastApproxDistance(benchmark::State &state) {
+            auto &world = sim::SimObjectManager::Instance();
+            auto objects = sim::BuildCity(world, 300);
+
+            for (auto _: state) {
+                for (auto object: objects) {
+                    C3Vector v = object->position;
+                    benchmark::DoNotOptimize(fastApproxDistance(v));
+                }
+            }
+            state.SetItemsProcessed(state.iterations() * objects.size());
+        }
+
+        // the same 300 positions gathered into a batch, approximate vs exact squared distances to the player
+        PositionBatch CityBatch() {
+            auto &world = sim::SimObjectManager::Instance();
+            PositionBatch batch;
+            for (auto object: sim::BuildCity(world, 300)) {
+                batch.push_back(object->position);
+            }
+            return batch;
+        }
+
+        void BM_ApproxDistanceBetweenBatch(benchmark::State &state) {
+            auto batch = CityBatch();
+            C3Vector origin;
+            std::vector<int> out(batch.size());
+
+            for (auto _: state) {
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    C3Vector position;
+                    position.x = batch.x[i];
+                    position.y = batch.y[i];
+                    position.z = batch.z[i];
+                    out[i] = ApproximateDistanceBetween(position, origin);
+                }
+                benchmark::DoNotOptimize(out.data());
+            }
+            state.SetItemsProcessed(state.iterations() * batch.size());
+        }
+
+        void BM_SquaredDistancesScalar(benchmark::State &state) {
+            auto batch = CityBatch();
+            C3Vector origin;
+            std::vector<float> out(batch.size());
+
+            for (auto _: state) {
+                SquaredDistancesToScalar(origin, batch.x.data(), batch.y.data(), batch.z.data(), batch.size(),
+                                         out.data());
+                benchmark::DoNotOptimize(out.data());
+            }
+            state.SetItemsProcessed(state.iterations() * batch.size());
+        }
+
+        void BM_SquaredDistancesBatch(benchmark::State &state) {
+            auto batch = CityBatch();
+            C3Vector origin;
+            std::vector<float> out;
+
+            for (auto _: state) {
+                SquaredDistancesTo(origin, batch, out);
+                benchmark::DoNotOptimize(out.data());
+            }
+            state.SetItemsProcessed(state.iterations() * batch.size());
+        }
+
+        BENCHMARK(BM_FastApproxDistance);
+        BENCHMARK(BM_ApproxDistanceBetweenBatch);
+        BENCHMARK(BM_SquaredDistancesScalar);
+        BENCHMARK(BM_SquaredDistancesBatch);
+    }
+}
@@ -0,0 +1,28 @@
+#include "event_cost.hpp"
+#include "settings.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace perf_boost {
+    namespace {
+        // bookkeeping added to every measured OnEvent call, a raid fires a few thousand a second
+        void BM_EventCostBeginEnd(benchmark::State &state) {
+            applyDefaultSettings();
+            ResetEventCost();
+            updateFromCvar("PB_MeasureEvents", "1");
+            const char *frames[] = {"DBM", "pfUIUnitFrameRaid12", "anonymous", "BigWigs"};
+            const char *events[] = {"UNIT_HEALTH", "UNIT_AURA", "CHAT_MSG_ADDON", "COMBAT_LOG_EVENT"};
+
+            size_t i = 0;
+            for (auto _: state) {
+                EventCostBegin();
+                EventCostEnd(frames[i % 4], events[(i / 4) % 4]);
+                ++i;
+            }
+            state.SetItemsProcessed(state.iterations());
+            ResetEventCost();
+        }
+
+        BENCHMARK(BM_EventCostBeginEnd);
+    }
+}
@@ -0,0 +1,47 @@
+#include "render.hpp"
+#include "scenes.hpp"
+#include "settings.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace perf_boost {
+    namespace {
+        // one iteration is one frame: BeginFrame, a ShouldRender query for every object, EndFrame
+        void RunFrames(benchmark::State &state, const std::vector<sim::SimObject *> &objects) {
+            for (auto _: state) {
+                BeginFrame();
+                for (auto object: objects) {
+                    benchmark::DoNotOptimize(shouldRenderObject(object->ptr(), 1));
+                }
+                EndFrame();
+            }
+            state.SetItemsProcessed(state.iterations() * objects.size());
+        }
+
+        void BM_ShouldRender_RaidStack(benchmark::State &state) {
+            auto objects = sim::BuildRaidStack(sim::SimObjectManager::Instance());
+            applyDefaultSettings();
+            updateFromCvar("PB_PlayerRenderDistInCombat", "10");
+            updateFromCvar("PB_PetRenderDistInCombat", "0");
+            updateFromCvar("PB_SummonRenderDistInCombat", "0");
+            updateFromCvar("PB_TrashUnitRenderDistInCombat", "40");
+
+            RunFrames(state, objects);
+        }
+
+        void BM_ShouldRender_City(benchmark::State &state) {
+            auto objects = sim::BuildCity(sim::SimObjectManager::Instance(), static_cast<int>(state.range(0)));
+            applyDefaultSettings();
+            updateFromCvar("PB_PlayerRenderDist", "60");
+            updateFromCvar("PB_PlayerRenderDistInCities", "30");
+            updateFromCvar("PB_AlwaysRenderPVP", "1");
+            // names that never resolve so the AlwaysRender list is walked every query
+            updateFromCvar("PB_AlwaysRenderPlayers", "Nobody,NotHere,Offline");
+
+            RunFrames(state, objects);
+        }
+
+        BENCHMARK(BM_ShouldRender_RaidStack);
+        BENCHMARK(BM_ShouldRender_City)->Arg(300);
+    }
+}
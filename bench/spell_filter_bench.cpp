@@ -0,0 +1,63 @@
+#include "render.hpp"
+#include "scenes.hpp"
+#include "settings.hpp"
+#include "spell_visuals.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace perf_boost {
+    namespace {
+        // A raid worth of casters each asking about a spell that is on neither list, the worst case for the linear
+        // list scans.  range(0) is the length of both the hidden and always shown lists.
+        void BM_ShouldHideSpellForUnit(benchmark::State &state) {
+            auto objects = sim::BuildRaidStack(sim::SimObjectManager::Instance());
+            auto &world = sim::SimObjectManager::Instance();
+            auto numIds = static_cast<int>(state.range(0));
+
+            applyDefaultSettings();
+            updateFromCvar("PB_HiddenSpellIds", sim::BuildSpellIdList(numIds, 10000, 2).c_str());
+            updateFromCvar("PB_AlwaysShownSpellIds", sim::BuildSpellIdList(numIds, 10001, 2).c_str());
+            auto &spell = world.AddSpell(5);
+            BeginFrame();
+
+            for (auto _: state) {
+                for (auto object: objects) {
+                    benchmark::DoNotOptimize(shouldHideSpellForUnit(object->ptr(), &spell));
+                }
+            }
+            state.SetItemsProcessed(state.iterations() * objects.size());
+            EndFrame();
+        }
+
+        void BM_ShouldHideDynamicObjectVisual(benchmark::State &state) {
+            auto objects = sim::BuildRaidStack(sim::SimObjectManager::Instance());
+            auto &world = sim::SimObjectManager::Instance();
+            auto numIds = static_cast<int>(state.range(0));
+
+            applyDefaultSettings();
+            updateFromCvar("PB_HiddenSpellIds", sim::BuildSpellIdList(numIds, 10000, 2).c_str());
+            world.AddSpell(10).Effect[0] = 27;
+
+            // every raider drops a ground effect
+            std::vector<uintptr_t *> groundEffects;
+            uint64_t guid = 100000;
+            for (auto object: objects) {
+                if (object->type == OBJECT_TYPE_PLAYER) {
+                    groundEffects.push_back(world.AddDynamicObject(guid++, object->guid, 10, object->position).ptr());
+                }
+            }
+            BeginFrame();
+
+            for (auto _: state) {
+                for (auto dynamicObj: groundEffects) {
+                    benchmark::DoNotOptimize(shouldHideDynamicObjectVisual(dynamicObj));
+                }
+            }
+            state.SetItemsProcessed(state.iterations() * groundEffects.size());
+            EndFrame();
+        }
+
+        BENCHMARK(BM_ShouldHideSpellForUnit)->Arg(0)->Arg(10)->Arg(1000);
+        BENCHMARK(BM_ShouldHideDynamicObjectVisual)->Arg(0)->Arg(1000);
+    }
+}
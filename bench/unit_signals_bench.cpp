@@ -0,0 +1,25 @@
+#include "settings.hpp"
+#include "unit_signals.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace perf_boost {
+    namespace {
+        // the names SendUnitSignal fans a single raid member's UNIT_HEALTH out to with SuperWoW loaded
+        void BM_ShouldFilterGuidEvent(benchmark::State &state) {
+            applyDefaultSettings();
+            const char *names[] = {"raid17", "party2", "target", "0x0000000000012345", "mouseover"};
+
+            uint32_t eventCode = 0;
+            for (auto _: state) {
+                for (auto name: names) {
+                    benchmark::DoNotOptimize(shouldFilterGuidEvent(name, eventCode));
+                }
+                eventCode = (eventCode + 1) % 400;
+            }
+            state.SetItemsProcessed(state.iterations() * 5);
+        }
+
+        BENCHMARK(BM_ShouldFilterGuidEvent);
+    }
+}
@@ -0,0 +1,79 @@
+#include "animation_lod.hpp"
+#include "distance.hpp"
+#include "game_view.hpp"
+#include "render.hpp"
+#include "settings.hpp"
+#include "stats.hpp"
+
+#include <unordered_map>
+
+namespace perf_boost {
+    namespace {
+        // ObjectFree keeps this in step with the object manager, this only guards against missed frees
+        const size_t kMaxDeferredUnits = 8192;
+
+        // time step held back from each unit since it last animated
+        std::unordered_map<uint64_t, int32_t> deferredSteps;
+    }
+
+    int AnimationIntervalForDistanceSq(float distanceSq) {
+        // tiers are sorted by distance
+        int interval = 1;
+        for (const auto &tier: animationLodTiers) {
+            if (distanceSq < tier.first) {
+                break;
+            }
+            interval = tier.second;
+        }
+        return interval;
+    }
+
+    int32_t AnimationStepForUnit(uintptr_t *unitPtr, int32_t elapsed) {
+        if (animationLodTiers.empty() || !gPlayerUnit || unitPtr == gPlayerUnit) {
+            if (!deferredSteps.empty()) {
+                // tiers turned off, hand back what is still held
+                auto it = deferredSteps.find(UnitGetGuid(unitPtr));
+                if (it != deferredSteps.end()) {
+                    elapsed += it->second;
+                    deferredSteps.erase(it);
+                }
+            }
+            return elapsed;
+        }
+
+        // tiers are measured from the same place as render distances
+        auto distanceSq = SquaredDistanceBetween(UnitGetPosition(unitPtr),
+                                                 gViewFromCamera ? gViewPosition : gPlayerPosition);
+        auto interval = static_cast<uint32_t>(AnimationIntervalForDistanceSq(distanceSq));
+        auto guid = UnitGetGuid(unitPtr);
+        if (interval > 1) {
+            auto phase = static_cast<uint32_t>(guid ^ (guid >> 32));
+            if ((gFrameIndex + phase) % interval != 0) {
+                if (deferredSteps.size() >= kMaxDeferredUnits) {
+                    deferredSteps.clear();
+                }
+                deferredSteps[guid] += elapsed;
+                CountAnimation(false);
+                return 0;
+            }
+        }
+
+        auto it = deferredSteps.find(guid);
+        if (it != deferredSteps.end()) {
+            elapsed += it->second;
+            deferredSteps.erase(it);
+        }
+        CountAnimation(true);
+        return elapsed;
+    }
+
+    void ForgetAnimation(uint64_t guid) {
+        if (!deferredSteps.empty()) {
+            deferredSteps.erase(guid);
+        }
+    }
+
+    void ResetAnimationLod() {
+        deferredSteps.clear();
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+namespace perf_boost {
+    // Distance tiered animation rate for units.  PB_AnimationLodTiers is a list of distance:interval pairs, a unit at
+    // least distance yards away advances its animation every interval frames.  CGUnit::Animate still runs every frame,
+    // only its time step is held back and handed over in one go on the frames the unit animates, so models keep their
+    // speed and never fall behind.  Units are staggered by guid so a tier's units don't all animate on the same frame.
+
+    // elapsed is this frame's step for the unit, returns the step to animate it with: 0 on a deferred frame, or the
+    // step plus everything deferred since it last animated
+    int32_t AnimationStepForUnit(uintptr_t *unitPtr, int32_t elapsed);
+
+    // frames between animations for a unit this far away, squared
+    int AnimationIntervalForDistanceSq(float distanceSq);
+
+    // drop a unit's deferred time, from ObjectFree
+    void ForgetAnimation(uint64_t guid);
+    void ResetAnimationLod();
+}
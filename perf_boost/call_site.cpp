@@ -0,0 +1,67 @@
+#include "call_site.hpp"
+
+namespace perf_boost {
+    bool ReadCallTarget(const uint8_t *code, uint32_t address, uint32_t &target) {
+        if (code[0] != kCallRel32Opcode) {
+            return false;
+        }
+
+        target = Rel32Target(code, address);
+        return true;
+    }
+
+    void WriteCallTarget(uint8_t *code, uint32_t address, uint32_t target) {
+        WriteRel32(code, address, kCallRel32Opcode, target);
+    }
+
+    bool PatchCallSite(CallSite &site, uint8_t *code) {
+        uint32_t target;
+        if (!ReadCallTarget(code, site.address, target) || (target != site.original && target != site.handler)) {
+            site.status = CALL_SITE_MISMATCH;
+            return false;
+        }
+
+        WriteCallTarget(code, site.address, site.handler);
+        site.status = CALL_SITE_PATCHED;
+        return true;
+    }
+
+    bool RestoreCallSite(CallSite &site, uint8_t *code) {
+        // don't undo someone else's patch on top of ours
+        if (site.status != CALL_SITE_PATCHED || !VerifyCallSite(site, code)) {
+            return false;
+        }
+
+        WriteCallTarget(code, site.address, site.original);
+        site.status = CALL_SITE_PENDING;
+        return true;
+    }
+
+    bool VerifyCallSite(const CallSite &site, const uint8_t *code) {
+        uint32_t target;
+        if (!ReadCallTarget(code, site.address, target)) {
+            return site.status == CALL_SITE_MISMATCH;
+        }
+
+        switch (site.status) {
+            case CALL_SITE_PATCHED:
+                return target == site.handler;
+            case CALL_SITE_PENDING:
+                return target == site.original;
+            default:
+                return target != site.original && target != site.handler;
+        }
+    }
+
+    const char *CallSiteStatusName(CALL_SITE_STATUS status) {
+        switch (status) {
+            case CALL_SITE_PENDING:
+                return "pending";
+            case CALL_SITE_PATCHED:
+                return "patched";
+            case CALL_SITE_MISMATCH:
+                return "mismatch";
+        }
+        return "unknown";
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "x86_codegen.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace perf_boost {
+    // Redirecting individual x86 call instructions instead of detouring the whole callee.  Only `call rel32` (E8) is
+    // patched, and only when it still calls the expected function, so a client build with different code is left
+    // alone.  Addresses are the 32 bit client's.  The bytes are passed separately from the address so the encoding can
+    // be tested on buffers on the host, the DLL passes the code itself and makes it writable first.
+
+    const size_t kCallRel32Size = kRel32Size;
+
+    enum CALL_SITE_STATUS {
+        CALL_SITE_PENDING,
+        CALL_SITE_PATCHED,
+        CALL_SITE_MISMATCH,  // not a call to original, left untouched
+    };
+
+    struct CallSite {
+        const char *name;
+        uint32_t address;   // of the call instruction, the return address minus 5
+        uint32_t original;  // function it calls in an unmodified client
+        uint32_t handler;   // function it calls once patched
+        CALL_SITE_STATUS status;
+    };
+
+    // target of the call instruction in code, false if it isn't a call rel32
+    bool ReadCallTarget(const uint8_t *code, uint32_t address, uint32_t &target);
+    void WriteCallTarget(uint8_t *code, uint32_t address, uint32_t target);
+
+    // point the call at site.handler if it calls site.original, updates site.status
+    bool PatchCallSite(CallSite &site, uint8_t *code);
+    // point a patched call back at site.original, false if it no longer calls site.handler
+    bool RestoreCallSite(CallSite &site, uint8_t *code);
+    // true if code still calls what site.status says it should
+    bool VerifyCallSite(const CallSite &site, const uint8_t *code);
+
+    const char *CallSiteStatusName(CALL_SITE_STATUS status);
+}
@@ -0,0 +1,123 @@
+#include "creatures.hpp"
+#include "game_view.hpp"
+#include "settings.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace perf_boost {
+    namespace {
+        struct TrashVerdict {
+            bool trash;
+            // decided by max health per raid member
+            bool byHealth;
+        };
+
+        std::unordered_map<uint32_t, TrashVerdict> trashByEntry;
+        uint32_t raidSize = 40;
+        uint32_t creatureClassVersion = 0;
+        uint32_t creatureRaidSizeVersion = 0;
+        uint32_t creatureClassSettingsVersion = ~0u;
+
+        void Invalidate() {
+            trashByEntry.clear();
+            ++creatureClassVersion;
+        }
+
+        void CheckSettings() {
+            if (creatureClassSettingsVersion != gCreatureSettingsVersion) {
+                creatureClassSettingsVersion = gCreatureSettingsVersion;
+                Invalidate();
+            }
+        }
+
+        bool Contains(const std::vector<uint32_t> &ids, uint32_t entry) {
+            return std::find(ids.begin(), ids.end(), entry) != ids.end();
+        }
+
+        TrashVerdict ClassifyTrash(uint32_t entry, CreatureRank rank, const UnitFields *unitFields) {
+            if (entry != 0) {
+                if (Contains(trashCreatureIds, entry)) {
+                    return {true, false};
+                }
+                if (Contains(bossCreatureIds, entry)) {
+                    return {false, false};
+                }
+            }
+
+            if (rank == CREATURE_RANK_UNKNOWN) {
+                return {unitFields->level < 63, false};
+            }
+            if (rank == CREATURE_RANK_WORLDBOSS) {
+                return {false, false};
+            }
+            if (bossHealthPerPlayer > 0) {
+                return {unitFields->maxHealth < static_cast<uint64_t>(bossHealthPerPlayer) * raidSize, true};
+            }
+            return {true, false};
+        }
+    }
+
+    bool IsTrashCreature(uintptr_t *unitPtr, const UnitFields *unitFields) {
+        CheckSettings();
+
+        auto entry = UnitGetCreatureEntry(unitPtr);
+        if (entry != 0) {
+            auto it = trashByEntry.find(entry);
+            if (it != trashByEntry.end()) {
+                return it->second.trash;
+            }
+        }
+
+        auto rank = UnitGetCreatureRank(unitPtr);
+        auto verdict = ClassifyTrash(entry, rank, unitFields);
+        // only remember answers that won't change once the cache record arrives
+        if (entry != 0 && rank != CREATURE_RANK_UNKNOWN) {
+            trashByEntry.emplace(entry, verdict);
+        }
+        return verdict.trash;
+    }
+
+    uint32_t RaidSizeForPlayerCount(uint32_t players) {
+        if (players <= 5) {
+            return 5;
+        } else if (players <= 10) {
+            return 10;
+        } else if (players <= 20) {
+            return 20;
+        }
+        return 40;
+    }
+
+    void SetGroupSize(uint32_t members) {
+        auto size = RaidSizeForPlayerCount(members + 1);
+        if (size == raidSize) {
+            return;
+        }
+
+        raidSize = size;
+        for (auto it = trashByEntry.begin(); it != trashByEntry.end();) {
+            if (it->second.byHealth) {
+                it = trashByEntry.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        ++creatureRaidSizeVersion;
+    }
+
+    uint32_t CreatureClassVersion() {
+        CheckSettings();
+        return creatureClassVersion;
+    }
+
+    uint32_t CreatureRaidSizeVersion() {
+        return creatureRaidSizeVersion;
+    }
+
+    void ClearCreatureClassCache() {
+        raidSize = 40;
+        ++creatureRaidSizeVersion;
+        Invalidate();
+    }
+}
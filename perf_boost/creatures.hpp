@@ -0,0 +1,28 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstdint>
+
+namespace perf_boost {
+    // Trash or boss for NPCs that aren't player controlled, in order:
+    //  - PB_TrashCreatureIds / PB_BossCreatureIds
+    //  - world boss rank ("??" skull) is a boss
+    //  - max health of at least PB_BossHealthPerPlayer per raid member is a boss
+    //  - anything else with a known rank is trash, so level 62-63 elite packs are culled too
+    //  - level < 63 is trash while the creature cache record hasn't arrived
+    // Answers are memoized per creature entry.
+    bool IsTrashCreature(uintptr_t *unitPtr, const UnitFields *unitFields);
+
+    // 5, 10, 20 or 40 for the number of players in the group including us, the raid sizes the health rule scales with
+    uint32_t RaidSizeForPlayerCount(uint32_t players);
+
+    // group members besides us, see GroupMemberCount in importance.hpp.  Done by BeginFrame
+    void SetGroupSize(uint32_t members);
+
+    // changes whenever earlier IsTrashCreature answers may no longer hold
+    uint32_t CreatureClassVersion();
+    // changes with the raid size, only answers made by the health rule are affected
+    uint32_t CreatureRaidSizeVersion();
+    void ClearCreatureClassCache();
+}
@@ -0,0 +1,62 @@
+#include "detour.hpp"
+#include "logging.hpp"
+#include "x86_codegen.hpp"
+
+#include <Windows.h>
+
+namespace perf_boost {
+    namespace {
+        // trampolines for every detour share one executable page
+        const size_t kTrampolinePageSize = 4096;
+        uint8_t *gTrampolinePage = nullptr;
+        size_t gTrampolinePageUsed = 0;
+
+        uint8_t *AllocateTrampoline() {
+            if (!gTrampolinePage) {
+                gTrampolinePage = static_cast<uint8_t *>(VirtualAlloc(nullptr, kTrampolinePageSize,
+                                                                      MEM_COMMIT | MEM_RESERVE,
+                                                                      PAGE_EXECUTE_READWRITE));
+                if (!gTrampolinePage) {
+                    return nullptr;
+                }
+            }
+            if (gTrampolinePageUsed + kMaxTrampolineSize > kTrampolinePageSize) {
+                return nullptr;
+            }
+            return gTrampolinePage + gTrampolinePageUsed;
+        }
+    }
+
+    bool InstallDetour(uintptr_t address, const void *handler, void **trampoline) {
+        auto trampolineCode = AllocateTrampoline();
+        if (!trampolineCode) {
+            DEBUG_LOG("No room for another trampoline, detouring 0x" << std::hex << address << std::dec);
+            return false;
+        }
+
+        auto function = reinterpret_cast<uint8_t *>(address);
+        auto stolen = BuildTrampoline(function, static_cast<uint32_t>(address), trampolineCode,
+                                      reinterpret_cast<uint32_t>(trampolineCode));
+        if (stolen == 0) {
+            DEBUG_LOG("Unable to relocate the start of 0x" << std::hex << address << std::dec);
+            return false;
+        }
+
+        DWORD oldProtect;
+        if (!VirtualProtect(function, stolen, PAGE_EXECUTE_READWRITE, &oldProtect)) {
+            DEBUG_LOG("Unable to make 0x" << std::hex << address << std::dec << " writable");
+            return false;
+        }
+        gTrampolinePageUsed += kMaxTrampolineSize;
+        FlushInstructionCache(GetCurrentProcess(), trampolineCode, kMaxTrampolineSize);
+
+        // hooks are installed from the main thread during load so nothing is running the bytes being replaced
+        *trampoline = trampolineCode;
+        WriteDetourJump(function, static_cast<uint32_t>(address), reinterpret_cast<uint32_t>(handler), stolen);
+        VirtualProtect(function, stolen, oldProtect, &oldProtect);
+        FlushInstructionCache(GetCurrentProcess(), function, stolen);
+
+        DEBUG_LOG("Detoured 0x" << std::hex << address << std::dec << ", moved " << stolen << " bytes");
+        return true;
+    }
+}
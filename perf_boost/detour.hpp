@@ -0,0 +1,46 @@
+#pragma once
+
+#include <hadesmem/patcher.hpp>
+
+#include <cstdint>
+
+namespace perf_boost {
+    // Minimal detours for the hooks called hundreds of times a frame.  Unlike hadesmem::PatchDetour the client jumps
+    // straight into a handler with the hooked function's own signature and calling convention, which calls the
+    // original through a static trampoline pointer.  There's no detour context to look up and no return address
+    // recorded, a handler that needs its caller uses _ReturnAddress().
+
+    // Writes a jmp to handler over the start of the function at address and sets *trampoline to a copy of the
+    // overwritten instructions followed by a jmp back.  False and nothing changed if they can't be moved.
+    bool InstallDetour(uintptr_t address, const void *handler, void **trampoline);
+
+    template<typename FuncT, FuncT Handler>
+    struct StaticDetour;
+
+    template<typename R, typename... Args, R (__fastcall *Handler)(Args...)>
+    struct StaticDetour<R (__fastcall *)(Args...), Handler> {
+        using FuncT = R (__fastcall *)(Args...);
+
+        // the original function, only valid once installed
+        static FuncT Original;
+
+        static bool Install(uintptr_t address) {
+            void *trampoline = nullptr;
+            if (!InstallDetour(address, reinterpret_cast<const void *>(Handler), &trampoline)) {
+                return false;
+            }
+            Original = reinterpret_cast<FuncT>(trampoline);
+            return true;
+        }
+
+        // hadesmem::PatchDetour hook for when the function's start can't be moved, Original has to be set to the
+        // detour's trampoline after applying it
+        static R Fallback(hadesmem::PatchDetourBase *, Args... args) {
+            return Handler(args...);
+        }
+    };
+
+    template<typename R, typename... Args, R (__fastcall *Handler)(Args...)>
+    typename StaticDetour<R (__fastcall *)(Args...), Handler>::FuncT
+            StaticDetour<R (__fastcall *)(Args...), Handler>::Original = nullptr;
+}
@@ -0,0 +1,77 @@
+#include "distance.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PERF_BOOST_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace perf_boost {
+    float fastApproxDistance(C3Vector &vec) {
+        // Manhattan distance (fastest, ~2-3x error)
+        // return std::abs(vec.x) + std::abs(vec.y) + std::abs(vec.z);
+
+        // Octagonal approximation (fast, ~8% max error)
+        float ax = std::abs(vec.x);
+        float ay = std::abs(vec.y);
+        float az = std::abs(vec.z);
+
+        // Sort components so ax >= ay >= az
+        if (ax < ay) std::swap(ax, ay);
+        if (ay < az) std::swap(ay, az);
+        if (ax < ay) std::swap(ax, ay);
+
+        // Approximation: largest + 0.5*middle + 0.25*smallest
+        return ax + 0.5f * ay + 0.25f * az;
+    }
+
+    int ApproximateDistanceBetween(const C3Vector &pos0, const C3Vector &pos1) {
+        C3Vector v = {};
+        v.x = pos0.x - pos1.x;
+        v.y = pos0.y - pos1.y;
+        v.z = pos0.z - pos1.z;
+        return (int) fastApproxDistance(v);
+    }
+
+    void SquaredDistancesToScalar(const C3Vector &origin, const float *x, const float *y, const float *z,
+                                  size_t count, float *out) {
+        for (size_t i = 0; i < count; ++i) {
+            float dx = x[i] - origin.x;
+            float dy = y[i] - origin.y;
+            float dz = z[i] - origin.z;
+            out[i] = dx * dx + dy * dy + dz * dz;
+        }
+    }
+
+    void SquaredDistancesTo(const C3Vector &origin, const float *x, const float *y, const float *z, size_t count,
+                            float *out) {
+#ifdef PERF_BOOST_SSE2
+        const __m128 ox = _mm_set1_ps(origin.x);
+        const __m128 oy = _mm_set1_ps(origin.y);
+        const __m128 oz = _mm_set1_ps(origin.z);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), ox);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), oy);
+            __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), oz);
+            // same operation order as the scalar loop so both give identical results
+            __m128 sum = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            _mm_storeu_ps(out + i, sum);
+        }
+
+        SquaredDistancesToScalar(origin, x + i, y + i, z + i, count - i, out + i);
+#else
+        SquaredDistancesToScalar(origin, x, y, z, count, out);
+#endif
+    }
+
+    void SquaredDistancesTo(const C3Vector &origin, const PositionBatch &batch, std::vector<float> &out) {
+        out.resize(batch.size());
+        if (!out.empty()) {
+            SquaredDistancesTo(origin, batch.x.data(), batch.y.data(), batch.z.data(), batch.size(), out.data());
+        }
+    }
+}
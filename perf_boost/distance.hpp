@@ -0,0 +1,53 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace perf_boost {
+    // Octagonal approximation of the length of vec, ~8% max error
+    float fastApproxDistance(C3Vector &vec);
+
+    int ApproximateDistanceBetween(const C3Vector &pos0, const C3Vector &pos1);
+
+    // exact, compare against a squared threshold instead of taking the root
+    inline float SquaredDistanceBetween(const C3Vector &pos0, const C3Vector &pos1) {
+        float dx = pos0.x - pos1.x;
+        float dy = pos0.y - pos1.y;
+        float dz = pos0.z - pos1.z;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    // Positions of a batch of objects split into x/y/z arrays so 4 can be processed per SSE instruction
+    struct PositionBatch {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+
+        void clear() {
+            x.clear();
+            y.clear();
+            z.clear();
+        }
+
+        void push_back(const C3Vector &position) {
+            x.push_back(position.x);
+            y.push_back(position.y);
+            z.push_back(position.z);
+        }
+
+        size_t size() const { return x.size(); }
+    };
+
+    // out[i] = squared distance from origin to position i, out must hold count floats.  Uses SSE2 when the build
+    // targets it (the default for 32-bit MSVC and every x86-64 compiler) and the scalar loop otherwise
+    void SquaredDistancesTo(const C3Vector &origin, const float *x, const float *y, const float *z, size_t count,
+                            float *out);
+    void SquaredDistancesToScalar(const C3Vector &origin, const float *x, const float *y, const float *z,
+                                  size_t count, float *out);
+
+    // resizes out to the batch size.  ShouldRender is asked one object at a time, so the render path uses
+    // SquaredDistanceBetween and this is for callers that already hold their positions together
+    void SquaredDistancesTo(const C3Vector &origin, const PositionBatch &batch, std::vector<float> &out);
+}
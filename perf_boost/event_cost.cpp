@@ -0,0 +1,173 @@
+#include "event_cost.hpp"
+#include "logging.hpp"
+#include "settings.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+
+namespace perf_boost {
+    namespace {
+        struct EventCostSlot {
+            uint32_t hash = 0;
+            bool used = false;
+            EventCost cost;
+        };
+
+        std::array<EventCostSlot, kEventCostSlots> eventCosts;
+        size_t eventCostsUsed = 0;
+        uint64_t eventCostsDropped = 0;
+
+        // handlers can fire other events, e.g. by calling functions that signal synchronously
+        const int kMaxEventDepth = 8;
+        std::array<std::chrono::steady_clock::time_point, kMaxEventDepth> eventStarts;
+        int eventDepth = 0;
+
+        uint64_t lastStatsLogMs = 0;
+        const uint64_t kStatsLogIntervalMs = 60000;
+        const size_t kStatsLogEntries = 10;
+
+        uint32_t HashPair(const char *frameName, const char *eventName) {
+            uint32_t hash = 2166136261u;
+            for (auto c = frameName; *c; ++c) {
+                hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+            }
+            hash = (hash ^ 0xffu) * 16777619u;
+            for (auto c = eventName; *c; ++c) {
+                hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+            }
+            return hash;
+        }
+
+        EventCostSlot *FindSlot(const char *frameName, const char *eventName) {
+            auto hash = HashPair(frameName, eventName);
+            for (size_t probe = 0; probe < kEventCostSlots; ++probe) {
+                auto &slot = eventCosts[(hash + probe) % kEventCostSlots];
+                if (!slot.used) {
+                    // keep a quarter of the table free so probes stay short
+                    if (eventCostsUsed >= kEventCostSlots * 3 / 4) {
+                        return nullptr;
+                    }
+                    slot.used = true;
+                    slot.hash = hash;
+                    slot.cost.frame = frameName;
+                    slot.cost.event = eventName;
+                    ++eventCostsUsed;
+                    return &slot;
+                }
+                if (slot.hash == hash && slot.cost.frame == frameName && slot.cost.event == eventName) {
+                    return &slot;
+                }
+            }
+            return nullptr;
+        }
+    }
+
+    void EventCostBegin() {
+        if (!measureEvents) {
+            return;
+        }
+        if (eventDepth < kMaxEventDepth) {
+            eventStarts[eventDepth] = std::chrono::steady_clock::now();
+        }
+        ++eventDepth;
+    }
+
+    void EventCostEnd(const char *frameName, const char *eventName) {
+        if (eventDepth == 0) {
+            return;
+        }
+        --eventDepth;
+        if (eventDepth >= kMaxEventDepth || !measureEvents) {
+            return;
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - eventStarts[eventDepth];
+        auto slot = FindSlot(frameName ? frameName : "", eventName ? eventName : "");
+        if (!slot) {
+            ++eventCostsDropped;
+            return;
+        }
+        ++slot->cost.calls;
+        slot->cost.microseconds += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    }
+
+    void EventCostResetDepth() {
+        eventDepth = 0;
+    }
+
+    std::vector<EventCost> EventCostTop(size_t count) {
+        std::vector<EventCost> costs;
+        for (const auto &slot: eventCosts) {
+            if (slot.used) {
+                costs.push_back(slot.cost);
+            }
+        }
+
+        count = std::min(count, costs.size());
+        std::partial_sort(costs.begin(), costs.begin() + count, costs.end(),
+                          [](const EventCost &a, const EventCost &b) {
+                              return a.microseconds > b.microseconds;
+                          });
+        costs.resize(count);
+        return costs;
+    }
+
+    uint64_t EventCostDropped() {
+        return eventCostsDropped;
+    }
+
+    void ResetEventCost() {
+        eventCosts.fill(EventCostSlot());
+        eventCostsUsed = 0;
+        eventCostsDropped = 0;
+        eventDepth = 0;
+        lastStatsLogMs = 0;
+    }
+
+    std::string EventCostWrapScript() {
+        if (!measureEvents) {
+            return "";
+        }
+
+        // event is a global in 1.12 and can be changed by nested events, capture it before the handler runs
+        return "if PerfBoost_EventBegin then "
+               "PerfBoost_WrappedEvents = PerfBoost_WrappedEvents or {} "
+               "local f = EnumerateFrames() "
+               "while f do "
+               "local h = f:GetScript(\"OnEvent\") "
+               "if h and not PerfBoost_WrappedEvents[h] then "
+               "local n = f:GetName() or \"anonymous\" "
+               "local w = function() "
+               "if not PerfBoost_MeasuringEvents then return h() end "
+               "local e = event "
+               "PerfBoost_EventBegin() h() PerfBoost_EventEnd(n, e) "
+               "end "
+               "PerfBoost_WrappedEvents[w] = true "
+               "f:SetScript(\"OnEvent\", w) "
+               "end "
+               "f = EnumerateFrames(f) "
+               "end "
+               "end";
+    }
+
+    std::string EventCostStateScript() {
+        return measureEvents ? "PerfBoost_MeasuringEvents = 1" : "PerfBoost_MeasuringEvents = nil";
+    }
+
+    void EventCostLogStats(uint64_t nowMs) {
+        if (eventCostsUsed == 0 || nowMs - lastStatsLogMs < kStatsLogIntervalMs) {
+            return;
+        }
+        lastStatsLogMs = nowMs;
+
+        for (const auto &cost: EventCostTop(kStatsLogEntries)) {
+            DEBUG_LOG("OnEvent " << cost.frame << " " << cost.event << ": " << cost.calls << " calls, "
+                                 << cost.microseconds / 1000 << " ms");
+        }
+        if (eventCostsDropped > 0) {
+            DEBUG_LOG("OnEvent " << eventCostsDropped << " calls not recorded, table full");
+        }
+    }
+}
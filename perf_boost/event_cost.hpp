@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace perf_boost {
+    // Per frame/event cost of addon OnEvent handlers while PB_MeasureEvents is on.  The client side wraps every
+    // frame's OnEvent script with EventCostBegin/EventCostEnd so the time lands on the frame and event that caused it.
+    // Costs are kept in a fixed size table, pairs seen after it filled up are only counted in EventCostDropped.
+
+    const size_t kEventCostSlots = 1024;
+
+    struct EventCost {
+        std::string frame;
+        std::string event;
+        uint64_t calls = 0;
+        uint64_t microseconds = 0;
+    };
+
+    void EventCostBegin();
+    void EventCostEnd(const char *frameName, const char *eventName);
+
+    // called between frames when no handler can be running, recovers from handlers that raised a Lua error
+    // before reaching EventCostEnd
+    void EventCostResetDepth();
+
+    // most expensive first, at most count entries
+    std::vector<EventCost> EventCostTop(size_t count);
+    uint64_t EventCostDropped();
+    void ResetEventCost();
+
+    // Lua that wraps the OnEvent script of every frame not wrapped yet, empty while PB_MeasureEvents is off
+    std::string EventCostWrapScript();
+    // Lua telling the wrappers whether to measure, they call the handler straight away while PB_MeasureEvents is off
+    std::string EventCostStateScript();
+
+    // writes the top entries to the log once a minute
+    void EventCostLogStats(uint64_t nowMs);
+}
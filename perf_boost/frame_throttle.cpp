@@ -0,0 +1,155 @@
+#include "frame_throttle.hpp"
+#include "logging.hpp"
+#include "settings.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace perf_boost {
+    namespace {
+        struct ThrottledFrame {
+            FrameUpdateStats stats;
+            bool throttled = true;  // still in PB_ThrottledFrames, the wrapper stays until the UI is reloaded
+            float accumulated = 0.0f;
+            std::chrono::steady_clock::time_point runStart;
+        };
+
+        std::vector<ThrottledFrame> throttledFrames;
+        uint32_t throttledFramesSettingsVersion = ~0u;
+        uint64_t lastStatsLogMs = 0;
+
+        const uint64_t kStatsLogIntervalMs = 60000;
+
+        bool IsListed(const std::string &name) {
+            return std::find(throttledFrameNames.begin(), throttledFrameNames.end(), name) !=
+                   throttledFrameNames.end();
+        }
+
+        void CheckSettings() {
+            if (throttledFramesSettingsVersion != gSettingsVersion) {
+                throttledFramesSettingsVersion = gSettingsVersion;
+                for (auto &frame: throttledFrames) {
+                    frame.throttled = IsListed(frame.stats.name);
+                }
+            }
+        }
+    }
+
+    int FrameThrottleId(const char *frameName) {
+        for (size_t i = 0; i < throttledFrames.size(); ++i) {
+            if (throttledFrames[i].stats.name == frameName) {
+                return static_cast<int>(i);
+            }
+        }
+
+        throttledFrames.emplace_back();
+        throttledFrames.back().stats.name = frameName;
+        throttledFrames.back().throttled = IsListed(frameName);
+        return static_cast<int>(throttledFrames.size() - 1);
+    }
+
+    float FrameThrottleUpdate(int id, float elapsed) {
+        if (id < 0 || id >= static_cast<int>(throttledFrames.size())) {
+            return elapsed;
+        }
+
+        CheckSettings();
+
+        auto &frame = throttledFrames[id];
+        ++frame.stats.updates;
+        frame.accumulated += elapsed;
+
+        if (frame.throttled && throttledFrameRate > 0 && frame.accumulated < 1.0f / throttledFrameRate) {
+            return -1.0f;
+        }
+
+        float result = frame.accumulated;
+        frame.accumulated = 0.0f;
+        return result;
+    }
+
+    void FrameThrottleBegin(int id) {
+        if (id >= 0 && id < static_cast<int>(throttledFrames.size())) {
+            throttledFrames[id].runStart = std::chrono::steady_clock::now();
+        }
+    }
+
+    void FrameThrottleEnd(int id) {
+        if (id >= 0 && id < static_cast<int>(throttledFrames.size())) {
+            auto &frame = throttledFrames[id];
+            auto elapsed = std::chrono::steady_clock::now() - frame.runStart;
+            frame.stats.microseconds += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+            ++frame.stats.runs;
+        }
+    }
+
+    std::vector<FrameUpdateStats> FrameThrottleStats() {
+        std::vector<FrameUpdateStats> stats;
+        for (const auto &frame: throttledFrames) {
+            stats.push_back(frame.stats);
+        }
+        std::sort(stats.begin(), stats.end(), [](const FrameUpdateStats &a, const FrameUpdateStats &b) {
+            return a.microseconds > b.microseconds;
+        });
+        return stats;
+    }
+
+    uint64_t FrameThrottleSkipped() {
+        uint64_t skipped = 0;
+        for (const auto &frame: throttledFrames) {
+            skipped += frame.stats.updates - frame.stats.runs;
+        }
+        return skipped;
+    }
+
+    void ResetFrameThrottle() {
+        throttledFrames.clear();
+        lastStatsLogMs = 0;
+    }
+
+    std::string FrameThrottleWrapScript() {
+        if (throttledFrameNames.empty()) {
+            return "";
+        }
+
+        // OnUpdate handlers read this/arg1 globals in 1.12, arg1 is swapped for the accumulated time
+        std::string script = "for _, name in ipairs({";
+        for (const auto &name: throttledFrameNames) {
+            script += "\"" + name + "\",";
+        }
+        script += "}) do "
+                  "local f = getglobal(name) "
+                  "if PerfBoost_FrameThrottleId and f and f.GetScript then "
+                  "local h = f:GetScript(\"OnUpdate\") "
+                  "if h and not (PerfBoost_Wrapped and PerfBoost_Wrapped[h]) then "
+                  "local id = PerfBoost_FrameThrottleId(name) "
+                  "local w = function() "
+                  "local e = PerfBoost_FrameUpdate(id, arg1) "
+                  "if e >= 0 then "
+                  "local a = arg1 arg1 = e "
+                  "PerfBoost_FrameBegin(id) h() PerfBoost_FrameEnd(id) "
+                  "arg1 = a "
+                  "end "
+                  "end "
+                  "PerfBoost_Wrapped = PerfBoost_Wrapped or {} "
+                  "PerfBoost_Wrapped[w] = true "
+                  "f:SetScript(\"OnUpdate\", w) "
+                  "end "
+                  "end "
+                  "end";
+        return script;
+    }
+
+    void FrameThrottleLogStats(uint64_t nowMs) {
+        if (throttledFrames.empty() || nowMs - lastStatsLogMs < kStatsLogIntervalMs) {
+            return;
+        }
+        lastStatsLogMs = nowMs;
+
+        for (const auto &stats: FrameThrottleStats()) {
+            DEBUG_LOG("OnUpdate " << stats.name << ": " << stats.runs << "/" << stats.updates << " runs, "
+                                  << stats.microseconds / 1000 << " ms");
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace perf_boost {
+    // OnUpdate throttling for the UI frames named in PB_ThrottledFrames.  The client side wraps each frame's
+    // OnUpdate script so it asks FrameThrottleUpdate first and only runs the real handler PB_ThrottledFrameRate
+    // times a second, passing it all the time that passed since it last ran.  A rate of 0 runs every update and only
+    // measures.
+
+    struct FrameUpdateStats {
+        std::string name;
+        uint64_t updates = 0;       // OnUpdate calls from the client
+        uint64_t runs = 0;          // times the addon's handler actually ran
+        uint64_t microseconds = 0;  // time spent in the handler
+    };
+
+    // index for a frame name, registered on first use
+    int FrameThrottleId(const char *frameName);
+
+    // seconds to pass to the handler as arg1, or a negative value to skip this update
+    float FrameThrottleUpdate(int id, float elapsed);
+
+    // around each handler run
+    void FrameThrottleBegin(int id);
+    void FrameThrottleEnd(int id);
+
+    // worst offenders first
+    std::vector<FrameUpdateStats> FrameThrottleStats();
+    // updates folded into a later run, across all frames
+    uint64_t FrameThrottleSkipped();
+    void ResetFrameThrottle();
+
+    // Lua that (re)wraps the OnUpdate script of every throttled frame, safe to run repeatedly.  Empty when there is
+    // nothing to throttle
+    std::string FrameThrottleWrapScript();
+
+    // writes FrameThrottleStats to the log once a minute
+    void FrameThrottleLogStats(uint64_t nowMs);
+}
@@ -0,0 +1,50 @@
+#include "game_objects.hpp"
+#include "game_view.hpp"
+
+#include <cstdlib>
+
+namespace perf_boost {
+    namespace {
+        const char *const kTypeNames[GAMEOBJECT_TYPE_MAX] = {
+                "door", "button", "questgiver", "chest", "binder", "generic", "trap", "chair", "spell_focus", "text",
+                "goober", "transport", "areadamage", "camera", "map_object", "mo_transport", "duel_arbiter",
+                "fishingnode", "summoning_ritual", "mailbox", "auctionhouse", "guardpost", "spellcaster",
+                "meetingstone", "flagstand", "fishinghole", "flagdrop", "mini_game", "lottery_kiosk",
+                "capture_point", "aura_generator",
+        };
+    }
+
+    const char *GameObjectTypeName(GameObjectType type) {
+        return type >= 0 && type < GAMEOBJECT_TYPE_MAX ? kTypeNames[type] : "unknown";
+    }
+
+    bool ParseGameObjectType(const std::string &name, GameObjectType &type) {
+        for (int i = 0; i < GAMEOBJECT_TYPE_MAX; ++i) {
+            if (name == kTypeNames[i]) {
+                type = static_cast<GameObjectType>(i);
+                return true;
+            }
+        }
+
+        char *end = nullptr;
+        auto number = std::strtol(name.c_str(), &end, 10);
+        if (name.empty() || *end != '\0' || number < 0 || number >= GAMEOBJECT_TYPE_MAX) {
+            return false;
+        }
+        type = static_cast<GameObjectType>(number);
+        return true;
+    }
+
+    bool GameObjectTypeAlwaysRendered(GameObjectType type) {
+        return type == GAMEOBJECT_TYPE_DOOR || type == GAMEOBJECT_TYPE_TRANSPORT ||
+               type == GAMEOBJECT_TYPE_MO_TRANSPORT || type == GAMEOBJECT_TYPE_QUESTGIVER;
+    }
+
+    GameObjectType GameObjectGetType(uintptr_t *gameObject) {
+        auto *fields = GameObjectGetFields(gameObject);
+        if (!fields || fields->typeId >= GAMEOBJECT_TYPE_MAX) {
+            return GAMEOBJECT_TYPE_MAX;
+        }
+        return static_cast<GameObjectType>(fields->typeId);
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace perf_boost {
+    // Render policy for game objects.  PB_GameObjectRenderDists is a list of type:distance pairs, e.g.
+    // "chair:40,mailbox:60", hiding objects of that type further than distance yards away.  Doors, transports, quest
+    // givers, objects usable for one of the player's quests and the player's own objects (a fishing bobber) are
+    // never hidden.  Game objects don't go through the hooked CGUnit/CGCorpse ShouldRender, so the cvar is not
+    // registered in the client until CGGameObject's own ShouldRender is hooked; only traces and tests use it today.
+
+    // the GameObjectType name in lower case without GAMEOBJECT_TYPE_, e.g. "fishingnode"
+    const char *GameObjectTypeName(GameObjectType type);
+    // a name as above or the type's number
+    bool ParseGameObjectType(const std::string &name, GameObjectType &type);
+
+    // types the policy never hides whatever the settings say
+    bool GameObjectTypeAlwaysRendered(GameObjectType type);
+
+    // GAMEOBJECT_TYPE_MAX until the descriptor fields have been received
+    GameObjectType GameObjectGetType(uintptr_t *gameObject);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace perf_boost {
+    // Everything the decision logic is allowed to know about the game world.
+    //
+    // Units are passed around as the client's opaque object pointers.  The DLL implements these functions against
+    // the 1.12.1 client in game_view_client.cpp, host builds link the simulated object manager from sim/ instead.
+    // Nothing in perf_boost_core may read client memory directly.
+
+    std::uint64_t ClntObjMgrGetActivePlayerGuid();
+    uintptr_t *GetObjectPtr(std::uint64_t guid);
+    uintptr_t *ClntObjMgrObjectPtr(OBJECT_TYPE_MASK typeMask, std::uint64_t guid);
+
+    OBJECT_TYPE_ID UnitGetType(uintptr_t *unit);
+    uint64_t UnitGetGuid(uintptr_t *unit);
+    C3Vector UnitGetPosition(uintptr_t *unit);
+    // nullptr until the descriptor fields have been received
+    UnitFields *UnitGetFields(uintptr_t *unit);
+    char *UnitGetName(uintptr_t *unit);
+    bool UnitCanAttackUnit(uintptr_t *unit1, uintptr_t *unit2);
+    // creature_template entry, 0 for players and objects without one
+    uint32_t UnitGetCreatureEntry(uintptr_t *unit);
+    // CREATURE_RANK_UNKNOWN until the client has the creature's cache record
+    CreatureRank UnitGetCreatureRank(uintptr_t *unit);
+
+    // nullptr until the descriptor fields have been received
+    DynamicObjectFields *DynamicObjectGetFields(uintptr_t *dynamicObj);
+    GameObjectFields *GameObjectGetFields(uintptr_t *gameObject);
+    // the player the corpse belongs to, 0 for bones and until the descriptor fields have been received
+    uint64_t CorpseGetOwnerGuid(uintptr_t *corpse);
+
+    // the 8 raid target guids, indexed by raid mark - 1
+    const uint64_t *GetRaidTargetGuids();
+    uint32_t GetZoneAreaId();
+    // raid members, or party members outside a raid, not including the active player.  Returns how many were written
+    size_t GetGroupMemberGuids(uint64_t *guids, size_t maxGuids);
+    // world camera position and view direction, false while there is none (loading screens, character select)
+    bool GetActiveCamera(C3Vector &position, C3Vector &forward);
+
+    const SpellRec *GetSpellInfo(uint32_t spellId);
+
+    uint64_t GetWowTimeMs();
+}
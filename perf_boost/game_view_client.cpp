@@ -0,0 +1,191 @@
+// game_view.hpp implemented against the 1.12.1 client
+
+#include "game_view.hpp"
+#include "offsets.hpp"
+#include "main.hpp"
+
+namespace perf_boost {
+    std::uint64_t ClntObjMgrGetActivePlayerGuid() {
+        auto const getActivePlayer = hadesmem::detail::AliasCast<decltype(&ClntObjMgrGetActivePlayerGuid)>(
+                Offsets::GetActivePlayer);
+
+        return getActivePlayer();
+    }
+
+    uintptr_t *GetObjectPtr(std::uint64_t guid) {
+        uintptr_t *(__stdcall *getObjectPtr)(std::uint64_t) = hadesmem::detail::AliasCast<decltype(getObjectPtr)>(
+                Offsets::GetObjectPtr);
+
+        return getObjectPtr(guid);
+    }
+
+    uintptr_t *ClntObjMgrObjectPtr(OBJECT_TYPE_MASK typeMask, std::uint64_t guid) {
+        auto const clntObjMgrObjectPtr = reinterpret_cast<ClntObjMgrObjectPtrT>(Offsets::ClntObjMgrObjectPtr);
+        return clntObjMgrObjectPtr(typeMask, nullptr, guid, 0);
+    }
+
+    OBJECT_TYPE_ID UnitGetType(uintptr_t *unit) {
+        return *reinterpret_cast<OBJECT_TYPE_ID *>(unit + 5);
+    }
+
+    uint64_t UnitGetGuid(uintptr_t *unit) {
+        if (!unit) {
+            return 0;
+        }
+
+        uint64_t guid = *reinterpret_cast<uint64_t *>(unit + 12);
+        return guid;
+    }
+
+    C3Vector UnitGetPosition(uintptr_t *unit) {
+        C3Vector result = {};
+
+        if (unit == 0 || ((int) unit & 1) != 0) {
+            return result;
+        }
+
+        uint32_t memberFunctions = *reinterpret_cast<uint32_t *>(unit);
+        if (memberFunctions == 0 || (memberFunctions & 1) != 0) {
+            return result;
+        }
+
+        uint32_t getPositionPtr = *reinterpret_cast<uint32_t *>(memberFunctions + 0x14);
+        if (getPositionPtr == 0 || (getPositionPtr & 1) != 0) {
+            return result;
+        }
+
+        auto getPositionFn = reinterpret_cast<CGUnitGetPositionT>(getPositionPtr);
+        getPositionFn(unit, &result);
+
+        return result;
+    }
+
+    UnitFields *UnitGetFields(uintptr_t *unit) {
+        return *reinterpret_cast<UnitFields **>(unit + 68);
+    }
+
+    char *UnitGetName(uintptr_t *unit) {
+        if (!unit) {
+            return nullptr;
+        }
+
+        auto const GetUnitName = reinterpret_cast<CGUnitGetNameT>(Offsets::CGUnitGetUnitName);
+        return GetUnitName(unit, 0);
+    }
+
+    bool UnitCanAttackUnit(uintptr_t *unit1, uintptr_t *unit2) {
+        if (unit1 == nullptr || unit2 == nullptr) {
+            return false;
+        }
+
+        auto canAttackFn = reinterpret_cast<CGUnitCanAttackT>(Offsets::CGUnitCanAttack);
+        return canAttackFn(unit1, unit2);
+    }
+
+    uint32_t UnitGetCreatureEntry(uintptr_t *unit) {
+        if (!unit) {
+            return 0;
+        }
+
+        // object descriptor fields, OBJECT_FIELD_ENTRY follows the guid and type
+        auto objectFields = *reinterpret_cast<uint32_t **>(unit + 2);
+        return objectFields ? objectFields[3] : 0;
+    }
+
+    CreatureRank UnitGetCreatureRank(uintptr_t *unit) {
+        if (!unit) {
+            return CREATURE_RANK_UNKNOWN;
+        }
+
+        // creaturecache.wdb record at 0xB30: 4 names, sub name, type flags, type, family, rank
+        auto creatureStats = *reinterpret_cast<uint32_t **>(reinterpret_cast<uint8_t *>(unit) + 0xB30);
+        if (!creatureStats) {
+            return CREATURE_RANK_UNKNOWN;
+        }
+        return static_cast<CreatureRank>(creatureStats[8]);
+    }
+
+    DynamicObjectFields *DynamicObjectGetFields(uintptr_t *dynamicObj) {
+        return *reinterpret_cast<DynamicObjectFields **>(dynamicObj + 68);
+    }
+
+    GameObjectFields *GameObjectGetFields(uintptr_t *gameObject) {
+        return *reinterpret_cast<GameObjectFields **>(gameObject + 68);
+    }
+
+    uint64_t CorpseGetOwnerGuid(uintptr_t *corpse) {
+        // CORPSE_FIELD_OWNER starts the corpse descriptor fields
+        auto fields = *reinterpret_cast<uint64_t **>(corpse + 68);
+        return fields ? fields[0] : 0;
+    }
+
+    const uint64_t *GetRaidTargetGuids() {
+        return reinterpret_cast<const uint64_t *>(Offsets::RaidTargetGuids);
+    }
+
+    uint32_t GetZoneAreaId() {
+        return *reinterpret_cast<uint32_t *>(Offsets::ZoneAreaIds);
+    }
+
+    size_t GetGroupMemberGuids(uint64_t *guids, size_t maxGuids) {
+        auto const getGuidFromName = reinterpret_cast<GetGUIDFromNameT>(Offsets::GetGUIDFromName);
+        auto const playerGuid = ClntObjMgrGetActivePlayerGuid();
+
+        size_t count = 0;
+        char token[8];
+        for (int i = 1; i <= 40 && count < maxGuids; ++i) {
+            snprintf(token, sizeof(token), "raid%d", i);
+            auto guid = getGuidFromName(token);
+            if (guid != 0 && guid != playerGuid) {
+                guids[count++] = guid;
+            }
+        }
+        if (count > 0) {
+            return count;
+        }
+
+        for (int i = 1; i <= 4 && count < maxGuids; ++i) {
+            snprintf(token, sizeof(token), "party%d", i);
+            auto guid = getGuidFromName(token);
+            if (guid != 0) {
+                guids[count++] = guid;
+            }
+        }
+        return count;
+    }
+
+    bool GetActiveCamera(C3Vector &position, C3Vector &forward) {
+        auto worldFrame = *reinterpret_cast<uintptr_t *>(Offsets::WorldFrame);
+        if (worldFrame == 0) {
+            return false;
+        }
+        auto camera = *reinterpret_cast<uintptr_t *>(worldFrame + 0x65B8);
+        if (camera == 0) {
+            return false;
+        }
+
+        // CGCamera position at +0x8, the first row of its facing matrix at +0x14 points where it looks
+        auto fields = reinterpret_cast<const float *>(camera + 0x8);
+        position.x = fields[0];
+        position.y = fields[1];
+        position.z = fields[2];
+        forward.x = fields[3];
+        forward.y = fields[4];
+        forward.z = fields[5];
+        return true;
+    }
+
+    const SpellRec *GetSpellInfo(uint32_t spellId) {
+        auto const spellDb = reinterpret_cast<WowClientDB<SpellRec> *>(Offsets::SpellDb);
+
+        if (spellId > spellDb->m_maxId)
+            return nullptr;
+
+        return spellDb->m_recordsById[spellId];
+    }
+
+    uint64_t GetWowTimeMs() {
+        auto const osGetAsyncTimeMs = reinterpret_cast<GetTimeMsT>(Offsets::OsGetAsyncTimeMs);
+        return osGetAsyncTimeMs();
+    }
+}
@@ -0,0 +1,228 @@
+#include "importance.hpp"
+#include "game_view.hpp"
+#include "render.hpp"
+#include "settings.hpp"
+#include "unit_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace perf_boost {
+    namespace {
+        const uint64_t kGroupRefreshMs = 1000;
+        const size_t kMaxGroupMembers = 40;
+        // extra score for units drawn last frame, 2 yards
+        const uint32_t kDrawnLastFrameBonus = 8;
+        const int kFlagShift = 20;
+
+        const uint8_t kClassPaladin = 2;
+        const uint8_t kClassPriest = 5;
+        const uint8_t kClassShaman = 7;
+        const uint8_t kClassDruid = 11;
+
+        struct ImportantGuid {
+            uint64_t guid;
+            uint8_t flags;
+        };
+
+        // everything known to matter this frame regardless of where it is, sorted by guid
+        std::vector<ImportantGuid> importantGuids;
+        uint64_t groupGuids[kMaxGroupMembers];
+        size_t groupCount = 0;
+        uint64_t lastGroupRefreshMs = 0;
+        bool groupRead = false;
+
+        struct BudgetCandidate {
+            uint64_t guid;
+            uint32_t score;
+        };
+
+        struct RankedBudget {
+            std::vector<BudgetCandidate> candidates;
+            // guids asked about last frame and the ones among them that made the cut, sorted
+            std::vector<uint64_t> seenLastFrame;
+            std::vector<uint64_t> admittedLastFrame;
+            uint32_t cutoff = 0;
+        };
+
+        RankedBudget budgets[RENDER_BUDGET_COUNT];
+
+        int BudgetLimit(RENDER_BUDGET budget) {
+            return budget == RENDER_BUDGET_UNITS ? unitBudget : corpseBudget;
+        }
+
+        void MarkImportant(uint64_t guid, uint8_t flag) {
+            if (guid != 0) {
+                importantGuids.push_back({guid, flag});
+            }
+        }
+
+        bool IsHealerClass(const UnitFields *unitFields) {
+            auto unitClass = static_cast<uint8_t>(unitFields->bytes0 >> 8);
+            return unitClass == kClassPriest || unitClass == kClassDruid || unitClass == kClassPaladin ||
+                   unitClass == kClassShaman;
+        }
+
+        uint64_t TargetOf(uint64_t guid) {
+            auto unitPtr = guid != 0 ? GetObjectPtr(guid) : nullptr;
+            auto *unitFields = unitPtr ? UnitGetFields(unitPtr) : nullptr;
+            return unitFields ? unitFields->target : 0;
+        }
+    }
+
+    void UpdateImportance() {
+        importantGuids.clear();
+        if (!gPlayerUnit) {
+            return;
+        }
+
+        if (!groupRead || gFrameTimeMs - lastGroupRefreshMs >= kGroupRefreshMs) {
+            groupCount = GetGroupMemberGuids(groupGuids, kMaxGroupMembers);
+            lastGroupRefreshMs = gFrameTimeMs;
+            groupRead = true;
+        }
+
+        auto *playerFields = UnitGetFields(gPlayerUnit);
+        if (playerFields) {
+            MarkImportant(playerFields->target, IMPORTANCE_TARGET);
+            MarkImportant(TargetOf(playerFields->target), IMPORTANCE_TARGET_OF_TARGET);
+        }
+
+        for (size_t i = 0; i < groupCount; ++i) {
+            MarkImportant(groupGuids[i], IMPORTANCE_GROUP);
+
+            auto memberPtr = GetObjectPtr(groupGuids[i]);
+            auto *memberFields = memberPtr ? UnitGetFields(memberPtr) : nullptr;
+            if (memberFields && IsHealerClass(memberFields)) {
+                MarkImportant(memberFields->target, IMPORTANCE_HEALER_FOCUS);
+            }
+        }
+
+        // merge duplicates so each guid has one entry with all its flags
+        std::sort(importantGuids.begin(), importantGuids.end(), [](const ImportantGuid &a, const ImportantGuid &b) {
+            return a.guid < b.guid;
+        });
+        size_t merged = 0;
+        for (size_t i = 0; i < importantGuids.size(); ++i) {
+            if (merged > 0 && importantGuids[merged - 1].guid == importantGuids[i].guid) {
+                importantGuids[merged - 1].flags |= importantGuids[i].flags;
+            } else {
+                importantGuids[merged++] = importantGuids[i];
+            }
+        }
+        importantGuids.resize(merged);
+    }
+
+    size_t GroupMemberCount() {
+        return groupCount;
+    }
+
+    void ResetImportance() {
+        importantGuids.clear();
+        groupCount = 0;
+        lastGroupRefreshMs = 0;
+        groupRead = false;
+        for (auto &budget: budgets) {
+            budget = RankedBudget();
+        }
+    }
+
+    uint8_t ImportanceFlags(uintptr_t *unitPtr, uint64_t guid) {
+        uint8_t flags = 0;
+
+        auto it = std::lower_bound(importantGuids.begin(), importantGuids.end(), guid,
+                                   [](const ImportantGuid &a, uint64_t value) { return a.guid < value; });
+        if (it != importantGuids.end() && it->guid == guid) {
+            flags = it->flags;
+        }
+
+        if (GetRaidMarkForGuid(guid) > 0) {
+            flags |= IMPORTANCE_MARKED;
+        }
+
+        auto *unitFields = UnitGetFields(unitPtr);
+        if (unitFields && gPlayerGuid != 0 && unitFields->target == gPlayerGuid &&
+            (unitFields->flags & UNIT_FLAG_IN_COMBAT) != 0) {
+            flags |= IMPORTANCE_ATTACKING_ME;
+        }
+
+        if (UnitGetType(unitPtr) == OBJECT_TYPE_PLAYER && (flags & IMPORTANCE_GROUP) == 0 &&
+            PlayerCanAttackUnit(unitPtr, guid)) {
+            flags |= IMPORTANCE_HOSTILE_PLAYER;
+        }
+        return flags;
+    }
+
+    uint32_t ImportanceScore(uint8_t flags, float distanceSq) {
+        float quarterYards = std::sqrt(distanceSq) * 4.0f;
+        auto falloff = 0xFFFFu - static_cast<uint32_t>(std::min(quarterYards, 65535.0f));
+        return (static_cast<uint32_t>(flags) << kFlagShift) | falloff;
+    }
+
+    void UpdateRenderBudgets() {
+        for (int i = 0; i < RENDER_BUDGET_COUNT; ++i) {
+            auto &budget = budgets[i];
+            auto &candidates = budget.candidates;
+            // the client can ask about an object more than once a frame
+            std::sort(candidates.begin(), candidates.end(), [](const BudgetCandidate &a, const BudgetCandidate &b) {
+                return a.guid < b.guid;
+            });
+            candidates.erase(std::unique(candidates.begin(), candidates.end(),
+                                         [](const BudgetCandidate &a, const BudgetCandidate &b) {
+                                             return a.guid == b.guid;
+                                         }), candidates.end());
+
+            budget.seenLastFrame.clear();
+            for (const auto &candidate: candidates) {
+                budget.seenLastFrame.push_back(candidate.guid);
+            }
+
+            auto limit = BudgetLimit(static_cast<RENDER_BUDGET>(i));
+            size_t admitted = candidates.size();
+            budget.cutoff = 0;
+            if (limit > 0 && candidates.size() > static_cast<size_t>(limit)) {
+                admitted = static_cast<size_t>(limit);
+                auto nth = candidates.begin() + (admitted - 1);
+                std::nth_element(candidates.begin(), nth, candidates.end(),
+                                 [](const BudgetCandidate &a, const BudgetCandidate &b) { return a.score > b.score; });
+                budget.cutoff = nth->score;
+            }
+
+            budget.admittedLastFrame.clear();
+            for (size_t j = 0; j < admitted; ++j) {
+                budget.admittedLastFrame.push_back(candidates[j].guid);
+            }
+            std::sort(budget.admittedLastFrame.begin(), budget.admittedLastFrame.end());
+            candidates.clear();
+        }
+    }
+
+    bool AdmitToBudget(RENDER_BUDGET budget, uint64_t guid, uint32_t score) {
+        auto &ranked = budgets[budget];
+        // objects seen last frame keep last frame's ranking, new ones have to beat the lowest score that made it
+        bool admitted;
+        if (std::binary_search(ranked.admittedLastFrame.begin(), ranked.admittedLastFrame.end(), guid)) {
+            score += kDrawnLastFrameBonus;
+            admitted = true;
+        } else {
+            admitted = !std::binary_search(ranked.seenLastFrame.begin(), ranked.seenLastFrame.end(), guid) &&
+                       score >= ranked.cutoff;
+        }
+        ranked.candidates.push_back({guid, score});
+        return admitted;
+    }
+
+    uint32_t BudgetCutoff(RENDER_BUDGET budget) {
+        return budgets[budget].cutoff;
+    }
+
+    bool RankedLastFrame(uint64_t guid) {
+        for (const auto &budget: budgets) {
+            if (std::binary_search(budget.seenLastFrame.begin(), budget.seenLastFrame.end(), guid)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace perf_boost {
+    // Why a unit matters to the player.  One bit per reason in priority order, so comparing two masks compares their
+    // most important reasons first.
+    enum IMPORTANCE_FLAG : uint8_t {
+        IMPORTANCE_MARKED = 0x01,
+        IMPORTANCE_HOSTILE_PLAYER = 0x02,
+        IMPORTANCE_ATTACKING_ME = 0x04,
+        IMPORTANCE_HEALER_FOCUS = 0x08,      // targeted by a priest, druid, paladin or shaman in the group
+        IMPORTANCE_GROUP = 0x10,
+        IMPORTANCE_TARGET_OF_TARGET = 0x20,
+        IMPORTANCE_TARGET = 0x40,
+    };
+
+    // gather this frame's target, target of target, group and healer focus guids, done by BeginFrame.  The group
+    // itself is only re-read once a second
+    void UpdateImportance();
+    void ResetImportance();
+    // raid or party members besides the player as of the last group read
+    size_t GroupMemberCount();
+
+    uint8_t ImportanceFlags(uintptr_t *unitPtr, uint64_t guid);
+
+    // flags first, then closer is better in quarter yards out to 16383 yards
+    uint32_t ImportanceScore(uint8_t flags, float distanceSq);
+
+    // PB_UnitBudget and PB_CorpseBudget: at most that many units or corpses are drawn per frame, the highest scoring
+    // ones.  ShouldRender is asked one object at a time, so objects are ranked on the previous frame's scores and
+    // objects that appear mid frame are drawn if they beat the lowest score that made it.  Objects drawn last frame
+    // get a couple of yards of extra score so two at about the same distance don't keep swapping places.
+    enum RENDER_BUDGET {
+        RENDER_BUDGET_UNITS,
+        RENDER_BUDGET_CORPSES,     // corpses and dead units
+        RENDER_BUDGET_COUNT
+    };
+
+    // pick the cut offs from last frame's scores, done by BeginFrame
+    void UpdateRenderBudgets();
+    // records the object's score and whether it fits this frame
+    bool AdmitToBudget(RENDER_BUDGET budget, uint64_t guid, uint32_t score);
+    // 0 while everything fits
+    uint32_t BudgetCutoff(RENDER_BUDGET budget);
+    // asked about with either budget last frame
+    bool RankedLastFrame(uint64_t guid);
+}
@@ -0,0 +1,213 @@
+#include "lua_api.hpp"
+#include "event_cost.hpp"
+#include "frame_throttle.hpp"
+#include "main.hpp"
+#include "net_stats.hpp"
+#include "offsets.hpp"
+#include "settings.hpp"
+#include "stats.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace perf_boost {
+    namespace {
+        const uint64_t kLuaApiIntervalMs = 5000;
+
+        uint64_t lastLuaApiUpdateMs = 0;
+        bool luaMeasuringEvents = false;
+
+        // GetNetStats() only changes a few times a second
+        const uint64_t kNetStatsIntervalMs = 250;
+        const char *kNetStatsScript = "if PerfBoost_NetStats then PerfBoost_NetStats(GetNetStats()) end";
+
+        uint64_t lastNetStatsMs = 0;
+
+        // PerfBoost_FrameThrottleId(name) -> id
+        uint32_t __fastcall Script_FrameThrottleId(uintptr_t *luaState) {
+            auto const lua_isstring = reinterpret_cast<lua_isstringT>(Offsets::lua_isstring);
+            auto const lua_pushnumber = reinterpret_cast<lua_pushnumberT>(Offsets::lua_pushnumber);
+
+            int id = -1;
+            if (lua_isstring(luaState, 1)) {
+                auto const lua_tostring = reinterpret_cast<lua_tostringT>(Offsets::lua_tostring);
+                id = FrameThrottleId(lua_tostring(luaState, 1));
+            }
+            lua_pushnumber(luaState, id);
+            return 1;
+        }
+
+        // PerfBoost_FrameUpdate(id, elapsed) -> elapsed to run the handler with, negative to skip it
+        uint32_t __fastcall Script_FrameUpdate(uintptr_t *luaState) {
+            auto const lua_tonumber = reinterpret_cast<lua_tonumberT>(Offsets::lua_tonumber);
+            auto const lua_pushnumber = reinterpret_cast<lua_pushnumberT>(Offsets::lua_pushnumber);
+
+            auto const id = static_cast<int>(lua_tonumber(luaState, 1));
+            auto const elapsed = static_cast<float>(lua_tonumber(luaState, 2));
+            lua_pushnumber(luaState, FrameThrottleUpdate(id, elapsed));
+            return 1;
+        }
+
+        // PerfBoost_FrameBegin(id)
+        uint32_t __fastcall Script_FrameBegin(uintptr_t *luaState) {
+            auto const lua_tonumber = reinterpret_cast<lua_tonumberT>(Offsets::lua_tonumber);
+            FrameThrottleBegin(static_cast<int>(lua_tonumber(luaState, 1)));
+            return 0;
+        }
+
+        // PerfBoost_FrameEnd(id)
+        uint32_t __fastcall Script_FrameEnd(uintptr_t *luaState) {
+            auto const lua_tonumber = reinterpret_cast<lua_tonumberT>(Offsets::lua_tonumber);
+            FrameThrottleEnd(static_cast<int>(lua_tonumber(luaState, 1)));
+            return 0;
+        }
+
+        // PerfBoost_EventBegin()
+        uint32_t __fastcall Script_EventBegin(uintptr_t *luaState) {
+            EventCostBegin();
+            return 0;
+        }
+
+        // PerfBoost_EventEnd(frameName, event)
+        uint32_t __fastcall Script_EventEnd(uintptr_t *luaState) {
+            auto const lua_tostring = reinterpret_cast<lua_tostringT>(Offsets::lua_tostring);
+            EventCostEnd(lua_tostring(luaState, 1), lua_tostring(luaState, 2));
+            return 0;
+        }
+
+        // PerfBoost_GetEventCost(rank) -> frameName, event, calls, milliseconds for the rank-th most expensive
+        // handler or nil
+        uint32_t __fastcall Script_GetEventCost(uintptr_t *luaState) {
+            auto const lua_tonumber = reinterpret_cast<lua_tonumberT>(Offsets::lua_tonumber);
+            auto const rank = static_cast<int>(lua_tonumber(luaState, 1));
+            auto const costs = EventCostTop(rank > 0 ? rank : 0);
+            if (rank <= 0 || static_cast<size_t>(rank) > costs.size()) {
+                auto const lua_pushnil = reinterpret_cast<lua_pushnilT>(Offsets::lua_pushnil);
+                lua_pushnil(luaState);
+                return 1;
+            }
+
+            auto const lua_pushstring = reinterpret_cast<lua_pushstringT>(Offsets::lua_pushstring);
+            auto const lua_pushnumber = reinterpret_cast<lua_pushnumberT>(Offsets::lua_pushnumber);
+            auto const &cost = costs[rank - 1];
+            lua_pushstring(luaState, const_cast<char *>(cost.frame.c_str()));
+            lua_pushstring(luaState, const_cast<char *>(cost.event.c_str()));
+            lua_pushnumber(luaState, static_cast<double>(cost.calls));
+            lua_pushnumber(luaState, cost.microseconds / 1000.0);
+            return 4;
+        }
+
+        // PerfBoost_GetStats() -> frameMs, averageFrameMs, unitsRendered, unitsCulled, visualsSuppressed,
+        // eventsFiltered, updatesCoalesced, unitsAnimated, unitsAnimationDeferred, renderChecksReused
+        uint32_t __fastcall Script_GetStats(uintptr_t *luaState) {
+            auto const lua_pushnumber = reinterpret_cast<lua_pushnumberT>(Offsets::lua_pushnumber);
+            auto const &stats = GetRuntimeStats();
+            lua_pushnumber(luaState, stats.frameMs);
+            lua_pushnumber(luaState, stats.averageFrameMs);
+            lua_pushnumber(luaState, stats.unitsRendered);
+            lua_pushnumber(luaState, stats.unitsCulled);
+            lua_pushnumber(luaState, static_cast<double>(stats.visualsSuppressed));
+            lua_pushnumber(luaState, static_cast<double>(stats.eventsFiltered));
+            lua_pushnumber(luaState, static_cast<double>(FrameThrottleSkipped()));
+            lua_pushnumber(luaState, stats.unitsAnimated);
+            lua_pushnumber(luaState, stats.unitsAnimationDeferred);
+            lua_pushnumber(luaState, stats.renderChecksReused);
+            return 10;
+        }
+
+        // PerfBoost_IsUnitRendered("0x..." guid or unit token) -> 1 rendered, 0 hidden, nil if it wasn't drawn
+        // this or last frame.  Guids don't fit in a Lua number so they are passed as the strings SuperWoW returns
+        uint32_t __fastcall Script_IsUnitRendered(uintptr_t *luaState) {
+            auto const lua_isstring = reinterpret_cast<lua_isstringT>(Offsets::lua_isstring);
+
+            int rendered = -1;
+            if (lua_isstring(luaState, 1)) {
+                auto const lua_tostring = reinterpret_cast<lua_tostringT>(Offsets::lua_tostring);
+                auto const unit = lua_tostring(luaState, 1);
+
+                uint64_t guid;
+                if (strncmp(unit, "0x", 2) == 0 || strncmp(unit, "0X", 2) == 0) {
+                    guid = strtoull(unit + 2, nullptr, 16);
+                } else {
+                    auto const getGuidFromName = reinterpret_cast<GetGUIDFromNameT>(Offsets::GetGUIDFromName);
+                    guid = getGuidFromName(unit);
+                }
+                if (guid != 0) {
+                    rendered = IsUnitRendered(guid);
+                }
+            }
+
+            if (rendered < 0) {
+                auto const lua_pushnil = reinterpret_cast<lua_pushnilT>(Offsets::lua_pushnil);
+                lua_pushnil(luaState);
+            } else {
+                auto const lua_pushnumber = reinterpret_cast<lua_pushnumberT>(Offsets::lua_pushnumber);
+                lua_pushnumber(luaState, rendered);
+            }
+            return 1;
+        }
+
+        // PerfBoost_NetStats(bandwidthIn, bandwidthOut, latency), fed from GetNetStats()
+        uint32_t __fastcall Script_NetStats(uintptr_t *luaState) {
+            auto const lua_tonumber = reinterpret_cast<lua_tonumberT>(Offsets::lua_tonumber);
+            RecordNetStats(static_cast<float>(lua_tonumber(luaState, 1)), static_cast<float>(lua_tonumber(luaState, 3)));
+            return 0;
+        }
+
+        void RunScript(const std::string &script) {
+            if (!script.empty()) {
+                auto const luaCall = reinterpret_cast<LuaCallT>(Offsets::lua_call);
+                luaCall(script.c_str(), "perf_boost");
+            }
+        }
+
+        void RegisterLuaFunction(const char *name, LuaScriptT function) {
+            auto const registerFunction = reinterpret_cast<FrameScript_RegisterFunctionT>(
+                    Offsets::FrameScript_RegisterFunction);
+            registerFunction(const_cast<char *>(name), reinterpret_cast<uintptr_t *>(function));
+        }
+    }
+
+    void RegisterLuaFunctions() {
+        RegisterLuaFunction("PerfBoost_FrameThrottleId", &Script_FrameThrottleId);
+        RegisterLuaFunction("PerfBoost_FrameUpdate", &Script_FrameUpdate);
+        RegisterLuaFunction("PerfBoost_FrameBegin", &Script_FrameBegin);
+        RegisterLuaFunction("PerfBoost_FrameEnd", &Script_FrameEnd);
+        RegisterLuaFunction("PerfBoost_EventBegin", &Script_EventBegin);
+        RegisterLuaFunction("PerfBoost_EventEnd", &Script_EventEnd);
+        RegisterLuaFunction("PerfBoost_GetEventCost", &Script_GetEventCost);
+        RegisterLuaFunction("PerfBoost_GetStats", &Script_GetStats);
+        RegisterLuaFunction("PerfBoost_IsUnitRendered", &Script_IsUnitRendered);
+        RegisterLuaFunction("PerfBoost_NetStats", &Script_NetStats);
+    }
+
+    void UpdateLuaApi(uint64_t nowMs) {
+        EventCostResetDepth();
+
+        if ((netCongestionBandwidth > 0 || netCongestionLatency > 0) && nowMs - lastNetStatsMs >= kNetStatsIntervalMs) {
+            lastNetStatsMs = nowMs;
+            RunScript(kNetStatsScript);
+        }
+
+        // wrappers stay installed until a /reload, stop them timing handlers right away
+        if (luaMeasuringEvents != measureEvents) {
+            luaMeasuringEvents = measureEvents;
+            RunScript(EventCostStateScript());
+        }
+
+        if (nowMs - lastLuaApiUpdateMs < kLuaApiIntervalMs) {
+            return;
+        }
+        lastLuaApiUpdateMs = nowMs;
+
+        // frames created by addons after login and handlers replaced with SetScript get picked up here
+        RegisterLuaFunctions();
+        RunScript(FrameThrottleWrapScript());
+        // the flag is lost on /reload like the registered functions
+        RunScript(EventCostStateScript());
+        RunScript(EventCostWrapScript());
+
+        FrameThrottleLogStats(nowMs);
+        EventCostLogStats(nowMs);
+    }
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace perf_boost {
+    // Registers the PerfBoost_* Lua functions.  FrameScript drops registered functions when the UI is reloaded so
+    // this is called again from UpdateLuaApi.
+    void RegisterLuaFunctions();
+
+    // Called once per frame after rendering, periodically re-registers the Lua functions and wraps the
+    // PB_ThrottledFrames OnUpdate and PB_MeasureEvents OnEvent handlers.  Samples GetNetStats() for net_stats.hpp
+    // while a congestion threshold is set.
+    void UpdateLuaApi(uint64_t nowMs);
+}
@@ -27,9 +27,21 @@
     either expressed or implied, of the FreeBSD Project.
 */
 
+#include "animation_lod.hpp"
+#include "call_site.hpp"
+#include "detour.hpp"
 #include "logging.hpp"
+#include "lua_api.hpp"
 #include "offsets.hpp"
 #include "main.hpp"
+#include "game_view.hpp"
+#include "render.hpp"
+#include "settings.hpp"
+#include "spell_visuals.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+#include "unit_cache.hpp"
+#include "unit_signals.hpp"
 
 #include <cstdint>
 #include <memory>
@@ -56,687 +68,27 @@ namespace perf_boost {
 
     std::unique_ptr<hadesmem::PatchDetour<SpellVisualsInitializeT >> gSpellVisualsInitDetour;
 
-    uintptr_t *gPlayerUnit = nullptr;
-    C3Vector gPlayerPosition = {0.0f, 0.0f, 0.0f};
-    bool gPlayerInCombat = false;
-    bool gPlayerInCity = false;
-
-    bool pbEnabled;
-
-    int playerRenderDist;
-    int playerRenderDistInCities;
-    int playerRenderDistInCombat;
-    int petRenderDist;
-    int petRenderDistInCombat;
-    int summonRenderDist;
-    int summonRenderDistInCombat;
-    int trashUnitRenderDist;
-    int trashUnitRenderDistInCombat;
-    int corpseRenderDist;
-    bool alwaysRenderRaidMarks;
-    bool alwaysRenderPVP;
-    bool hideAllPlayers;
-    bool filterGuidEvents;
-
-    bool showPlayerSpellVisuals;
-    bool showPlayerGroundEffects;
-    bool showPlayerAuraVisuals;
-    bool showUnitAuraVisuals;
-    bool hideSpellsForHiddenPlayers;
-    bool applyHiddenSpellIdsToMe;
-
-    std::string hiddenSpellIdsString;
-    std::vector<uint32_t> hiddenSpellIds;
-    std::string alwaysShownSpellIdsString;
-    std::vector<uint32_t> alwaysShownSpellIds;
-
-    std::vector<PlayerData> unresolvedPlayers;
-    std::vector<PlayerData> alwaysRenderPlayersToCheck;
-    std::vector<PlayerData> resolvedPlayers;
-    std::string alwaysRenderPlayersString;
-    uint64_t lastOfflineCheckTime = 0;
-
-    std::vector<PlayerData> neverRenderUnresolvedPlayers;
-    std::vector<PlayerData> neverRenderPlayersToCheck;
-    std::vector<PlayerData> neverRenderResolvedPlayers;
-    std::string neverRenderPlayersString;
-    uint64_t neverRenderLastOfflineCheckTime = 0;
+    // call instructions redirected instead of detouring their callee, see call_site.hpp
+    CallSite gCallSites[] = {
+            {"aura visual", static_cast<uint32_t>(Offsets::AuraVisualCallSite),
+                    static_cast<uint32_t>(Offsets::CGUnitPlaySpellVisual), 0, CALL_SITE_PENDING},
+            {"missile spell visual", static_cast<uint32_t>(Offsets::MissileSpellVisualCallSite),
+                    static_cast<uint32_t>(Offsets::CGUnitGetAppropriateSpellVisual), 0, CALL_SITE_PENDING},
+    };
+    bool gMissileCallSitePatched = false;
+    bool gAnimateHookInstalled = false;
 
     uint32_t GetTime() {
         return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::high_resolution_clock::now().time_since_epoch()).count()) - gStartTime;
     }
 
-    uint64_t GetWowTimeMs() {
-        auto const osGetAsyncTimeMs = reinterpret_cast<GetTimeMsT>(Offsets::OsGetAsyncTimeMs);
-        return osGetAsyncTimeMs();
-    }
-
     uintptr_t *GetLuaStatePtr() {
         typedef uintptr_t *(__fastcall *GETCONTEXT)(void);
         static auto p_GetContext = reinterpret_cast<GETCONTEXT>(Offsets::lua_getcontext);
         return p_GetContext();
     }
 
-
-    char *UnitGetName(uintptr_t *unit) {
-        if (!unit) {
-            return nullptr;
-        }
-
-        auto const GetUnitName = reinterpret_cast<CGUnitGetNameT>(Offsets::CGUnitGetUnitName);
-        return GetUnitName(unit, 0);
-    }
-
-    float fastApproxDistance(C3Vector &vec) {
-        // Manhattan distance (fastest, ~2-3x error)
-        // return std::abs(vec.x) + std::abs(vec.y) + std::abs(vec.z);
-
-        // Octagonal approximation (fast, ~8% max error)
-        float ax = std::abs(vec.x);
-        float ay = std::abs(vec.y);
-        float az = std::abs(vec.z);
-
-        // Sort components so ax >= ay >= az
-        if (ax < ay) std::swap(ax, ay);
-        if (ay < az) std::swap(ay, az);
-        if (ax < ay) std::swap(ax, ay);
-
-        // Approximation: largest + 0.5*middle + 0.25*smallest
-        return ax + 0.5f * ay + 0.25f * az;
-    }
-
-    int ApproximateDistanceBetween(const C3Vector &pos0, const C3Vector &pos1) {
-        C3Vector v = {};
-        v.x = pos0.x - pos1.x;
-        v.y = pos0.y - pos1.y;
-        v.z = pos0.z - pos1.z;
-        return (int) fastApproxDistance(v);
-    }
-
-    bool IsPlayerInCity() {
-        // Get current area ID from memory
-        uint32_t areaId = *reinterpret_cast<uint32_t *>(Offsets::ZoneAreaIds);
-
-        // Major city area IDs for WoW 1.12.1
-        switch (areaId) {
-            case 1537: // Ironforge
-            case 1519: // Stormwind City
-            case 1657: // Darnassus
-            case 1637: // Orgrimmar
-            case 1638: // Thunder Bluff
-            case 1497: // Undercity
-            case 2040: // Alah'Thalas
-            case 75:   // Stonard
-                return true;
-            default:
-                return false;
-        }
-    }
-
-    int GetRaidMarkForGuid(uint64_t targetGUID) {
-        if (targetGUID == 0) {
-            return -1;
-        }
-
-        for (int result = 0; result < 8; ++result) {
-            if (*reinterpret_cast<uint64_t *>(0xb71368 + result * 8) == targetGUID) {
-                return result + 1;
-            }
-        }
-
-        return -1;
-    }
-
-    C3Vector UnitGetPosition(uintptr_t *unit) {
-        C3Vector result = {};
-
-        if (unit == 0 || ((int) unit & 1) != 0) {
-            return result;
-        }
-
-        uint32_t memberFunctions = *reinterpret_cast<uint32_t *>(unit);
-        if (memberFunctions == 0 || (memberFunctions & 1) != 0) {
-            return result;
-        }
-
-        uint32_t getPositionPtr = *reinterpret_cast<uint32_t *>(memberFunctions + 0x14);
-        if (getPositionPtr == 0 || (getPositionPtr & 1) != 0) {
-            return result;
-        }
-
-        auto getPositionFn = reinterpret_cast<CGUnitGetPositionT>(getPositionPtr);
-        getPositionFn(unit, &result);
-
-        return result;
-    }
-
-    OBJECT_TYPE_ID UnitGetType(uintptr_t *unit) {
-        return *reinterpret_cast<OBJECT_TYPE_ID *>(unit + 5);
-    }
-
-    uint64_t UnitGetGuid(uintptr_t *unit) {
-        if (!unit) {
-            return 0;
-        }
-
-        uint64_t guid = *reinterpret_cast<uint64_t *>(unit + 12);
-        return guid;
-    }
-
-
-    uint32_t UnitGetLevel(uintptr_t *unit) {
-        if (!unit) {
-            return false;
-        }
-
-        auto *unitFields = *reinterpret_cast<UnitFields **>(unit + 68);
-
-        if (unitFields == nullptr) {
-            // we don't have attribute info.
-            return -1;
-        }
-
-        return unitFields->level;
-    }
-
-    bool UnitIsDead(uintptr_t *unit) {
-        if (!unit) {
-            return false;
-        }
-
-        auto *unitFields = *reinterpret_cast<UnitFields **>(unit + 68);
-
-        if (unitFields == nullptr) {
-            // we don't have attribute info.
-            return false;
-        }
-
-        auto health = unitFields->health;
-        auto dynamicFlags = unitFields->dynamicFlags;
-
-        if (health < 1 || (dynamicFlags & 0x20) != 0) {
-            return true;
-        } else {
-            return false;
-        }
-    }
-
-    bool UnitIsControlledByPlayer(uintptr_t *unit) {
-        if (!unit) {
-            return false;
-        }
-
-        auto *unitFields = *reinterpret_cast<UnitFields **>(unit + 68);
-        if (unitFields == nullptr) {
-            // we don't have attribute info.
-            return false;
-        }
-
-        auto flags = unitFields->flags;
-
-        if ((flags & UNIT_FLAG_PLAYER_CONTROLLED) != 0) {
-            return true;
-        } else {
-            return false;
-        }
-    }
-
-    bool UnitIsInCombat(uintptr_t *unit) {
-        if (!unit) {
-            return false;
-        }
-
-        auto *unitFields = *reinterpret_cast<UnitFields **>(unit + 68);
-
-        if (unitFields == nullptr) {
-            // we don't have attribute info.
-            return false;
-        }
-
-        auto flags = unitFields->flags;
-        if ((flags & UNIT_FLAG_IN_COMBAT) != 0) {
-            return true;
-        } else {
-            return false;
-        }
-    }
-
-    bool UnitCanAttackUnit(uintptr_t *unit1, uintptr_t *unit2) {
-        if (unit1 == nullptr || unit2 == nullptr) {
-            return false;
-        }
-
-        auto canAttackFn = reinterpret_cast<CGUnitCanAttackT>(Offsets::CGUnitCanAttack);
-        return canAttackFn(unit1, unit2);
-    }
-
-    bool UnitIsCharmed(uintptr_t *unit) {
-        if (!unit) {
-            return false;
-        }
-
-        auto *unitFields = *reinterpret_cast<UnitFields **>(unit + 68);
-
-        if (unitFields == nullptr) {
-            // we don't have attribute info.
-            return false;
-        }
-
-        return unitFields->charmedBy != 0;
-    }
-
-    bool UnitIsPvpFlagged(uintptr_t *unit) {
-        if (!unit) {
-            return false;
-        }
-
-        auto *unitFields = *reinterpret_cast<UnitFields **>(unit + 68);
-
-        if (unitFields == nullptr) {
-            // we don't have attribute info.
-            return false;
-        }
-
-        auto flags = unitFields->flags;
-        return (flags & UNIT_FLAG_PVP);
-    }
-
-    std::uint64_t ClntObjMgrGetActivePlayerGuid() {
-        auto const getActivePlayer = hadesmem::detail::AliasCast<decltype(&ClntObjMgrGetActivePlayerGuid)>(
-                Offsets::GetActivePlayer);
-
-        return getActivePlayer();
-    }
-
-    uintptr_t *GetObjectPtr(std::uint64_t guid) {
-        uintptr_t *(__stdcall *getObjectPtr)(std::uint64_t) = hadesmem::detail::AliasCast<decltype(getObjectPtr)>(
-                Offsets::GetObjectPtr);
-
-        return getObjectPtr(guid);
-    }
-
-    uintptr_t *ClntObjMgrObjectPtr(OBJECT_TYPE_MASK typeMask, std::uint64_t guid) {
-        auto const clntObjMgrObjectPtr = reinterpret_cast<ClntObjMgrObjectPtrT>(Offsets::ClntObjMgrObjectPtr);
-        return clntObjMgrObjectPtr(typeMask, nullptr, guid, 0);
-    }
-
-    void parseHiddenSpellIds(const std::string &spellIdString) {
-        hiddenSpellIds.clear();
-        if (spellIdString.empty()) {
-            return;
-        }
-
-        std::stringstream ss(spellIdString);
-        std::string item;
-        while (std::getline(ss, item, ',')) {
-            item.erase(item.find_last_not_of(" \t\n\r\f\v") + 1); // rtrim
-            item.erase(0, item.find_first_not_of(" \t\n\r\f\v")); // ltrim
-            if (!item.empty()) {
-                try {
-                    uint32_t spellId = std::stoul(item);
-                    hiddenSpellIds.push_back(spellId);
-                } catch (const std::exception &e) {
-                    DEBUG_LOG("Invalid spell ID in HiddenSpellIds: " << item);
-                }
-            }
-        }
-    }
-
-    void parseAlwaysShownSpellIds(const std::string &spellIdString) {
-        alwaysShownSpellIds.clear();
-        if (spellIdString.empty()) {
-            return;
-        }
-
-        std::stringstream ss(spellIdString);
-        std::string item;
-        while (std::getline(ss, item, ',')) {
-            item.erase(item.find_last_not_of(" \t\n\r\f\v") + 1); // rtrim
-            item.erase(0, item.find_first_not_of(" \t\n\r\f\v")); // ltrim
-            if (!item.empty()) {
-                try {
-                    uint32_t spellId = std::stoul(item);
-                    alwaysShownSpellIds.push_back(spellId);
-                } catch (const std::exception &e) {
-                    DEBUG_LOG("Invalid spell ID in AlwaysShownSpellIds: " << item);
-                }
-            }
-        }
-    }
-
-    void parseAlwaysRenderPlayers(const std::string &value) {
-        unresolvedPlayers.clear();
-        alwaysRenderPlayersToCheck.clear();
-        resolvedPlayers.clear();
-        alwaysRenderPlayersString = value;
-        lastOfflineCheckTime = 0;
-
-        if (value.empty()) {
-            DEBUG_LOG("AlwaysRenderPlayers list cleared");
-            return;
-        }
-
-        std::stringstream ss(value);
-        std::string playerName;
-
-        while (std::getline(ss, playerName, ',')) {
-            playerName.erase(0, playerName.find_first_not_of(" \t"));
-            playerName.erase(playerName.find_last_not_of(" \t") + 1);
-
-            if (!playerName.empty()) {
-                unresolvedPlayers.emplace_back(playerName.c_str());
-                DEBUG_LOG("Added player to unresolvedPlayers: " << playerName.c_str());
-            }
-        }
-    }
-
-    void parseNeverRenderPlayers(const std::string &value) {
-        neverRenderUnresolvedPlayers.clear();
-        neverRenderPlayersToCheck.clear();
-        neverRenderResolvedPlayers.clear();
-        neverRenderPlayersString = value;
-        neverRenderLastOfflineCheckTime = 0;
-
-        if (value.empty()) {
-            DEBUG_LOG("NeverRenderPlayers list cleared");
-            return;
-        }
-
-        std::stringstream ss(value);
-        std::string playerName;
-
-        while (std::getline(ss, playerName, ',')) {
-            playerName.erase(0, playerName.find_first_not_of(" \t"));
-            playerName.erase(playerName.find_last_not_of(" \t") + 1);
-
-            if (!playerName.empty()) {
-                neverRenderUnresolvedPlayers.emplace_back(playerName.c_str());
-                DEBUG_LOG("Added player to neverRenderUnresolvedPlayers: " << playerName.c_str());
-            }
-        }
-    }
-
-    bool shouldAlwaysRenderPlayer(uintptr_t *unitPtr, uint64_t unitGuid) {
-        // Check resolved players first (fastest lookup)
-        for (const auto &player: resolvedPlayers) {
-            if (player.guid == unitGuid) {
-                return true;
-            }
-        }
-
-        // Check alwaysRenderPlayersToCheck and try to resolve them
-        if (!alwaysRenderPlayersToCheck.empty()) {
-            char *unitName = UnitGetName(unitPtr);
-            if (unitName) {
-                auto it = alwaysRenderPlayersToCheck.begin();
-                while (it != alwaysRenderPlayersToCheck.end()) {
-                    if (strcmp(it->name, unitName) == 0) {
-                        // Found match, move to resolved players
-                        PlayerData resolvedPlayer = *it;
-                        resolvedPlayer.guid = unitGuid;
-                        resolvedPlayer.resolved = true;
-                        resolvedPlayers.push_back(resolvedPlayer);
-
-                        // Remove from alwaysRenderPlayersToCheck and unresolvedPlayers
-                        alwaysRenderPlayersToCheck.erase(it);
-                        auto unresolvedIt = std::find_if(unresolvedPlayers.begin(), unresolvedPlayers.end(),
-                                                         [&](const PlayerData &p) {
-                                                             return strcmp(p.name, unitName) == 0;
-                                                         });
-                        if (unresolvedIt != unresolvedPlayers.end()) {
-                            unresolvedPlayers.erase(unresolvedIt);
-                        }
-
-                        DEBUG_LOG("Resolved player " << unitName << " with GUID: " << std::hex << unitGuid);
-                        return true;
-                    } else {
-                        ++it;
-                    }
-                }
-            }
-        }
-
-        return false;
-    }
-
-    bool shouldNeverRenderPlayer(uintptr_t *unitPtr, uint64_t unitGuid) {
-        // Check resolved players first (fastest lookup)
-        for (const auto &player: neverRenderResolvedPlayers) {
-            if (player.guid == unitGuid) {
-                return true; // Found in blacklist, never render
-            }
-        }
-
-        // Check neverRenderPlayersToCheck and try to resolve them
-        if (!neverRenderPlayersToCheck.empty()) {
-            char *unitName = UnitGetName(unitPtr);
-            if (unitName) {
-                auto it = neverRenderPlayersToCheck.begin();
-                while (it != neverRenderPlayersToCheck.end()) {
-                    if (strcmp(it->name, unitName) == 0) {
-                        // Found match, move to resolved players
-                        PlayerData resolvedPlayer = *it;
-                        resolvedPlayer.guid = unitGuid;
-                        resolvedPlayer.resolved = true;
-                        neverRenderResolvedPlayers.push_back(resolvedPlayer);
-
-                        // Remove from neverRenderPlayersToCheck and neverRenderUnresolvedPlayers
-                        neverRenderPlayersToCheck.erase(it);
-                        auto unresolvedIt = std::find_if(neverRenderUnresolvedPlayers.begin(),
-                                                         neverRenderUnresolvedPlayers.end(),
-                                                         [&](const PlayerData &p) {
-                                                             return strcmp(p.name, unitName) == 0;
-                                                         });
-                        if (unresolvedIt != neverRenderUnresolvedPlayers.end()) {
-                            neverRenderUnresolvedPlayers.erase(unresolvedIt);
-                        }
-
-                        DEBUG_LOG(
-                                "Resolved never-render player " << unitName << " with GUID: " << std::hex << unitGuid);
-                        return true; // Found in blacklist, never render
-                    } else {
-                        ++it;
-                    }
-                }
-            }
-        }
-
-        return false; // Not in blacklist, allow rendering
-    }
-
-    void OnWorldRenderHook(hadesmem::PatchDetourBase *detour, uintptr_t *worldFrame) {
-        // store player data once before ShouldRender is called
-        auto playerGuid = ClntObjMgrGetActivePlayerGuid();
-        if (playerGuid != 0) {
-            gPlayerUnit = nullptr;
-            auto unitPtr = GetObjectPtr(ClntObjMgrGetActivePlayerGuid());
-            if (unitPtr != nullptr) {
-                // check that descriptor fields are loaded
-                auto *unitFields = *reinterpret_cast<UnitFields **>(unitPtr + 68);
-                if (unitFields != nullptr && unitFields->level > 0) {
-                    gPlayerUnit = unitPtr;
-                }
-            }
-            if (gPlayerUnit) {
-                gPlayerPosition = UnitGetPosition(gPlayerUnit);
-                gPlayerInCombat = UnitIsInCombat(gPlayerUnit);
-                gPlayerInCity = IsPlayerInCity();
-            }
-        }
-
-        uint64_t currentTime = GetWowTimeMs();
-
-        // Every 60 seconds: move unresolved players to alwaysRenderPlayersToCheck if there are any
-        if (gPlayerUnit && !unresolvedPlayers.empty() && (currentTime - lastOfflineCheckTime) > 60000) {
-            alwaysRenderPlayersToCheck.insert(alwaysRenderPlayersToCheck.end(), unresolvedPlayers.begin(),
-                                              unresolvedPlayers.end());
-            DEBUG_LOG("Moved " << unresolvedPlayers.size() << " unresolved players to alwaysRenderPlayersToCheck");
-            unresolvedPlayers.clear();
-            lastOfflineCheckTime = currentTime;
-        }
-
-        // Every 60 seconds: move neverRender unresolved players to neverRenderPlayersToCheck if there are any
-        if (gPlayerUnit && !neverRenderUnresolvedPlayers.empty() &&
-            (currentTime - neverRenderLastOfflineCheckTime) > 60000) {
-            neverRenderPlayersToCheck.insert(neverRenderPlayersToCheck.end(), neverRenderUnresolvedPlayers.begin(),
-                                             neverRenderUnresolvedPlayers.end());
-            DEBUG_LOG("Moved " << neverRenderUnresolvedPlayers.size()
-                               << " neverRender unresolved players to neverRenderPlayersToCheck");
-            neverRenderUnresolvedPlayers.clear();
-            neverRenderLastOfflineCheckTime = currentTime;
-        }
-
-        auto const OnWorldRender = detour->GetTrampolineT<FastcallFrameT>();
-        OnWorldRender(worldFrame);
-
-        if (!alwaysRenderPlayersToCheck.empty()) {
-            // move any remaining players from alwaysRenderPlayersToCheck back to unresolvedPlayers
-            unresolvedPlayers.insert(unresolvedPlayers.end(), alwaysRenderPlayersToCheck.begin(),
-                                     alwaysRenderPlayersToCheck.end());
-            DEBUG_LOG("Moved " << alwaysRenderPlayersToCheck.size() << " players back to unresolvedPlayers");
-            alwaysRenderPlayersToCheck.clear();
-        }
-
-        if (!neverRenderPlayersToCheck.empty()) {
-            // move any remaining neverRender players from neverRenderPlayersToCheck back to neverRenderUnresolvedPlayers
-            neverRenderUnresolvedPlayers.insert(neverRenderUnresolvedPlayers.end(), neverRenderPlayersToCheck.begin(),
-                                                neverRenderPlayersToCheck.end());
-            DEBUG_LOG("Moved " << neverRenderPlayersToCheck.size()
-                               << " neverRender players back to neverRenderUnresolvedPlayers");
-            neverRenderPlayersToCheck.clear();
-        }
-    }
-
-    bool ShouldRenderBasedOnDistance(uintptr_t *this_ptr, int renderDist) {
-        if (renderDist == 0) {
-            return false; // if dist 0 immediately return false
-        } else if (renderDist > 0) {
-            auto distance = ApproximateDistanceBetween(UnitGetPosition(this_ptr), gPlayerPosition);
-            return distance < renderDist;
-        }
-        return true; // default to true if renderDist is negative
-    }
-
-
-    uint32_t shouldRenderPlayer(uintptr_t *unitPtr) {
-        if (hideAllPlayers) {
-            return 0; // Hide all players
-        }
-        auto unitGuid = UnitGetGuid(unitPtr);
-        if (alwaysRenderRaidMarks) {
-            auto raidMark = GetRaidMarkForGuid(unitGuid);
-
-            if (raidMark > 0) {
-                // always render players with raid marks
-                return 1;
-            }
-        }
-
-        // check if this player is in NeverRenderPlayers blacklist
-        if (shouldNeverRenderPlayer(unitPtr, unitGuid)) {
-            return 0; // Force hide this player
-        }
-
-        // always show MC players
-        if (UnitIsCharmed(unitPtr)) {
-            return 1;
-        }
-
-        // always show PvP-flagged players if cvar on
-        if (alwaysRenderPVP && UnitIsPvpFlagged(unitPtr)) {
-            // check if attackable
-            // get fresh unit ptr to avoid issues on loading screens
-            auto playerPtr = GetObjectPtr(ClntObjMgrGetActivePlayerGuid());
-            if (playerPtr){
-                // only show if attackable so we don't show pvp players in group/raid
-                if (UnitCanAttackUnit(playerPtr, unitPtr)) {
-                    return 1;
-                }
-            }
-        }
-
-        // check if this player is in AlwaysRenderPlayers list
-        if (shouldAlwaysRenderPlayer(unitPtr, unitGuid)) {
-            return 1;
-        }
-
-        int renderDist;
-        if (gPlayerInCombat && playerRenderDistInCombat != -1) {
-            renderDist = playerRenderDistInCombat;
-        } else if (gPlayerInCity && playerRenderDistInCities != -1) {
-            renderDist = playerRenderDistInCities;
-        } else {
-            renderDist = playerRenderDist;
-        }
-        return ShouldRenderBasedOnDistance(unitPtr, renderDist);
-    }
-
-    uint32_t shouldRenderUnit(uintptr_t *unitPtr) {
-        if (alwaysRenderRaidMarks) {
-            auto raidMark = GetRaidMarkForGuid(UnitGetGuid(unitPtr));
-
-            if (raidMark > 0) {
-                // always render raid marks
-                return 1;
-            }
-        }
-
-        auto isDead = UnitIsDead(unitPtr);
-        if (isDead && corpseRenderDist != -1) {
-            // some corpses (lootable ones?) are dead units
-            int renderDist = corpseRenderDist;
-            return ShouldRenderBasedOnDistance(unitPtr, renderDist);
-        } else {
-            // Check if it's a pet (controlled by player)
-            if (UnitIsControlledByPlayer(unitPtr)) {
-                auto *unitFields = *reinterpret_cast<UnitFields **>(unitPtr + 68);
-
-                // always show your own summons
-                if (unitFields->summonedBy != ClntObjMgrGetActivePlayerGuid()) {
-                    if (unitFields->petNameTimestamp > 0) {
-                        // This is a pet with a name
-                        int renderDist = (gPlayerInCombat && petRenderDistInCombat != -1)
-                                         ? petRenderDistInCombat
-                                         : petRenderDist;
-                        return ShouldRenderBasedOnDistance(unitPtr, renderDist);
-                    } else {
-                        // This is a summon (player-controlled unit without name)
-                        if (summonRenderDist != -1) {
-                            int renderDist = (gPlayerInCombat && summonRenderDistInCombat != -1)
-                                             ? summonRenderDistInCombat
-                                             : summonRenderDist;
-                            return ShouldRenderBasedOnDistance(unitPtr, renderDist);
-                        }
-                    }
-                }
-            }
-
-            auto unitLevel = UnitGetLevel(unitPtr);
-            if (unitLevel < 63) {
-                int renderDist = (gPlayerInCombat && trashUnitRenderDistInCombat != -1)
-                                 ? trashUnitRenderDistInCombat : trashUnitRenderDist;
-                return ShouldRenderBasedOnDistance(unitPtr, renderDist);
-            }
-        }
-
-        return 1; // Default to rendering the unit
-    }
-
-    uint32_t shouldRenderCorpse(uintptr_t *unitPtr) {
-        int renderDist = corpseRenderDist;
-        return ShouldRenderBasedOnDistance(unitPtr, renderDist);
-    }
-
-    const SpellRec *GetSpellInfo(uint32_t spellId) {
-        auto const spellDb = reinterpret_cast<WowClientDB<SpellRec> *>(Offsets::SpellDb);
-
-        if (spellId > spellDb->m_maxId)
-            return nullptr;
-
-        return spellDb->m_recordsById[spellId];
-    }
-
     const char *GetSpellName(uint32_t spellId) {
         auto const spell = GetSpellInfo(spellId);
 
@@ -748,146 +100,46 @@ namespace perf_boost {
         return spell->SpellName[language];
     }
 
-    bool shouldHideSpellForUnit(uintptr_t *unitPtr, const SpellRec *spellRec) {
-        if (!spellRec || !unitPtr) {
-            return false;
-        }
-
-        if(pbEnabled) {
-            // Check if this spell ID should always be shown (applies to all units including player)
-            if (!alwaysShownSpellIds.empty()) {
-                auto it = std::find(alwaysShownSpellIds.begin(), alwaysShownSpellIds.end(), spellRec->Id);
-                if (it != alwaysShownSpellIds.end()) {
-                    return false; // Always show this spell
-                }
-            }
-
-            if (unitPtr != gPlayerUnit) {
-                auto unitType = UnitGetType(unitPtr);
-                if (unitType == OBJECT_TYPE_PLAYER) {
-                    // Check if we should show player spells
-                    if (!showPlayerSpellVisuals) {
-                        // hide visuals for players other than the player
-                        return true;
-                    }
-
-                    // Check if we should hide spells for hidden players
-                    if (hideSpellsForHiddenPlayers && shouldRenderPlayer(unitPtr) == 0) {
-                        // hide spells for players that would be hidden
-                        return true;
-                    }
-                }
-            }
-
-            // Check if this spell ID should be hidden (apply to all units or just others based on cvar)
-            if (!hiddenSpellIds.empty() && (unitPtr != gPlayerUnit || applyHiddenSpellIdsToMe)) {
-                auto it = std::find(hiddenSpellIds.begin(), hiddenSpellIds.end(), spellRec->Id);
-                if (it != hiddenSpellIds.end()) {
-                    return true;
-                }
-            }
-        }
-
-        return false; // Do not hide this spell
-    }
-
-    bool shouldHideGroundEffectForUnit(uintptr_t *unitPtr, const SpellRec *spellRec) {
-        if (!spellRec || !unitPtr) {
-            return false;
+    void OnWorldRenderHook(hadesmem::PatchDetourBase *detour, uintptr_t *worldFrame) {
+        BeginFrame();
+        if (gTraceCapturing) {
+            TraceFrame();
         }
 
-        if(pbEnabled) {
-            // Check if this spell ID should always be shown (applies to all units including player)
-            if (!alwaysShownSpellIds.empty()) {
-                auto it = std::find(alwaysShownSpellIds.begin(), alwaysShownSpellIds.end(), spellRec->Id);
-                if (it != alwaysShownSpellIds.end()) {
-                    return false; // Always show this spell
-                }
-            }
-
-            if (unitPtr != gPlayerUnit) {
-                auto unitType = UnitGetType(unitPtr);
-                if (unitType == OBJECT_TYPE_PLAYER) {
-                    // Check if we should show player ground effects
-                    if (!showPlayerGroundEffects) {
-                        // hide ground effects for players other than the player
-                        return true;
-                    }
-
-                    // Check if we should hide spells for hidden players
-                    if (hideSpellsForHiddenPlayers && shouldRenderPlayer(unitPtr) == 0) {
-                        // hide spells for players that would be hidden
-                        return true;
-                    }
-                }
-            }
-
-            // Check if this spell ID should be hidden (apply to all units or just others based on cvar)
-            if (!hiddenSpellIds.empty() && (unitPtr != gPlayerUnit || applyHiddenSpellIdsToMe)) {
-                auto it = std::find(hiddenSpellIds.begin(), hiddenSpellIds.end(), spellRec->Id);
-                if (it != hiddenSpellIds.end()) {
-                    return true;
-                }
-            }
-        }
+        auto const OnWorldRender = detour->GetTrampolineT<FastcallFrameT>();
+        OnWorldRender(worldFrame);
 
-        return false; // Do not hide this spell
+        EndFrame();
+        UpdateLuaApi(GetWowTimeMs());
     }
 
-    bool shouldHideAuraEffectForUnit(uintptr_t *unitPtr, const SpellRec *spellRec) {
-        if (!spellRec || !unitPtr) {
-            return false;
+    // Called straight from the aura visual call site, every other CGUnitPlaySpellVisual caller runs untouched
+    void __fastcall AuraVisualCallSiteHandler(uintptr_t *unitPtr, void *dummy_edx, SpellRec *spellRec,
+                                              uintptr_t *visualKit, void *param_3, void *param_4) {
+        if (gTraceCapturing) {
+            TraceVisual(TraceVisualKind::Aura, unitPtr, spellRec);
         }
-
-        if(pbEnabled) {
-            // Check if this spell ID should always be shown (applies to all units including player)
-            if (!alwaysShownSpellIds.empty()) {
-                auto it = std::find(alwaysShownSpellIds.begin(), alwaysShownSpellIds.end(), spellRec->Id);
-                if (it != alwaysShownSpellIds.end()) {
-                    return false; // Always show this spell
-                }
-            }
-
-            if (unitPtr != gPlayerUnit) {
-                auto unitType = UnitGetType(unitPtr);
-                if (unitType == OBJECT_TYPE_PLAYER) {
-                    // Check if we should show player aura visuals
-                    if (!showPlayerAuraVisuals) {
-                        return true;
-                    }
-
-                    // Check if we should hide spells for hidden players
-                    if (hideSpellsForHiddenPlayers && shouldRenderPlayer(unitPtr) == 0) {
-                        // hide spells for players that would be hidden
-                        return true;
-                    }
-                } else {
-                    // Check if we should show unit aura visuals
-                    if (!showUnitAuraVisuals) {
-                        return true;
-                    }
-                }
-            }
-
-            // Check if this spell ID should be hidden (apply to all units or just others based on cvar)
-            if (!hiddenSpellIds.empty() && (unitPtr != gPlayerUnit || applyHiddenSpellIdsToMe)) {
-                auto it = std::find(hiddenSpellIds.begin(), hiddenSpellIds.end(), spellRec->Id);
-                if (it != hiddenSpellIds.end()) {
-                    return true;
-                }
-            }
+        if (shouldHideAuraEffectForUnit(unitPtr, spellRec)) {
+            CountSuppressedVisual();
+            return;
         }
 
-        return false; // Do not hide this spell
+        auto const CGUnitPlaySpellVisual = reinterpret_cast<CGUnitPlaySpellVisualT>(Offsets::CGUnitPlaySpellVisual);
+        CGUnitPlaySpellVisual(unitPtr, dummy_edx, spellRec, visualKit, param_3, param_4);
     }
 
+    // Only used when the aura visual call site couldn't be patched
     void
     CGUnitPlaySpellVisualHook(hadesmem::PatchDetourBase *detour, uintptr_t *unitPtr, void *dummy_edx,
                               SpellRec *spellRec,
                               uintptr_t *visualKit, void *param_3, void *param_4) {
         // get aura visual return address 0X005FF4CB
         if (reinterpret_cast<int>(detour->GetReturnAddressPtr()) == 0X005FF4CB) {
+            if (gTraceCapturing) {
+                TraceVisual(TraceVisualKind::Aura, unitPtr, spellRec);
+            }
             if (shouldHideAuraEffectForUnit(unitPtr, spellRec)) {
+                CountSuppressedVisual();
                 return;
             }
         }
@@ -898,15 +150,16 @@ namespace perf_boost {
 
     void
     CGUnitPlayChannelVisualHook(hadesmem::PatchDetourBase *detour, uintptr_t *unitPtr, void *dummy_edx) {
-        auto *unitFields = *reinterpret_cast<UnitFields **>(unitPtr + 68);
-
-        auto channelSpellId = unitFields->channelSpell;
-        if (channelSpellId > 0) {
-            auto spellRec = GetSpellInfo(channelSpellId);
-            if (shouldHideSpellForUnit(unitPtr, spellRec)) {
-                return; // Hide channel visual if the spell is hidden
+        if (gTraceCapturing) {
+            auto *unitFields = UnitGetFields(unitPtr);
+            if (unitFields && unitFields->channelSpell > 0) {
+                TraceVisual(TraceVisualKind::Channel, unitPtr, GetSpellInfo(unitFields->channelSpell));
             }
         }
+        if (shouldHideChannelVisual(unitPtr)) {
+            CountSuppressedVisual();
+            return; // Hide channel visual if the spell is hidden
+        }
 
         auto const CGUnitPlayChannelVisual = detour->GetTrampolineT<CGUnitPlayChannelVisualT>();
         CGUnitPlayChannelVisual(unitPtr, dummy_edx);
@@ -915,14 +168,18 @@ namespace perf_boost {
     uintptr_t *
     CGUnitGetAppropriateSpellVisualHook(hadesmem::PatchDetourBase *detour, uintptr_t *unitPtr, void *dummy_edx,
                                         SpellRec *spellRec, uintptr_t *visualKit) {
-        // Don't mess with visuals in GetMissileTargetLocation as it expects it never to be null
-        // GetMissileTargetLocation return address 0x006EC80C
-        if (reinterpret_cast<int>(detour->GetReturnAddressPtr()) != 0x006EC80C) {
-            // spell effect 27 is PERSISTENT_AREA_AURA used by ground effects
-            if ((spellRec->Effect[0] == 27 || spellRec->Effect[1] == 27 || spellRec->Effect[2] == 27) &&
-                shouldHideGroundEffectForUnit(unitPtr, spellRec)) {
+        // Don't mess with visuals in GetMissileTargetLocation as it expects it never to be null.  Normally its call
+        // site goes straight to the trampoline and never gets here, return address 0x006EC80C
+        if (gMissileCallSitePatched || reinterpret_cast<int>(detour->GetReturnAddressPtr()) != 0x006EC80C) {
+            if (gTraceCapturing) {
+                TraceVisual(IsGroundEffectSpell(spellRec) ? TraceVisualKind::GroundEffect : TraceVisualKind::Spell,
+                            unitPtr, spellRec);
+            }
+            if (IsGroundEffectSpell(spellRec) && shouldHideGroundEffectForUnit(unitPtr, spellRec)) {
+                CountSuppressedVisual();
                 return nullptr; // Return null to hide the visual {
             } else if (shouldHideSpellForUnit(unitPtr, spellRec)) {
+                CountSuppressedVisual();
                 return nullptr; // Return null to hide the visual
             }
         }
@@ -940,13 +197,12 @@ namespace perf_boost {
     SpellVisualEffectNameRec *
     CGDynamicObjectGetVisualEffectNameRecHook(hadesmem::PatchDetourBase *detour, uintptr_t *dynamicObjPtr,
                                               void *dummy_edx) {
-        auto *dynamicObjectFields = *reinterpret_cast<DynamicObjectFields **>(dynamicObjPtr + 68);
-
-        if (dynamicObjectFields != nullptr) {
-            auto unitPtr = ClntObjMgrObjectPtr(TYPE_MASK_UNIT, dynamicObjectFields->m_caster);
-            if (shouldHideGroundEffectForUnit(unitPtr, GetSpellInfo(dynamicObjectFields->m_spellID))) {
-                return nullptr;
-            }
+        if (gTraceCapturing) {
+            TraceVisual(TraceVisualKind::DynamicObject, dynamicObjPtr, nullptr);
+        }
+        if (shouldHideDynamicObjectVisual(dynamicObjPtr)) {
+            CountSuppressedVisual();
+            return nullptr;
         }
 
         auto const CGDynamicObjectGetVisualEffectNameRec = detour->GetTrampolineT<CGDynamicObjectGetVisualEffectNameRecT>();
@@ -954,13 +210,12 @@ namespace perf_boost {
     }
 
     void ObjectVisKitProcHook(hadesmem::PatchDetourBase *detour, uintptr_t *dynamicObjPtr) {
-        auto *dynamicObjectFields = *reinterpret_cast<DynamicObjectFields **>(dynamicObjPtr + 68);
-
-        if (dynamicObjectFields != nullptr) {
-            auto unitPtr = ClntObjMgrObjectPtr(TYPE_MASK_UNIT, dynamicObjectFields->m_caster);
-            if (shouldHideGroundEffectForUnit(unitPtr, GetSpellInfo(dynamicObjectFields->m_spellID))) {
-                return;
-            }
+        if (gTraceCapturing) {
+            TraceVisual(TraceVisualKind::DynamicObject, dynamicObjPtr, nullptr);
+        }
+        if (shouldHideDynamicObjectVisual(dynamicObjPtr)) {
+            CountSuppressedVisual();
+            return;
         }
 
         auto const ObjectVisKitProc = detour->GetTrampolineT<ObjectVisKitProcT>();
@@ -980,13 +235,11 @@ namespace perf_boost {
 
                 for (int i = 0; i < numNames; i++) {
                     if (names[i]) {
-                        // check if names starts with 0x (raw guids from super wow)
-                        // don't trigger with guid for any event codes below 182 (UNIT_COMBAT)
-                        // don't trigger for 183(UNIT_NAME_UPDATE), 184(UNIT_PORTRAIT_UPDATE), 186(UNIT_INVENTORY_CHANGED), 345(PLAYER_GUILD_UPDATE)
-                        // this turns off UNIT_AURA, UNIT_HEALTH, UNIT_MANA spam for guids
-                        if (filterGuidEvents && strncmp(names[i], "0x", 2) == 0 &&
-                            (eventCode < 182 || eventCode == 183 || eventCode == 184 || eventCode == 186 ||
-                             eventCode == 345)) {
+                        if (gTraceCapturing) {
+                            TraceUnitSignal(*guid, eventCode, names[i]);
+                        }
+                        if (shouldFilterGuidEvent(names[i], eventCode)) {
+                            CountFilteredEvent();
                             continue;
                         }
                         SignalEventParam(eventCode, format, names[i]);
@@ -996,118 +249,51 @@ namespace perf_boost {
         }
     }
 
+    void ObjectFreeHook(hadesmem::PatchDetourBase *detour, int param_1, uint32_t param_2) {
+        // param_1 is the object being freed, drop anything cached for its guid while it can still be read
+        OnObjectFree(reinterpret_cast<uintptr_t *>(param_1));
+
+        auto const ObjectFree = detour->GetTrampolineT<ObjectFreeT>();
+        ObjectFree(param_1, param_2);
+    }
+
     void CGUnitPreAnimateHook(hadesmem::PatchDetourBase *detour, uintptr_t *unitPtr, void *dummy_edx, void *param_1) {
         auto const CGUnitPreAnimate = detour->GetTrampolineT<CGUnitPreAnimateT>();
         CGUnitPreAnimate(unitPtr, dummy_edx, param_1);
     }
 
-    void CGUnitAnimateHook(hadesmem::PatchDetourBase *detour, uintptr_t *unitPtr, void *dummy_edx, int *param_3) {
-        auto const CGUnitAnimate = detour->GetTrampolineT<CGUnitAnimateT>();
-        CGUnitAnimate(unitPtr, dummy_edx, param_3);
+    void __fastcall CGUnitAnimateHandler(uintptr_t *unitPtr, void *dummy_edx, int *param_3);
+    using CGUnitAnimateDetour = StaticDetour<CGUnitAnimateT, &CGUnitAnimateHandler>;
+
+    void __fastcall CGUnitAnimateHandler(uintptr_t *unitPtr, void *dummy_edx, int *param_3) {
+        // param_3 is the time step the unit's models advance by, the rest of Animate runs every frame
+        int step = param_3 ? AnimationStepForUnit(unitPtr, *param_3) : 0;
+        CGUnitAnimateDetour::Original(unitPtr, dummy_edx, param_3 ? &step : param_3);
     }
 
-    uint32_t
-    CGUnitShouldRenderHook(hadesmem::PatchDetourBase *detour, uintptr_t *unitPtr, void *dummy_edx, uint32_t param_1) {
-        auto const CGUnitShouldRender = detour->GetTrampolineT<CGUnitShouldRenderT>();
-        uint32_t result = CGUnitShouldRender(unitPtr, dummy_edx, param_1);
-        if (!pbEnabled) {
-            return result;
-        }
-        if (result == 1 && gPlayerUnit) {
-            if (unitPtr != gPlayerUnit) {
-                auto unitType = UnitGetType(unitPtr);
-                if (unitType == OBJECT_TYPE_PLAYER) {
-                    return shouldRenderPlayer(unitPtr);
-                } else if (unitType == OBJECT_TYPE_UNIT) {
-                    return shouldRenderUnit(unitPtr);
-                } else if (unitType == OBJECT_TYPE_CORPSE && corpseRenderDist != -1) {
-                    return shouldRenderCorpse(unitPtr);
-                }
-            }
+    // CGUnit::Animate is only detoured once PB_AnimationLodTiers has tiers
+    void initAnimateHook();
+
+    uint32_t __fastcall CGUnitShouldRenderHandler(uintptr_t *unitPtr, void *dummy_edx, uint32_t param_1);
+    using CGUnitShouldRenderDetour = StaticDetour<CGUnitShouldRenderT, &CGUnitShouldRenderHandler>;
+
+    uint32_t __fastcall CGUnitShouldRenderHandler(uintptr_t *unitPtr, void *dummy_edx, uint32_t param_1) {
+        uint32_t result = CGUnitShouldRenderDetour::Original(unitPtr, dummy_edx, param_1);
+        if (gTraceCapturing) {
+            TraceShouldRender(unitPtr, result);
         }
-        return result;
+        return shouldRenderObject(unitPtr, result);
     }
 
-    void updateFromCvar(const char *cvar, const char *value) {
-        if (strcmp(cvar, "PB_PlayerRenderDist") == 0) {
-            playerRenderDist = atoi(value);
-            DEBUG_LOG("Set PB_PlayerRenderDist to " << playerRenderDist);
-        } else if (strcmp(cvar, "PB_PlayerRenderDistInCities") == 0) {
-            playerRenderDistInCities = atoi(value);
-            DEBUG_LOG("Set PB_PlayerRenderDistInCities to " << playerRenderDistInCities);
-        } else if (strcmp(cvar, "PB_PlayerRenderDistInCombat") == 0) {
-            playerRenderDistInCombat = atoi(value);
-            DEBUG_LOG("Set PB_PlayerRenderDistInCombat to " << playerRenderDistInCombat);
-        } else if (strcmp(cvar, "PB_PetRenderDist") == 0) {
-            petRenderDist = atoi(value);
-            DEBUG_LOG("Set PB_PetRenderDist to " << petRenderDist);
-        } else if (strcmp(cvar, "PB_PetRenderDistInCombat") == 0) {
-            petRenderDistInCombat = atoi(value);
-            DEBUG_LOG("Set PB_PetRenderDistInCombat to " << petRenderDistInCombat);
-        } else if (strcmp(cvar, "PB_SummonRenderDist") == 0) {
-            summonRenderDist = atoi(value);
-            DEBUG_LOG("Set PB_SummonRenderDist to " << summonRenderDist);
-        } else if (strcmp(cvar, "PB_SummonRenderDistInCombat") == 0) {
-            summonRenderDistInCombat = atoi(value);
-            DEBUG_LOG("Set PB_SummonRenderDistInCombat to " << summonRenderDistInCombat);
-        } else if (strcmp(cvar, "PB_TrashUnitRenderDist") == 0) {
-            trashUnitRenderDist = atoi(value);
-            DEBUG_LOG("Set PB_TrashUnitRenderDist to " << trashUnitRenderDist);
-        } else if (strcmp(cvar, "PB_TrashUnitRenderDistInCombat") == 0) {
-            trashUnitRenderDistInCombat = atoi(value);
-            DEBUG_LOG("Set PB_TrashUnitRenderDistInCombat to " << trashUnitRenderDistInCombat);
-        } else if (strcmp(cvar, "PB_CorpseRenderDist") == 0) {
-            corpseRenderDist = atoi(value);
-            DEBUG_LOG("Set PB_CorpseRenderDist to " << corpseRenderDist);
-        } else if (strcmp(cvar, "PB_Enabled") == 0) {
-            pbEnabled = atoi(value) != 0;
-            DEBUG_LOG("Set PB_Enabled to " << pbEnabled);
-        } else if (strcmp(cvar, "PB_AlwaysRenderRaidMarks") == 0) {
-            alwaysRenderRaidMarks = atoi(value) != 0;
-            DEBUG_LOG("Set PB_AlwaysRenderRaidMarks to " << alwaysRenderRaidMarks);
-        } else if (strcmp(cvar, "PB_AlwaysRenderPVP") == 0) {
-            alwaysRenderPVP = atoi(value) != 0;
-            DEBUG_LOG("Set PB_AlwaysRenderPVP to " << alwaysRenderPVP);
-        } else if (strcmp(cvar, "PB_HideAllPlayers") == 0) {
-            hideAllPlayers = atoi(value) != 0;
-            DEBUG_LOG("Set PB_HideAllPlayers to " << hideAllPlayers);
-        } else if (strcmp(cvar, "PB_FilterGuidEvents") == 0) {
-            filterGuidEvents = atoi(value) != 0;
-            DEBUG_LOG("Set PB_FilterGuidEvents to " << filterGuidEvents);
-        } else if (strcmp(cvar, "PB_AlwaysRenderPlayers") == 0) {
-            parseAlwaysRenderPlayers(value);
-        } else if (strcmp(cvar, "PB_NeverRenderPlayers") == 0) {
-            parseNeverRenderPlayers(value);
-        } else if (strcmp(cvar, "PB_ShowPlayerSpellVisuals") == 0) {
-            showPlayerSpellVisuals = atoi(value) != 0;
-            DEBUG_LOG("Set PB_ShowPlayerSpellVisuals to " << showPlayerSpellVisuals);
-        } else if (strcmp(cvar, "PB_ShowPlayerGroundEffects") == 0) {
-            showPlayerGroundEffects = atoi(value) != 0;
-            DEBUG_LOG("Set PB_ShowPlayerGroundEffects to " << showPlayerGroundEffects);
-        } else if (strcmp(cvar, "PB_ShowPlayerAuraVisuals") == 0) {
-            showPlayerAuraVisuals = atoi(value) != 0;
-            DEBUG_LOG("Set PB_ShowPlayerAuraVisuals to " << showPlayerAuraVisuals);
-        } else if (strcmp(cvar, "PB_ShowUnitAuraVisuals") == 0) {
-            showUnitAuraVisuals = atoi(value) != 0;
-            DEBUG_LOG("Set PB_ShowUnitAuraVisuals to " << showUnitAuraVisuals);
-        } else if (strcmp(cvar, "PB_HideSpellsForHiddenPlayers") == 0) {
-            hideSpellsForHiddenPlayers = atoi(value) != 0;
-            DEBUG_LOG("Set PB_HideSpellsForHiddenPlayers to " << hideSpellsForHiddenPlayers);
-        } else if (strcmp(cvar, "PB_ApplyHiddenSpellIdsToMe") == 0) {
-            applyHiddenSpellIdsToMe = atoi(value) != 0;
-            DEBUG_LOG("Set PB_ApplyHiddenSpellIdsToMe to " << applyHiddenSpellIdsToMe);
-        } else if (strcmp(cvar, "PB_HiddenSpellIds") == 0) {
-            hiddenSpellIdsString = value;
-            parseHiddenSpellIds(hiddenSpellIdsString);
-            DEBUG_LOG("Set PB_HiddenSpellIds to " << hiddenSpellIdsString << " (parsed " << hiddenSpellIds.size()
-                                                  << " spell IDs)");
-        } else if (strcmp(cvar, "PB_AlwaysShownSpellIds") == 0) {
-            alwaysShownSpellIdsString = value;
-            parseAlwaysShownSpellIds(alwaysShownSpellIdsString);
-            DEBUG_LOG("Set PB_AlwaysShownSpellIds to " << alwaysShownSpellIdsString << " (parsed "
-                                                       << alwaysShownSpellIds.size()
-                                                       << " spell IDs)");
+    uint32_t __fastcall CGCorpseShouldRenderHandler(uintptr_t *corpsePtr, void *dummy_edx, uint32_t param_1);
+    using CGCorpseShouldRenderDetour = StaticDetour<CGCorpseShouldRenderT, &CGCorpseShouldRenderHandler>;
+
+    uint32_t __fastcall CGCorpseShouldRenderHandler(uintptr_t *corpsePtr, void *dummy_edx, uint32_t param_1) {
+        uint32_t result = CGCorpseShouldRenderDetour::Original(corpsePtr, dummy_edx, param_1);
+        if (gTraceCapturing) {
+            TraceShouldRender(corpsePtr, result);
         }
+        return shouldRenderObject(corpsePtr, result);
     }
 
     int Script_SetCVarHook(hadesmem::PatchDetourBase *detour, uintptr_t *luaPtr) {
@@ -1121,6 +307,9 @@ namespace perf_boost {
             // if cvar starts with "PB_", then we need to handle it
             if (strncmp(cVarName, "PB_", 3) == 0) {
                 updateFromCvar(cVarName, cVarValue);
+                if (strcmp(cVarName, "PB_AnimationLodTiers") == 0) {
+                    initAnimateHook();
+                }
             }
         } // original function handles errors
 
@@ -1153,7 +342,9 @@ namespace perf_boost {
     void loadUserVar(const char *cvar) {
         // Handle string cvars specially
         if (strcmp(cvar, "PB_AlwaysRenderPlayers") == 0 || strcmp(cvar, "PB_NeverRenderPlayers") == 0 ||
-            strcmp(cvar, "PB_HiddenSpellIds") == 0) {
+            strcmp(cvar, "PB_HiddenSpellIds") == 0 || strcmp(cvar, "PB_TrashCreatureIds") == 0 ||
+            strcmp(cvar, "PB_BossCreatureIds") == 0 || strcmp(cvar, "PB_ThrottledFrames") == 0 ||
+            strcmp(cvar, "PB_ZoneContexts") == 0 || strcmp(cvar, "PB_AnimationLodTiers") == 0) {
             char *stringValue = getCvarString(cvar);
             if (stringValue) {
                 updateFromCvar(cvar, stringValue);
@@ -1172,13 +363,60 @@ namespace perf_boost {
         }
     }
 
-    // Template function to simplify hook initialization with dynamic storage
+    // Template function to simplify hook initialization with dynamic storage, returns the applied detour
     template<typename FuncT, typename HookT>
-    void initializeHook(const hadesmem::Process &process, Offsets offset, HookT hookFunc) {
+    hadesmem::PatchDetourBase *initializeHook(const hadesmem::Process &process, Offsets offset, HookT hookFunc) {
         auto const originalFunc = hadesmem::detail::AliasCast<FuncT>(offset);
         auto detour = std::make_unique<hadesmem::PatchDetour<FuncT>>(process, originalFunc, hookFunc);
         detour->Apply();
         gDetours.push_back(std::move(detour));
+        return gDetours.back().get();
+    }
+
+    // detour.hpp for the hottest hooks, still goes through hadesmem if the function's start can't be relocated
+    template<typename DetourT>
+    void initializeStaticHook(const hadesmem::Process &process, Offsets offset) {
+        if (DetourT::Install(static_cast<uintptr_t>(offset))) {
+            return;
+        }
+
+        auto *detour = initializeHook<typename DetourT::FuncT>(process, offset, &DetourT::Fallback);
+        DetourT::Original = detour->template GetTrampolineT<typename DetourT::FuncT>();
+    }
+
+    void initAnimateHook() {
+        if (gAnimateHookInstalled || animationLodTiers.empty()) {
+            return;
+        }
+
+        const hadesmem::Process process(::GetCurrentProcessId());
+        initializeStaticHook<CGUnitAnimateDetour>(process, Offsets::CGUnitAnimate);
+        gAnimateHookInstalled = true;
+    }
+
+    bool patchCallSite(CallSite &site, uint32_t handler) {
+        site.handler = handler;
+
+        auto code = reinterpret_cast<uint8_t *>(site.address);
+        DWORD oldProtect;
+        if (!VirtualProtect(code, kCallRel32Size, PAGE_EXECUTE_READWRITE, &oldProtect)) {
+            DEBUG_LOG("Unable to make call site " << site.name << " writable");
+            return false;
+        }
+        bool patched = PatchCallSite(site, code);
+        VirtualProtect(code, kCallRel32Size, oldProtect, &oldProtect);
+        FlushInstructionCache(GetCurrentProcess(), code, kCallRel32Size);
+        return patched;
+    }
+
+    // log every call site and whether the code still matches what we think we did to it
+    void verifyCallSites() {
+        for (const auto &site: gCallSites) {
+            auto code = reinterpret_cast<const uint8_t *>(site.address);
+            DEBUG_LOG("Call site " << site.name << " at 0x" << std::hex << site.address << std::dec << ": "
+                                   << CallSiteStatusName(site.status)
+                                   << (VerifyCallSite(site, code) ? "" : ", code changed"));
+        }
     }
 
     void initHooks() {
@@ -1187,21 +425,28 @@ namespace perf_boost {
         initializeHook<FastcallFrameT>(process, Offsets::OnWorldRender, &OnWorldRenderHook);
         initializeHook<SetCVarT>(process, Offsets::Script_SetCVar, &Script_SetCVarHook);
 
-        // Hook CGUnit functions
+        // Hook CGUnit and CGCorpse functions
 //        initializeHook<CGUnitPreAnimateT>(process, Offsets::CGUnitPreAnimate, &CGUnitPreAnimateHook);
-//        initializeHook<CGUnitAnimateT>(process, Offsets::CGUnitAnimate, &CGUnitAnimateHook);
-        initializeHook<CGUnitShouldRenderT>(process, Offsets::CGUnitShouldRender, &CGUnitShouldRenderHook);
+        initializeStaticHook<CGUnitShouldRenderDetour>(process, Offsets::CGUnitShouldRender);
+        initializeStaticHook<CGCorpseShouldRenderDetour>(process, Offsets::CGCorpseShouldRender);
+        initializeHook<ObjectFreeT>(process, Offsets::ObjectFree, &ObjectFreeHook);
 
-        // Hook CGUnitPlaySpellVisual
-        initializeHook<CGUnitPlaySpellVisualT>(process, Offsets::CGUnitPlaySpellVisual, &CGUnitPlaySpellVisualHook);
+        // Filter aura visuals at their call site, detour CGUnitPlaySpellVisual and check the return address if the
+        // call isn't where we expect it
+        if (!patchCallSite(gCallSites[0], reinterpret_cast<uint32_t>(&AuraVisualCallSiteHandler))) {
+            initializeHook<CGUnitPlaySpellVisualT>(process, Offsets::CGUnitPlaySpellVisual, &CGUnitPlaySpellVisualHook);
+        }
 
         // Hook CGUnitPlayChannelVisual
         initializeHook<CGUnitPlayChannelVisualT>(process, Offsets::CGUnitPlayChannelVisual,
                                                  &CGUnitPlayChannelVisualHook);
 
         // Hook CGUnitGetAppropriateSpellVisual
-        initializeHook<CGUnitGetAppropriateSpellVisualT>(process, Offsets::CGUnitGetAppropriateSpellVisual,
-                                                         &CGUnitGetAppropriateSpellVisualHook);
+        auto *spellVisualDetour = initializeHook<CGUnitGetAppropriateSpellVisualT>(
+                process, Offsets::CGUnitGetAppropriateSpellVisual, &CGUnitGetAppropriateSpellVisualHook);
+        // GetMissileTargetLocation calls the original code directly
+        gMissileCallSitePatched = patchCallSite(gCallSites[1],
+                                                reinterpret_cast<uint32_t>(spellVisualDetour->GetTrampoline()));
 
         // Hook CGDynamicObjectGetVisualEffectNameRec
         initializeHook<CGDynamicObjectGetVisualEffectNameRecT>(process, Offsets::CGDynamicObjectGetVisualEffectNameRec,
@@ -1215,6 +460,9 @@ namespace perf_boost {
 
         // Hook SendUnitSignal
         initializeHook<SendUnitSignalT>(process, Offsets::SendUnitSignal, &SendUnitSignalHook);
+
+        initAnimateHook();
+        verifyCallSites();
     }
 
     void loadConfig() {
@@ -1502,6 +750,17 @@ namespace perf_boost {
                      0,  // unk2
                      0); // unk3
 
+        // Draw one copy of identical ground effects stacked on the same spot
+        char PB_DedupGroundEffects[] = "PB_DedupGroundEffects";
+        CVarRegister(PB_DedupGroundEffects, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultDisabled, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
         // Comma separated list of spell IDs to hide visuals for
         char PB_HiddenSpellIds[] = "PB_HiddenSpellIds";
         CVarRegister(PB_HiddenSpellIds, // name
@@ -1524,6 +783,194 @@ namespace perf_boost {
                      0,  // unk2
                      0); // unk3
 
+        // Comma separated creature IDs always culled as trash / never culled
+        char PB_TrashCreatureIds[] = "PB_TrashCreatureIds";
+        CVarRegister(PB_TrashCreatureIds, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultEmpty, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        char PB_BossCreatureIds[] = "PB_BossCreatureIds";
+        CVarRegister(PB_BossCreatureIds, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultEmpty, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // Units that aren't world bosses count as bosses with at least this much max health per raid member
+        char defaultBossHealthPerPlayer[] = "10000";
+        char PB_BossHealthPerPlayer[] = "PB_BossHealthPerPlayer";
+        CVarRegister(PB_BossHealthPerPlayer, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultBossHealthPerPlayer, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // Comma separated global frame names whose OnUpdate handlers get throttled
+        char PB_ThrottledFrames[] = "PB_ThrottledFrames";
+        CVarRegister(PB_ThrottledFrames, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultEmpty, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // OnUpdate runs per second for PB_ThrottledFrames, 0 only measures them
+        char defaultThrottledFrameRate[] = "20";
+        char PB_ThrottledFrameRate[] = "PB_ThrottledFrameRate";
+        CVarRegister(PB_ThrottledFrameRate, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultThrottledFrameRate, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // areaId:context list, e.g. 3456:raid,1519:outdoor, extending the built in zone classification
+        char PB_ZoneContexts[] = "PB_ZoneContexts";
+        CVarRegister(PB_ZoneContexts, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultEmpty, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // distance:interval list, e.g. 40:2,80:4 animates units past 40 yards every 2nd frame
+        char PB_AnimationLodTiers[] = "PB_AnimationLodTiers";
+        CVarRegister(PB_AnimationLodTiers, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultEmpty, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // Incoming KB/s and latency ms from GetNetStats() that count as congested, 0 ignores them
+        char PB_NetCongestionBandwidth[] = "PB_NetCongestionBandwidth";
+        CVarRegister(PB_NetCongestionBandwidth, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultDisabled, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        char PB_NetCongestionLatency[] = "PB_NetCongestionLatency";
+        CVarRegister(PB_NetCongestionLatency, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultDisabled, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // Render distances are scaled to this percentage while congested
+        char defaultNetCongestionRenderPercent[] = "75";
+        char PB_NetCongestionRenderPercent[] = "PB_NetCongestionRenderPercent";
+        CVarRegister(PB_NetCongestionRenderPercent, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultNetCongestionRenderPercent, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // Most units drawn per frame, the most important ones win
+        char PB_UnitBudget[] = "PB_UnitBudget";
+        CVarRegister(PB_UnitBudget, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultDisabled, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // Most corpses drawn per frame, the nearest ones and your own
+        char PB_CorpseBudget[] = "PB_CorpseBudget";
+        CVarRegister(PB_CorpseBudget, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultDisabled, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // Most frames a unit's render answer is reused while it is far from its cull distance
+        char PB_RenderRecheckFrames[] = "PB_RenderRecheckFrames";
+        CVarRegister(PB_RenderRecheckFrames, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultDisabled, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // Cull by distance from the camera and hide culled units behind it
+        char PB_CameraRelativeCulling[] = "PB_CameraRelativeCulling";
+        CVarRegister(PB_CameraRelativeCulling, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultDisabled, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // Full angle of the cone around the camera's view direction that is kept, 0 for no cone
+        char defaultCameraCullAngle[] = "140";
+        char PB_CameraCullAngle[] = "PB_CameraCullAngle";
+        CVarRegister(PB_CameraCullAngle, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultCameraCullAngle, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // Log which addon OnEvent handlers cost the most
+        char PB_MeasureEvents[] = "PB_MeasureEvents";
+        CVarRegister(PB_MeasureEvents, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultDisabled, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
+
+        // Record a trace of this session for perf_boost_replay, not loaded on startup
+        char PB_CaptureTrace[] = "PB_CaptureTrace";
+        CVarRegister(PB_CaptureTrace, // name
+                     nullptr, // help
+                     0,  // unk1
+                     defaultDisabled, // default value address
+                     nullptr, // callback
+                     5, // category
+                     0,  // unk2
+                     0); // unk3
 
         loadUserVar("PB_PlayerRenderDist");
         loadUserVar("PB_PlayerRenderDistInCities");
@@ -1548,8 +995,25 @@ namespace perf_boost {
         loadUserVar("PB_ShowUnitAuraVisuals");
         loadUserVar("PB_HideSpellsForHiddenPlayers");
         loadUserVar("PB_ApplyHiddenSpellIdsToMe");
+        loadUserVar("PB_DedupGroundEffects");
         loadUserVar("PB_HiddenSpellIds");
         loadUserVar("PB_AlwaysShownSpellIds");
+        loadUserVar("PB_TrashCreatureIds");
+        loadUserVar("PB_BossCreatureIds");
+        loadUserVar("PB_BossHealthPerPlayer");
+        loadUserVar("PB_ThrottledFrames");
+        loadUserVar("PB_ThrottledFrameRate");
+        loadUserVar("PB_MeasureEvents");
+        loadUserVar("PB_ZoneContexts");
+        loadUserVar("PB_AnimationLodTiers");
+        loadUserVar("PB_NetCongestionBandwidth");
+        loadUserVar("PB_NetCongestionLatency");
+        loadUserVar("PB_NetCongestionRenderPercent");
+        loadUserVar("PB_UnitBudget");
+        loadUserVar("PB_CorpseBudget");
+        loadUserVar("PB_RenderRecheckFrames");
+        loadUserVar("PB_CameraRelativeCulling");
+        loadUserVar("PB_CameraCullAngle");
     }
 
     void SpellVisualsInitializeHook(hadesmem::PatchDetourBase *detour) {
@@ -0,0 +1,129 @@
+#include "net_stats.hpp"
+#include "logging.hpp"
+#include "settings.hpp"
+#include "stats.hpp"
+
+#include <cmath>
+#include <unordered_map>
+
+namespace perf_boost {
+    namespace {
+        const uint64_t kCongestionHoldMs = 3000;
+        // samples arrive 4 times a second while a threshold is set, a sample older than this no longer counts
+        const uint64_t kSampleTimeoutMs = 1000;
+        const uint64_t kCorrelationLogIntervalMs = 60000;
+
+        bool congested = false;
+        bool overThreshold = false;
+        uint64_t lastOverThresholdMs = 0;
+        uint64_t lastSampleMs = 0;
+        uint64_t nowMs = 0;
+
+        std::unordered_map<uint64_t, bool> frozenDecisions;
+
+        // running sums for the correlation between incoming bandwidth and frame time
+        struct Correlation {
+            double n = 0, x = 0, y = 0, xy = 0, xx = 0, yy = 0;
+            double congestedFrameMs = 0, congestedSamples = 0;
+        } correlation;
+        uint64_t lastCorrelationLogMs = 0;
+
+        void LogCorrelation() {
+            auto &c = correlation;
+            if (c.n < 2) {
+                return;
+            }
+
+            auto covariance = c.n * c.xy - c.x * c.y;
+            auto variance = (c.n * c.xx - c.x * c.x) * (c.n * c.yy - c.y * c.y);
+            auto r = variance > 0 ? covariance / std::sqrt(variance) : 0.0;
+            DEBUG_LOG("Net stats: " << c.n << " samples, " << c.x / c.n << " KB/s in, " << c.y / c.n
+                                    << " ms per frame, correlation " << r << ", "
+                                    << (c.congestedSamples > 0 ? c.congestedFrameMs / c.congestedSamples : 0.0)
+                                    << " ms per frame while congested");
+        }
+    }
+
+    void RecordNetStats(float bandwidthIn, float latencyMs) {
+        lastSampleMs = nowMs;
+        overThreshold = (netCongestionBandwidth > 0 && bandwidthIn > netCongestionBandwidth) ||
+                        (netCongestionLatency > 0 && latencyMs > netCongestionLatency);
+        if (overThreshold) {
+            lastOverThresholdMs = nowMs;
+        }
+
+        double frameMs = GetRuntimeStats().averageFrameMs;
+        auto &c = correlation;
+        c.n += 1;
+        c.x += bandwidthIn;
+        c.y += frameMs;
+        c.xy += bandwidthIn * frameMs;
+        c.xx += static_cast<double>(bandwidthIn) * bandwidthIn;
+        c.yy += frameMs * frameMs;
+        if (overThreshold) {
+            c.congestedFrameMs += frameMs;
+            c.congestedSamples += 1;
+        }
+    }
+
+    bool NetCongested() {
+        return congested;
+    }
+
+    void UpdateNetCongestion(uint64_t timeMs) {
+        nowMs = timeMs;
+
+        if (netCongestionBandwidth <= 0 && netCongestionLatency <= 0) {
+            // sampling stops with the thresholds, nothing would clear a sample that was over
+            overThreshold = false;
+            lastOverThresholdMs = 0;
+        } else if (overThreshold && nowMs - lastSampleMs >= kSampleTimeoutMs) {
+            overThreshold = false;
+        }
+
+        bool wasCongested = congested;
+        congested = overThreshold || (lastOverThresholdMs != 0 && nowMs - lastOverThresholdMs < kCongestionHoldMs);
+        if (congested && !wasCongested) {
+            // keep what was decided for the last complete frame
+            frozenDecisions.clear();
+            CopyPreviousRenderDecisions(frozenDecisions);
+            DEBUG_LOG("Network congested, freezing " << frozenDecisions.size() << " render decisions");
+        } else if (!congested && wasCongested) {
+            frozenDecisions.clear();
+            DEBUG_LOG("Network congestion over");
+        }
+
+        if (nowMs - lastCorrelationLogMs >= kCorrelationLogIntervalMs) {
+            if (lastCorrelationLogMs != 0) {
+                LogCorrelation();
+            }
+            correlation = Correlation();
+            lastCorrelationLogMs = nowMs;
+        }
+    }
+
+    int FrozenRenderDecision(uint64_t guid) {
+        if (!congested) {
+            return -1;
+        }
+        auto it = frozenDecisions.find(guid);
+        return it == frozenDecisions.end() ? -1 : (it->second ? 1 : 0);
+    }
+
+    void FreezeRenderDecision(uint64_t guid, bool rendered) {
+        if (congested) {
+            frozenDecisions[guid] = rendered;
+        }
+    }
+
+    void ResetNetStats() {
+        congested = false;
+        overThreshold = false;
+        lastOverThresholdMs = 0;
+        lastSampleMs = 0;
+        nowMs = 0;
+        frozenDecisions.clear();
+        correlation = Correlation();
+        lastCorrelationLogMs = 0;
+    }
+}
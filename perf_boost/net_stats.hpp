@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+namespace perf_boost {
+    // Network congestion mode.  The client samples GetNetStats() a few times a second.  While incoming bandwidth or
+    // latency is over PB_NetCongestionBandwidth / PB_NetCongestionLatency, and for a few seconds after, render
+    // distances are scaled by PB_NetCongestionRenderPercent for units that weren't already decided, and units keep
+    // the render answer they had when congestion began so the burst of position updates doesn't churn models.
+
+    // incoming kilobytes per second and milliseconds, as returned by GetNetStats()
+    void RecordNetStats(float bandwidthIn, float latencyMs);
+
+    bool NetCongested();
+
+    // once per frame from BeginFrame, ends congestion after the hold time and logs how net stats and frame time
+    // correlate once a minute.  Congestion also ends when both thresholds are turned off or samples stop arriving
+    void UpdateNetCongestion(uint64_t nowMs);
+
+    // 1 or 0 for units decided before or during congestion, -1 otherwise
+    int FrozenRenderDecision(uint64_t guid);
+    void FreezeRenderDecision(uint64_t guid, bool rendered);
+
+    void ResetNetStats();
+}
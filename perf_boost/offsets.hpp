@@ -36,6 +36,7 @@ enum class Offsets : std::uint32_t {
 
     ClntObjMgrObjectPtr = 0x00468460,
     GetObjectPtr = 0x464870,
+    WorldFrame = 0x00B4B2BC,     // CGWorldFrame *, active camera at +0x65B8
     GetActivePlayer = 0x468550,
     GetUnitFromName = 0x00515940,
     GetGUIDFromName = 0x00515970,
@@ -65,6 +66,8 @@ enum class Offsets : std::uint32_t {
     lua_getcontext = 0x007040D0,
     lua_getgccount = 0x006f43f0,
 
+    FrameScript_RegisterFunction = 0x00704120,
+
     CM2ModelAnimateMT = 0x00714260,
     CM2ModelSetAnimating = 0X00710B90,
     ObjectFree = 0X00463B00,
@@ -83,6 +86,10 @@ enum class Offsets : std::uint32_t {
 
     CGCorpseShouldRender = 0x005d67e0,
 
+    // call instructions redirected by call_site.hpp, each the return address the hooks used to compare minus 5
+    AuraVisualCallSite = 0x005FF4C6,            // CGUnitPlaySpellVisual for aura visuals
+    MissileSpellVisualCallSite = 0x006EC807,    // CGUnitGetAppropriateSpellVisual in GetMissileTargetLocation
+
     CGUnitGetPosition = 0x5f1f10,
 
     CVarLookup = 0x0063DEC0,
@@ -94,6 +101,7 @@ enum class Offsets : std::uint32_t {
     SignalEventParam = 0x703F50,
 
     RealZoneText = 0X0B4B404,
+    RaidTargetGuids = 0xb71368,
     ZoneAreaIds = 0X0B4E314,
 
     CGDynamicObjectGetVisualEffectNameRec = 0x005d57c0,
@@ -0,0 +1,603 @@
+#include "render.hpp"
+#include "creatures.hpp"
+#include "distance.hpp"
+#include "game_objects.hpp"
+#include "game_view.hpp"
+#include "importance.hpp"
+#include "logging.hpp"
+#include "net_stats.hpp"
+#include "render_schedule.hpp"
+#include "settings.hpp"
+#include "stats.hpp"
+#include "unit_cache.hpp"
+#include "units.hpp"
+#include "zone_context.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace perf_boost {
+    uintptr_t *gPlayerUnit = nullptr;
+    C3Vector gPlayerPosition = {0.0f, 0.0f, 0.0f};
+    bool gPlayerInCombat = false;
+    bool gPlayerInCity = false;
+    uint64_t gPlayerGuid = 0;
+    uint64_t gFrameTimeMs = 0;
+    uint32_t gFrameIndex = 0;
+
+    bool gViewFromCamera = false;
+    C3Vector gViewPosition = {0.0f, 0.0f, 0.0f};
+    C3Vector gViewForward = {0.0f, 0.0f, 0.0f};
+
+    float gRenderDistSq[RENDER_CATEGORY_COUNT];
+    float gGameObjectRenderDistSq[GAMEOBJECT_TYPE_MAX];
+    namespace {
+        uint32_t renderDistSettingsVersion = ~0u;
+        bool renderDistInCombat = false;
+        bool renderDistInCity = false;
+        bool renderDistCongested = false;
+
+        // marked guids sorted for lookup, only the first raidMarkCount are valid
+        struct RaidMark {
+            uint64_t guid;
+            int mark;
+        };
+        RaidMark raidMarks[8];
+        int raidMarkCount = 0;
+
+        // cos(half the cone angle) times its own absolute value so it compares against a signed squared dot product
+        bool viewCone = false;
+        float viewConeCosSq = 0.0f;
+
+        // yards between the unit being decided and the nearest cull boundary that decided it, for render_schedule
+        float boundaryMargin = 0.0f;
+
+        void NoteBoundaryMargin(float distanceSq, float renderDistSq) {
+            float margin;
+            if (viewCone) {
+                // turning the camera moves every boundary
+                margin = 0.0f;
+            } else if (std::isinf(renderDistSq) || renderDistSq <= 0.0f) {
+                return;
+            } else {
+                margin = std::fabs(std::sqrt(distanceSq) - std::sqrt(renderDistSq));
+            }
+            boundaryMargin = std::min(boundaryMargin, margin);
+        }
+
+        bool InViewCone(const C3Vector &position, float distanceSq) {
+            float dot = (position.x - gViewPosition.x) * gViewForward.x +
+                        (position.y - gViewPosition.y) * gViewForward.y +
+                        (position.z - gViewPosition.z) * gViewForward.z;
+            return dot * std::fabs(dot) >= viewConeCosSq * distanceSq;
+        }
+
+        float ToRenderDistSq(int renderDist) {
+            if (renderDist < 0) {
+                return std::numeric_limits<float>::infinity();
+            }
+            return static_cast<float>(renderDist) * static_cast<float>(renderDist);
+        }
+
+        int PickRenderDist(int combatDist, int dist) {
+            return (gPlayerInCombat && combatDist != -1) ? combatDist : dist;
+        }
+
+        bool WithinUnitBudget(uintptr_t *unitPtr, uint64_t guid, OBJECT_TYPE_ID unitType) {
+            // bosses always render
+            if (unitType == OBJECT_TYPE_UNIT && GetUnitClass(unitPtr, guid).unitClass == UNIT_CLASS_BOSS) {
+                return true;
+            }
+
+            auto distanceSq = SquaredDistanceBetween(UnitGetPosition(unitPtr),
+                                                     gViewFromCamera ? gViewPosition : gPlayerPosition);
+            return AdmitToBudget(RENDER_BUDGET_UNITS, guid,
+                                 ImportanceScore(ImportanceFlags(unitPtr, guid), distanceSq));
+        }
+
+        bool WithinCorpseBudget(uintptr_t *unitPtr, uint64_t guid, OBJECT_TYPE_ID unitType) {
+            // the player's own corpse always renders
+            if (unitType == OBJECT_TYPE_CORPSE && gPlayerGuid != 0 && CorpseGetOwnerGuid(unitPtr) == gPlayerGuid) {
+                return true;
+            }
+
+            auto distanceSq = SquaredDistanceBetween(UnitGetPosition(unitPtr),
+                                                     gViewFromCamera ? gViewPosition : gPlayerPosition);
+            return AdmitToBudget(RENDER_BUDGET_CORPSES, guid, ImportanceScore(0, distanceSq));
+        }
+
+        // corpses and dead units share PB_CorpseBudget, living players and units PB_UnitBudget
+        bool WithinRenderBudgets(uintptr_t *unitPtr, uint64_t guid, OBJECT_TYPE_ID unitType) {
+            if (unitType == OBJECT_TYPE_CORPSE || (unitType == OBJECT_TYPE_UNIT && UnitIsDead(unitPtr))) {
+                return corpseBudget <= 0 || WithinCorpseBudget(unitPtr, guid, unitType);
+            }
+            if (unitType == OBJECT_TYPE_PLAYER || unitType == OBJECT_TYPE_UNIT) {
+                return unitBudget <= 0 || WithinUnitBudget(unitPtr, guid, unitType);
+            }
+            return true;
+        }
+
+        uint32_t DecideRender(uintptr_t *unitPtr, OBJECT_TYPE_ID unitType, uint32_t clientResult) {
+            if (unitType == OBJECT_TYPE_PLAYER) {
+                return shouldRenderPlayer(unitPtr);
+            } else if (unitType == OBJECT_TYPE_UNIT) {
+                return shouldRenderUnit(unitPtr);
+            } else if (unitType == OBJECT_TYPE_CORPSE && corpseRenderDist != -1) {
+                return shouldRenderCorpse(unitPtr);
+            } else if (unitType == OBJECT_TYPE_GAMEOBJECT && !gameObjectRenderDistsString.empty()) {
+                return shouldRenderGameObject(unitPtr);
+            }
+            return clientResult;
+        }
+
+        // reuses the unit's last answer until render_schedule says it is due
+        uint32_t ScheduledDecideRender(uintptr_t *unitPtr, uint64_t guid, OBJECT_TYPE_ID unitType,
+                                       uint32_t clientResult) {
+            if (renderRecheckFrames <= 1) {
+                return DecideRender(unitPtr, unitType, clientResult);
+            }
+
+            auto position = UnitGetPosition(unitPtr);
+            auto scheduled = ScheduledRenderDecision(guid, position);
+            CountRenderRecheck(scheduled < 0);
+            if (scheduled >= 0) {
+                return static_cast<uint32_t>(scheduled);
+            }
+
+            boundaryMargin = std::numeric_limits<float>::infinity();
+            auto result = DecideRender(unitPtr, unitType, clientResult);
+            ScheduleRenderDecision(guid, position, result != 0, boundaryMargin);
+            return result;
+        }
+    }
+
+    void SnapshotRaidMarks() {
+        auto const raidTargets = GetRaidTargetGuids();
+        RaidMark previousMarks[8];
+        int previousCount = raidMarkCount;
+        std::copy(raidMarks, raidMarks + raidMarkCount, previousMarks);
+
+        raidMarkCount = 0;
+        for (int mark = 1; mark <= 8; ++mark) {
+            if (raidTargets[mark - 1] != 0) {
+                raidMarks[raidMarkCount++] = {raidTargets[mark - 1], mark};
+            }
+        }
+        // at most 8, an insertion sort is all it takes
+        for (int i = 1; i < raidMarkCount; ++i) {
+            auto raidMark = raidMarks[i];
+            int j = i;
+            for (; j > 0 && raidMarks[j - 1].guid > raidMark.guid; --j) {
+                raidMarks[j] = raidMarks[j - 1];
+            }
+            raidMarks[j] = raidMark;
+        }
+
+        if (raidMarkCount != previousCount ||
+            !std::equal(raidMarks, raidMarks + raidMarkCount, previousMarks, [](const RaidMark &a, const RaidMark &b) {
+                return a.guid == b.guid && a.mark == b.mark;
+            })) {
+            InvalidateRenderSchedule();
+        }
+    }
+
+    int GetRaidMarkForGuid(uint64_t targetGUID) {
+        // usually nothing is marked outside of raids
+        if (targetGUID == 0 || raidMarkCount == 0) {
+            return -1;
+        }
+
+        auto end = raidMarks + raidMarkCount;
+        auto it = std::lower_bound(raidMarks, end, targetGUID, [](const RaidMark &a, uint64_t guid) {
+            return a.guid < guid;
+        });
+        return it != end && it->guid == targetGUID ? it->mark : -1;
+    }
+
+    bool shouldAlwaysRenderPlayer(uintptr_t *unitPtr, uint64_t unitGuid) {
+        // Check resolved players first (fastest lookup)
+        for (const auto &player: resolvedPlayers) {
+            if (player.guid == unitGuid) {
+                return true;
+            }
+        }
+
+        // Check alwaysRenderPlayersToCheck and try to resolve them
+        if (!alwaysRenderPlayersToCheck.empty()) {
+            char *unitName = UnitGetName(unitPtr);
+            if (unitName) {
+                auto it = alwaysRenderPlayersToCheck.begin();
+                while (it != alwaysRenderPlayersToCheck.end()) {
+                    if (strcmp(it->name, unitName) == 0) {
+                        // Found match, move to resolved players
+                        PlayerData resolvedPlayer = *it;
+                        resolvedPlayer.guid = unitGuid;
+                        resolvedPlayer.resolved = true;
+                        resolvedPlayers.push_back(resolvedPlayer);
+
+                        // Remove from alwaysRenderPlayersToCheck and unresolvedPlayers
+                        alwaysRenderPlayersToCheck.erase(it);
+                        auto unresolvedIt = std::find_if(unresolvedPlayers.begin(), unresolvedPlayers.end(),
+                                                         [&](const PlayerData &p) {
+                                                             return strcmp(p.name, unitName) == 0;
+                                                         });
+                        if (unresolvedIt != unresolvedPlayers.end()) {
+                            unresolvedPlayers.erase(unresolvedIt);
+                        }
+
+                        DEBUG_LOG("Resolved player " << unitName << " with GUID: " << std::hex << unitGuid);
+                        return true;
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool shouldNeverRenderPlayer(uintptr_t *unitPtr, uint64_t unitGuid) {
+        // Check resolved players first (fastest lookup)
+        for (const auto &player: neverRenderResolvedPlayers) {
+            if (player.guid == unitGuid) {
+                return true; // Found in blacklist, never render
+            }
+        }
+
+        // Check neverRenderPlayersToCheck and try to resolve them
+        if (!neverRenderPlayersToCheck.empty()) {
+            char *unitName = UnitGetName(unitPtr);
+            if (unitName) {
+                auto it = neverRenderPlayersToCheck.begin();
+                while (it != neverRenderPlayersToCheck.end()) {
+                    if (strcmp(it->name, unitName) == 0) {
+                        // Found match, move to resolved players
+                        PlayerData resolvedPlayer = *it;
+                        resolvedPlayer.guid = unitGuid;
+                        resolvedPlayer.resolved = true;
+                        neverRenderResolvedPlayers.push_back(resolvedPlayer);
+
+                        // Remove from neverRenderPlayersToCheck and neverRenderUnresolvedPlayers
+                        neverRenderPlayersToCheck.erase(it);
+                        auto unresolvedIt = std::find_if(neverRenderUnresolvedPlayers.begin(),
+                                                         neverRenderUnresolvedPlayers.end(),
+                                                         [&](const PlayerData &p) {
+                                                             return strcmp(p.name, unitName) == 0;
+                                                         });
+                        if (unresolvedIt != neverRenderUnresolvedPlayers.end()) {
+                            neverRenderUnresolvedPlayers.erase(unresolvedIt);
+                        }
+
+                        DEBUG_LOG(
+                                "Resolved never-render player " << unitName << " with GUID: " << std::hex << unitGuid);
+                        return true; // Found in blacklist, never render
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+        }
+
+        return false; // Not in blacklist, allow rendering
+    }
+
+    void UpdateView() {
+        gViewFromCamera = false;
+        viewCone = false;
+
+        C3Vector position;
+        C3Vector forward;
+        if (!cameraRelativeCulling || !GetActiveCamera(position, forward)) {
+            return;
+        }
+
+        gViewFromCamera = true;
+        gViewPosition = position;
+        float length = std::sqrt(forward.x * forward.x + forward.y * forward.y + forward.z * forward.z);
+        if (length <= 0.0f) {
+            return;
+        }
+        gViewForward.x = forward.x / length;
+        gViewForward.y = forward.y / length;
+        gViewForward.z = forward.z / length;
+
+        if (cameraCullAngle <= 0 || cameraCullAngle >= 360) {
+            return;
+        }
+        float cosHalfAngle = std::cos(static_cast<float>(cameraCullAngle) * 0.5f * 3.14159265f / 180.0f);
+        viewConeCosSq = cosHalfAngle * std::fabs(cosHalfAngle);
+        viewCone = true;
+    }
+
+    void ResolveRenderDistances() {
+        float previousDistSq[RENDER_CATEGORY_COUNT];
+        float previousGameObjectDistSq[GAMEOBJECT_TYPE_MAX];
+        std::memcpy(previousDistSq, gRenderDistSq, sizeof(gRenderDistSq));
+        std::memcpy(previousGameObjectDistSq, gGameObjectRenderDistSq, sizeof(gGameObjectRenderDistSq));
+
+        int playerDist;
+        if (gPlayerInCombat && playerRenderDistInCombat != -1) {
+            playerDist = playerRenderDistInCombat;
+        } else if (gPlayerInCity && playerRenderDistInCities != -1) {
+            playerDist = playerRenderDistInCities;
+        } else {
+            playerDist = playerRenderDist;
+        }
+
+        gRenderDistSq[RENDER_CATEGORY_PLAYER] = ToRenderDistSq(playerDist);
+        gRenderDistSq[RENDER_CATEGORY_PET] = ToRenderDistSq(PickRenderDist(petRenderDistInCombat, petRenderDist));
+        gRenderDistSq[RENDER_CATEGORY_SUMMON] = ToRenderDistSq(
+                PickRenderDist(summonRenderDistInCombat, summonRenderDist));
+        gRenderDistSq[RENDER_CATEGORY_TRASH] = ToRenderDistSq(
+                PickRenderDist(trashUnitRenderDistInCombat, trashUnitRenderDist));
+        gRenderDistSq[RENDER_CATEGORY_CORPSE] = ToRenderDistSq(corpseRenderDist);
+        for (int type = 0; type < GAMEOBJECT_TYPE_MAX; ++type) {
+            gGameObjectRenderDistSq[type] = ToRenderDistSq(gameObjectRenderDists[type]);
+        }
+
+        if (NetCongested() && netCongestionRenderPercent > 0 && netCongestionRenderPercent < 100) {
+            float scale = netCongestionRenderPercent / 100.0f;
+            for (auto &distSq: gRenderDistSq) {
+                distSq *= scale * scale;
+            }
+            for (auto &distSq: gGameObjectRenderDistSq) {
+                distSq *= scale * scale;
+            }
+        }
+
+        // any setting can change an answer, not just the distances
+        if (renderDistSettingsVersion != gSettingsVersion ||
+            std::memcmp(previousDistSq, gRenderDistSq, sizeof(gRenderDistSq)) != 0 ||
+            std::memcmp(previousGameObjectDistSq, gGameObjectRenderDistSq, sizeof(gGameObjectRenderDistSq)) != 0) {
+            InvalidateRenderSchedule();
+        }
+
+        renderDistSettingsVersion = gSettingsVersion;
+        renderDistInCombat = gPlayerInCombat;
+        renderDistInCity = gPlayerInCity;
+        renderDistCongested = NetCongested();
+    }
+
+    bool ShouldRenderBasedOnDistance(uintptr_t *this_ptr, RENDER_CATEGORY category) {
+        ResolveStaleRenderDistances();
+        return ShouldRenderWithinDistSq(this_ptr, gRenderDistSq[category]);
+    }
+
+    void ResolveStaleRenderDistances() {
+        // settings can change between frames and the globals are poked directly by tests, both are rare
+        if (renderDistSettingsVersion != gSettingsVersion || renderDistInCombat != gPlayerInCombat ||
+            renderDistInCity != gPlayerInCity || renderDistCongested != NetCongested()) {
+            ResolveRenderDistances();
+        }
+    }
+
+    bool ShouldRenderWithinDistSq(uintptr_t *this_ptr, float renderDistSq) {
+        // exact distance, strictly inside the threshold like the old truncated comparison
+        auto position = UnitGetPosition(this_ptr);
+        float distanceSq = SquaredDistanceBetween(position, gViewFromCamera ? gViewPosition : gPlayerPosition);
+        if (renderRecheckFrames > 1) {
+            NoteBoundaryMargin(distanceSq, renderDistSq);
+        }
+        if (!gViewFromCamera) {
+            return distanceSq < renderDistSq;
+        }
+
+        // the cone test is a dot product, units behind the camera cost no more than distant ones
+        return distanceSq < renderDistSq && (!viewCone || InViewCone(position, distanceSq));
+    }
+
+    uint32_t shouldRenderPlayer(uintptr_t *unitPtr) {
+        if (hideAllPlayers) {
+            return 0; // Hide all players
+        }
+        auto unitGuid = UnitGetGuid(unitPtr);
+        if (alwaysRenderRaidMarks) {
+            auto raidMark = GetRaidMarkForGuid(unitGuid);
+
+            if (raidMark > 0) {
+                // always render players with raid marks
+                return 1;
+            }
+        }
+
+        // check if this player is in NeverRenderPlayers blacklist
+        if (shouldNeverRenderPlayer(unitPtr, unitGuid)) {
+            return 0; // Force hide this player
+        }
+
+        // always show MC players
+        if (UnitIsCharmed(unitPtr)) {
+            return 1;
+        }
+
+        // always show PvP-flagged players if cvar on
+        // only if attackable so we don't show pvp players in group/raid
+        if (alwaysRenderPVP && UnitIsPvpFlagged(unitPtr) && PlayerCanAttackUnit(unitPtr, unitGuid)) {
+            return 1;
+        }
+
+        // check if this player is in AlwaysRenderPlayers list
+        if (shouldAlwaysRenderPlayer(unitPtr, unitGuid)) {
+            return 1;
+        }
+
+        return ShouldRenderBasedOnDistance(unitPtr, RENDER_CATEGORY_PLAYER);
+    }
+
+    uint32_t shouldRenderUnit(uintptr_t *unitPtr) {
+        auto unitGuid = UnitGetGuid(unitPtr);
+        if (alwaysRenderRaidMarks) {
+            auto raidMark = GetRaidMarkForGuid(unitGuid);
+
+            if (raidMark > 0) {
+                // always render raid marks
+                return 1;
+            }
+        }
+
+        auto isDead = UnitIsDead(unitPtr);
+        if (isDead && corpseRenderDist != -1) {
+            // some corpses (lootable ones?) are dead units
+            return ShouldRenderBasedOnDistance(unitPtr, RENDER_CATEGORY_CORPSE);
+        }
+
+        auto classification = GetUnitClass(unitPtr, unitGuid);
+        switch (classification.unitClass) {
+            case UNIT_CLASS_PET:
+                return ShouldRenderBasedOnDistance(unitPtr, RENDER_CATEGORY_PET);
+            case UNIT_CLASS_SUMMON:
+                if (summonRenderDist != -1) {
+                    return ShouldRenderBasedOnDistance(unitPtr, RENDER_CATEGORY_SUMMON);
+                }
+                break;
+            default:
+                break;
+        }
+
+        // own summons and summons without a summon distance are culled like trash
+        if (classification.trashLevel) {
+            return ShouldRenderBasedOnDistance(unitPtr, RENDER_CATEGORY_TRASH);
+        }
+
+        return 1; // Default to rendering the unit
+    }
+
+    uint32_t shouldRenderCorpse(uintptr_t *unitPtr) {
+        return ShouldRenderBasedOnDistance(unitPtr, RENDER_CATEGORY_CORPSE);
+    }
+
+    uint32_t shouldRenderGameObject(uintptr_t *objectPtr) {
+        auto *fields = GameObjectGetFields(objectPtr);
+        auto type = GameObjectGetType(objectPtr);
+        if (!fields || type == GAMEOBJECT_TYPE_MAX || GameObjectTypeAlwaysRendered(type)) {
+            return 1;
+        }
+
+        // quest objects and the player's own, e.g. a fishing bobber
+        if ((fields->dynamicFlags & GAMEOBJECT_DYNFLAG_ACTIVATE) != 0 ||
+            (gPlayerGuid != 0 && fields->createdBy == gPlayerGuid)) {
+            return 1;
+        }
+
+        ResolveStaleRenderDistances();
+        return ShouldRenderWithinDistSq(objectPtr, gGameObjectRenderDistSq[type]);
+    }
+
+    uint32_t shouldRenderObject(uintptr_t *unitPtr, uint32_t clientResult) {
+        if (!pbEnabled) {
+            return clientResult;
+        }
+
+        uint32_t result = clientResult;
+        auto guid = UnitGetGuid(unitPtr);
+        if (clientResult == 1 && gPlayerUnit) {
+            if (unitPtr != gPlayerUnit) {
+                auto unitType = UnitGetType(unitPtr);
+
+                // keep answers steady while the network is congested
+                auto frozen = FrozenRenderDecision(guid);
+                if (frozen >= 0) {
+                    result = static_cast<uint32_t>(frozen);
+                    // keep ranking what the budgets ranked so nothing looks new once the freeze ends
+                    if ((unitBudget > 0 || corpseBudget > 0) && RankedLastFrame(guid)) {
+                        WithinRenderBudgets(unitPtr, guid, unitType);
+                    }
+                } else {
+                    result = ScheduledDecideRender(unitPtr, guid, unitType, clientResult);
+                    if (result != 0 && (unitBudget > 0 || corpseBudget > 0) &&
+                        !WithinRenderBudgets(unitPtr, guid, unitType)) {
+                        result = 0;
+                    }
+                    FreezeRenderDecision(guid, result != 0);
+                }
+            }
+        }
+        RecordRenderDecision(guid, clientResult, result);
+        return result;
+    }
+
+    void BeginFrame() {
+        // store player data once before ShouldRender is called
+        auto playerGuid = ClntObjMgrGetActivePlayerGuid();
+        gPlayerGuid = playerGuid;
+        if (playerGuid != 0) {
+            gPlayerUnit = nullptr;
+            auto unitPtr = GetObjectPtr(playerGuid);
+            if (unitPtr != nullptr) {
+                // check that descriptor fields are loaded
+                auto *unitFields = UnitGetFields(unitPtr);
+                if (unitFields != nullptr && unitFields->level > 0) {
+                    gPlayerUnit = unitPtr;
+                }
+            }
+            if (gPlayerUnit) {
+                gPlayerPosition = UnitGetPosition(gPlayerUnit);
+                gPlayerInCombat = UnitIsInCombat(gPlayerUnit);
+                if (UpdateZoneContext()) {
+                    // units from the old zone won't be seen again
+                    ClearUnitClassCache();
+                }
+                gPlayerInCity = CurrentZone().context == ZONE_CONTEXT_CITY;
+            }
+        }
+        UpdateView();
+        ResolveRenderDistances();
+        SnapshotRaidMarks();
+
+        uint64_t currentTime = GetWowTimeMs();
+        gFrameTimeMs = currentTime;
+        ++gFrameIndex;
+        StatsBeginFrame(currentTime);
+        UpdateNetCongestion(currentTime);
+        UpdateImportance();
+        UpdateRenderBudgets();
+        UpdateRenderSchedule();
+
+        SetGroupSize(static_cast<uint32_t>(GroupMemberCount()));
+
+        // Every 60 seconds: move unresolved players to alwaysRenderPlayersToCheck if there are any
+        if (gPlayerUnit && !unresolvedPlayers.empty() && (currentTime - lastOfflineCheckTime) > 60000) {
+            alwaysRenderPlayersToCheck.insert(alwaysRenderPlayersToCheck.end(), unresolvedPlayers.begin(),
+                                              unresolvedPlayers.end());
+            DEBUG_LOG("Moved " << unresolvedPlayers.size() << " unresolved players to alwaysRenderPlayersToCheck");
+            unresolvedPlayers.clear();
+            // names are only matched this frame, everyone has to be asked
+            InvalidateRenderSchedule();
+            lastOfflineCheckTime = currentTime;
+        }
+
+        // Every 60 seconds: move neverRender unresolved players to neverRenderPlayersToCheck if there are any
+        if (gPlayerUnit && !neverRenderUnresolvedPlayers.empty() &&
+            (currentTime - neverRenderLastOfflineCheckTime) > 60000) {
+            neverRenderPlayersToCheck.insert(neverRenderPlayersToCheck.end(), neverRenderUnresolvedPlayers.begin(),
+                                             neverRenderUnresolvedPlayers.end());
+            DEBUG_LOG("Moved " << neverRenderUnresolvedPlayers.size()
+                               << " neverRender unresolved players to neverRenderPlayersToCheck");
+            neverRenderUnresolvedPlayers.clear();
+            InvalidateRenderSchedule();
+            neverRenderLastOfflineCheckTime = currentTime;
+        }
+    }
+
+    void EndFrame() {
+        if (!alwaysRenderPlayersToCheck.empty()) {
+            // move any remaining players from alwaysRenderPlayersToCheck back to unresolvedPlayers
+            unresolvedPlayers.insert(unresolvedPlayers.end(), alwaysRenderPlayersToCheck.begin(),
+                                     alwaysRenderPlayersToCheck.end());
+            DEBUG_LOG("Moved " << alwaysRenderPlayersToCheck.size() << " players back to unresolvedPlayers");
+            alwaysRenderPlayersToCheck.clear();
+        }
+
+        if (!neverRenderPlayersToCheck.empty()) {
+            // move any remaining neverRender players from neverRenderPlayersToCheck back to neverRenderUnresolvedPlayers
+            neverRenderUnresolvedPlayers.insert(neverRenderUnresolvedPlayers.end(), neverRenderPlayersToCheck.begin(),
+                                                neverRenderPlayersToCheck.end());
+            DEBUG_LOG("Moved " << neverRenderPlayersToCheck.size()
+                               << " neverRender players back to neverRenderUnresolvedPlayers");
+            neverRenderPlayersToCheck.clear();
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstdint>
+
+namespace perf_boost {
+    // player state captured once per frame by BeginFrame, before ShouldRender is called
+    extern uintptr_t *gPlayerUnit;
+    extern C3Vector gPlayerPosition;
+    extern bool gPlayerInCombat;
+    extern bool gPlayerInCity;
+    extern uint64_t gPlayerGuid;
+    extern uint64_t gFrameTimeMs;
+    extern uint32_t gFrameIndex;
+
+    // where render distances are measured from this frame, the camera with PB_CameraRelativeCulling while there is one
+    // and otherwise the player
+    extern bool gViewFromCamera;
+    extern C3Vector gViewPosition;
+    extern C3Vector gViewForward;
+
+    // read the camera for this frame, done by BeginFrame
+    void UpdateView();
+
+    // copy the raid marks for this frame, done by BeginFrame.  Marks set mid frame show up on the next one
+    void SnapshotRaidMarks();
+
+    // 1-8 or -1 if the guid wasn't marked when the frame began
+    int GetRaidMarkForGuid(uint64_t targetGUID);
+
+    bool shouldAlwaysRenderPlayer(uintptr_t *unitPtr, uint64_t unitGuid);
+    bool shouldNeverRenderPlayer(uintptr_t *unitPtr, uint64_t unitGuid);
+
+    enum RENDER_CATEGORY {
+        RENDER_CATEGORY_PLAYER,
+        RENDER_CATEGORY_PET,
+        RENDER_CATEGORY_SUMMON,
+        RENDER_CATEGORY_TRASH,
+        RENDER_CATEGORY_CORPSE,
+        RENDER_CATEGORY_COUNT
+    };
+
+    // effective render distance of each category for the current combat/city state, squared.  0 never renders,
+    // infinity always renders
+    extern float gRenderDistSq[RENDER_CATEGORY_COUNT];
+    // the same for each GameObjectType from PB_GameObjectRenderDists
+    extern float gGameObjectRenderDistSq[GAMEOBJECT_TYPE_MAX];
+
+    // resolve gRenderDistSq from the settings and player state, done by BeginFrame and after any setting change
+    void ResolveRenderDistances();
+    // ResolveRenderDistances if a setting or the player's state changed since
+    void ResolveStaleRenderDistances();
+
+    // inside the category's render distance of the view position and, when viewing from the camera, within
+    // PB_CameraCullAngle of where it looks
+    bool ShouldRenderBasedOnDistance(uintptr_t *this_ptr, RENDER_CATEGORY category);
+    bool ShouldRenderWithinDistSq(uintptr_t *this_ptr, float renderDistSq);
+
+    uint32_t shouldRenderPlayer(uintptr_t *unitPtr);
+    uint32_t shouldRenderUnit(uintptr_t *unitPtr);
+    uint32_t shouldRenderCorpse(uintptr_t *unitPtr);
+    // see game_objects.hpp
+    uint32_t shouldRenderGameObject(uintptr_t *objectPtr);
+
+    // final CGUnit::ShouldRender answer given what the client decided on its own
+    uint32_t shouldRenderObject(uintptr_t *unitPtr, uint32_t clientResult);
+
+    // called around the client's world render each frame
+    void BeginFrame();
+    void EndFrame();
+}
@@ -0,0 +1,126 @@
+#include "render_schedule.hpp"
+#include "distance.hpp"
+#include "render.hpp"
+#include "settings.hpp"
+
+#include <cmath>
+#include <unordered_map>
+
+namespace perf_boost {
+    namespace {
+        // entries nobody asked about for this long belong to units that are gone
+        const uint32_t kStaleFrames = 64;
+        const uint32_t kPruneEveryFrames = 256;
+
+        struct ScheduledDecision {
+            C3Vector position;
+            float boundaryMargin;
+            // how far the view had travelled when the unit was decided
+            double viewTravel;
+            uint32_t decidedFrame;
+            uint32_t dueFrame;
+            bool rendered;
+        };
+
+        std::unordered_map<uint64_t, ScheduledDecision> schedule;
+
+        // total yards the view origin has moved, switching between camera and player counts as a move
+        double viewTravel = 0.0;
+        float viewYardsPerFrame = 0.0f;
+        C3Vector lastViewOrigin = {0.0f, 0.0f, 0.0f};
+        bool haveViewOrigin = false;
+        uint32_t lastPruneFrame = 0;
+
+        uint32_t Phase(uint64_t guid) {
+            return static_cast<uint32_t>(guid ^ (guid >> 32));
+        }
+    }
+
+    void UpdateRenderSchedule() {
+        if (renderRecheckFrames <= 1) {
+            schedule.clear();
+            haveViewOrigin = false;
+            return;
+        }
+
+        const auto &origin = gViewFromCamera ? gViewPosition : gPlayerPosition;
+        viewYardsPerFrame = haveViewOrigin ? std::sqrt(SquaredDistanceBetween(origin, lastViewOrigin)) : 0.0f;
+        viewTravel += viewYardsPerFrame;
+        lastViewOrigin = origin;
+        haveViewOrigin = true;
+
+        if (gFrameIndex - lastPruneFrame >= kPruneEveryFrames) {
+            lastPruneFrame = gFrameIndex;
+            for (auto it = schedule.begin(); it != schedule.end();) {
+                if (static_cast<int32_t>(gFrameIndex - it->second.dueFrame) > static_cast<int32_t>(kStaleFrames)) {
+                    it = schedule.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    int ScheduledRenderDecision(uint64_t guid, const C3Vector &position) {
+        auto it = schedule.find(guid);
+        if (it == schedule.end() || static_cast<int32_t>(gFrameIndex - it->second.dueFrame) >= 0) {
+            return -1;
+        }
+
+        auto &entry = it->second;
+        float moved = std::sqrt(SquaredDistanceBetween(position, entry.position)) +
+                      static_cast<float>(viewTravel - entry.viewTravel);
+        if (moved >= entry.boundaryMargin) {
+            return -1;
+        }
+
+        return entry.rendered ? 1 : 0;
+    }
+
+    void ScheduleRenderDecision(uint64_t guid, const C3Vector &position, bool rendered, float boundaryMargin) {
+        auto &entry = schedule[guid];
+        float unitYardsPerFrame = 0.0f;
+        if (entry.decidedFrame != 0 && gFrameIndex != entry.decidedFrame) {
+            unitYardsPerFrame = std::sqrt(SquaredDistanceBetween(position, entry.position)) /
+                                static_cast<float>(gFrameIndex - entry.decidedFrame);
+        }
+
+        entry.position = position;
+        entry.boundaryMargin = boundaryMargin;
+        entry.viewTravel = viewTravel;
+        entry.decidedFrame = gFrameIndex;
+        entry.rendered = rendered;
+
+        auto interval = RenderRecheckInterval(boundaryMargin, unitYardsPerFrame + viewYardsPerFrame);
+        entry.dueFrame = gFrameIndex + interval - ((gFrameIndex + Phase(guid)) & (interval - 1));
+    }
+
+    uint32_t RenderRecheckInterval(float boundaryMargin, float yardsPerFrame) {
+        auto maxInterval = static_cast<uint32_t>(renderRecheckFrames > 1 ? renderRecheckFrames : 1);
+        uint32_t frames = maxInterval;
+        if (boundaryMargin <= 0.0f) {
+            frames = 1;
+        } else if (yardsPerFrame > 0.0f && boundaryMargin < yardsPerFrame * static_cast<float>(maxInterval)) {
+            frames = static_cast<uint32_t>(boundaryMargin / yardsPerFrame);
+        }
+
+        // round down to a power of two so the guid phase spreads units evenly
+        uint32_t interval = 1;
+        while (interval * 2 <= frames) {
+            interval *= 2;
+        }
+        return interval;
+    }
+
+    void InvalidateRenderSchedule() {
+        schedule.clear();
+    }
+
+    void ResetRenderSchedule() {
+        schedule.clear();
+        viewTravel = 0.0;
+        viewYardsPerFrame = 0.0f;
+        haveViewOrigin = false;
+        lastPruneFrame = 0;
+    }
+}
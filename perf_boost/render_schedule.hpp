@@ -0,0 +1,31 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstdint>
+
+namespace perf_boost {
+    // Staggered re-evaluation of ShouldRender answers.  With PB_RenderRecheckFrames above 1 a unit's answer is reused
+    // until it could have crossed its cull boundary: units near the boundary are re-evaluated every frame, units far
+    // from it (or kept by something other than distance) up to every PB_RenderRecheckFrames frames depending on how
+    // fast they and the view are moving.  Intervals are rounded down to a power of two and phased by guid so units
+    // seen on the same frame come due on different ones.  A unit that moves further than its margin since it was
+    // decided, a teleport or a charge, is re-evaluated right away.
+
+    // track how far the view moved and drop stale entries, done by BeginFrame
+    void UpdateRenderSchedule();
+
+    // 1 or 0 while the unit's last answer still holds, -1 when it is due
+    int ScheduledRenderDecision(uint64_t guid, const C3Vector &position);
+
+    // boundaryMargin is how many yards the unit and the view together can move before the answer could change,
+    // 0 for every frame and infinity when distance didn't decide it
+    void ScheduleRenderDecision(uint64_t guid, const C3Vector &position, bool rendered, float boundaryMargin);
+
+    // frames until the answer is due again for a unit this far from its boundary moving this many yards per frame
+    uint32_t RenderRecheckInterval(float boundaryMargin, float yardsPerFrame);
+
+    // render distances, raid marks or settings changed, everything is re-evaluated on its next ask
+    void InvalidateRenderSchedule();
+    void ResetRenderSchedule();
+}
@@ -0,0 +1,561 @@
+#include "settings.hpp"
+#include "game_objects.hpp"
+#include "logging.hpp"
+#include "trace.hpp"
+#include "zone_context.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <sstream>
+
+namespace perf_boost {
+    bool pbEnabled;
+
+    int playerRenderDist;
+    int playerRenderDistInCities;
+    int playerRenderDistInCombat;
+    int petRenderDist;
+    int petRenderDistInCombat;
+    int summonRenderDist;
+    int summonRenderDistInCombat;
+    int trashUnitRenderDist;
+    int trashUnitRenderDistInCombat;
+    int corpseRenderDist;
+    bool alwaysRenderRaidMarks;
+    bool alwaysRenderPVP;
+    bool hideAllPlayers;
+    bool filterGuidEvents;
+
+    bool showPlayerSpellVisuals;
+    bool showPlayerGroundEffects;
+    bool showPlayerAuraVisuals;
+    bool showUnitAuraVisuals;
+    bool hideSpellsForHiddenPlayers;
+    bool applyHiddenSpellIdsToMe;
+    bool dedupGroundEffects;
+
+    std::string hiddenSpellIdsString;
+    std::vector<uint32_t> hiddenSpellIds;
+    std::string alwaysShownSpellIdsString;
+    std::vector<uint32_t> alwaysShownSpellIds;
+
+    std::string trashCreatureIdsString;
+    std::vector<uint32_t> trashCreatureIds;
+    std::string bossCreatureIdsString;
+    std::vector<uint32_t> bossCreatureIds;
+    int bossHealthPerPlayer;
+
+    std::string throttledFramesString;
+    std::vector<std::string> throttledFrameNames;
+    int throttledFrameRate;
+
+    bool measureEvents;
+
+
+    int netCongestionBandwidth;
+    int netCongestionLatency;
+    int netCongestionRenderPercent;
+
+    int unitBudget;
+    int corpseBudget;
+    int renderRecheckFrames;
+    std::string gameObjectRenderDistsString;
+    int gameObjectRenderDists[GAMEOBJECT_TYPE_MAX];
+
+    bool cameraRelativeCulling;
+    int cameraCullAngle;
+
+    std::string animationLodTiersString;
+    std::vector<std::pair<float, int>> animationLodTiers;
+
+    std::string zoneContextsString;
+    std::vector<std::pair<uint32_t, ZONE_CONTEXT>> zoneContextOverrides;
+
+    std::vector<PlayerData> unresolvedPlayers;
+    std::vector<PlayerData> alwaysRenderPlayersToCheck;
+    std::vector<PlayerData> resolvedPlayers;
+    std::string alwaysRenderPlayersString;
+    uint64_t lastOfflineCheckTime = 0;
+
+    std::vector<PlayerData> neverRenderUnresolvedPlayers;
+    std::vector<PlayerData> neverRenderPlayersToCheck;
+    std::vector<PlayerData> neverRenderResolvedPlayers;
+    std::string neverRenderPlayersString;
+    uint64_t neverRenderLastOfflineCheckTime = 0;
+
+    void parseHiddenSpellIds(const std::string &spellIdString) {
+        hiddenSpellIds.clear();
+        if (spellIdString.empty()) {
+            return;
+        }
+
+        std::stringstream ss(spellIdString);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            item.erase(item.find_last_not_of(" \t\n\r\f\v") + 1); // rtrim
+            item.erase(0, item.find_first_not_of(" \t\n\r\f\v")); // ltrim
+            if (!item.empty()) {
+                try {
+                    uint32_t spellId = std::stoul(item);
+                    hiddenSpellIds.push_back(spellId);
+                } catch (const std::exception &e) {
+                    DEBUG_LOG("Invalid spell ID in HiddenSpellIds: " << item);
+                }
+            }
+        }
+    }
+
+    void parseAlwaysShownSpellIds(const std::string &spellIdString) {
+        alwaysShownSpellIds.clear();
+        if (spellIdString.empty()) {
+            return;
+        }
+
+        std::stringstream ss(spellIdString);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            item.erase(item.find_last_not_of(" \t\n\r\f\v") + 1); // rtrim
+            item.erase(0, item.find_first_not_of(" \t\n\r\f\v")); // ltrim
+            if (!item.empty()) {
+                try {
+                    uint32_t spellId = std::stoul(item);
+                    alwaysShownSpellIds.push_back(spellId);
+                } catch (const std::exception &e) {
+                    DEBUG_LOG("Invalid spell ID in AlwaysShownSpellIds: " << item);
+                }
+            }
+        }
+    }
+
+    namespace {
+        void parseCreatureIds(const std::string &value, std::vector<uint32_t> &ids, const char *listName) {
+            ids.clear();
+
+            std::stringstream ss(value);
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                item.erase(item.find_last_not_of(" \t\n\r\f\v") + 1); // rtrim
+                item.erase(0, item.find_first_not_of(" \t\n\r\f\v")); // ltrim
+                if (!item.empty()) {
+                    try {
+                        ids.push_back(std::stoul(item));
+                    } catch (const std::exception &e) {
+                        DEBUG_LOG("Invalid creature ID in " << listName << ": " << item);
+                    }
+                }
+            }
+        }
+    }
+
+    void parseThrottledFrames(const std::string &value) {
+        throttledFrameNames.clear();
+        throttledFramesString = value;
+
+        std::stringstream ss(value);
+        std::string frameName;
+        while (std::getline(ss, frameName, ',')) {
+            frameName.erase(0, frameName.find_first_not_of(" \t"));
+            frameName.erase(frameName.find_last_not_of(" \t") + 1);
+            if (frameName.empty()) {
+                continue;
+            }
+
+            // names end up in generated Lua, only accept what a global frame name can be
+            bool valid = std::all_of(frameName.begin(), frameName.end(), [](char c) {
+                return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+            });
+            if (valid) {
+                throttledFrameNames.push_back(frameName);
+            } else {
+                DEBUG_LOG("Invalid frame name in ThrottledFrames: " << frameName);
+            }
+        }
+    }
+
+    void parseZoneContexts(const std::string &value) {
+        zoneContextOverrides.clear();
+        zoneContextsString = value;
+
+        std::stringstream ss(value);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            item.erase(0, item.find_first_not_of(" \t"));
+            item.erase(item.find_last_not_of(" \t") + 1);
+            if (item.empty()) {
+                continue;
+            }
+
+            auto separator = item.find(':');
+            ZONE_CONTEXT context;
+            if (separator == std::string::npos || !ParseZoneContext(item.substr(separator + 1), context)) {
+                DEBUG_LOG("Invalid entry in ZoneContexts: " << item);
+                continue;
+            }
+            try {
+                zoneContextOverrides.emplace_back(std::stoul(item.substr(0, separator)), context);
+            } catch (const std::exception &e) {
+                DEBUG_LOG("Invalid area ID in ZoneContexts: " << item);
+            }
+        }
+    }
+
+    void parseAnimationLodTiers(const std::string &value) {
+        animationLodTiers.clear();
+        animationLodTiersString = value;
+
+        std::stringstream ss(value);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            item.erase(0, item.find_first_not_of(" \t"));
+            item.erase(item.find_last_not_of(" \t") + 1);
+            if (item.empty()) {
+                continue;
+            }
+
+            auto separator = item.find(':');
+            float distance = 0.0f;
+            int interval = 0;
+            if (separator != std::string::npos) {
+                distance = static_cast<float>(atof(item.substr(0, separator).c_str()));
+                interval = atoi(item.substr(separator + 1).c_str());
+            }
+            if (distance <= 0.0f || interval < 1) {
+                DEBUG_LOG("Invalid entry in AnimationLodTiers: " << item);
+                continue;
+            }
+            animationLodTiers.emplace_back(distance * distance, interval);
+        }
+        std::sort(animationLodTiers.begin(), animationLodTiers.end());
+    }
+
+    void parseGameObjectRenderDists(const std::string &value) {
+        std::fill(gameObjectRenderDists, gameObjectRenderDists + GAMEOBJECT_TYPE_MAX, -1);
+        gameObjectRenderDistsString = value;
+
+        std::stringstream ss(value);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            item.erase(0, item.find_first_not_of(" \t"));
+            item.erase(item.find_last_not_of(" \t") + 1);
+            if (item.empty()) {
+                continue;
+            }
+
+            auto separator = item.find(':');
+            GameObjectType type;
+            char *end = nullptr;
+            long distance = separator != std::string::npos ? strtol(item.c_str() + separator + 1, &end, 10) : 0;
+            if (separator == std::string::npos || !ParseGameObjectType(item.substr(0, separator), type) ||
+                GameObjectTypeAlwaysRendered(type) || end == item.c_str() + separator + 1 || *end != '\0' ||
+                distance < -1) {
+                DEBUG_LOG("Invalid entry in GameObjectRenderDists: " << item);
+                continue;
+            }
+            gameObjectRenderDists[type] = static_cast<int>(distance);
+        }
+    }
+
+    void parseAlwaysRenderPlayers(const std::string &value) {
+        unresolvedPlayers.clear();
+        alwaysRenderPlayersToCheck.clear();
+        resolvedPlayers.clear();
+        alwaysRenderPlayersString = value;
+        lastOfflineCheckTime = 0;
+
+        if (value.empty()) {
+            DEBUG_LOG("AlwaysRenderPlayers list cleared");
+            return;
+        }
+
+        std::stringstream ss(value);
+        std::string playerName;
+
+        while (std::getline(ss, playerName, ',')) {
+            playerName.erase(0, playerName.find_first_not_of(" \t"));
+            playerName.erase(playerName.find_last_not_of(" \t") + 1);
+
+            if (!playerName.empty()) {
+                unresolvedPlayers.emplace_back(playerName.c_str());
+                DEBUG_LOG("Added player to unresolvedPlayers: " << playerName.c_str());
+            }
+        }
+    }
+
+    void parseNeverRenderPlayers(const std::string &value) {
+        neverRenderUnresolvedPlayers.clear();
+        neverRenderPlayersToCheck.clear();
+        neverRenderResolvedPlayers.clear();
+        neverRenderPlayersString = value;
+        neverRenderLastOfflineCheckTime = 0;
+
+        if (value.empty()) {
+            DEBUG_LOG("NeverRenderPlayers list cleared");
+            return;
+        }
+
+        std::stringstream ss(value);
+        std::string playerName;
+
+        while (std::getline(ss, playerName, ',')) {
+            playerName.erase(0, playerName.find_first_not_of(" \t"));
+            playerName.erase(playerName.find_last_not_of(" \t") + 1);
+
+            if (!playerName.empty()) {
+                neverRenderUnresolvedPlayers.emplace_back(playerName.c_str());
+                DEBUG_LOG("Added player to neverRenderUnresolvedPlayers: " << playerName.c_str());
+            }
+        }
+    }
+
+    uint32_t gSettingsVersion = 0;
+    uint32_t gCreatureSettingsVersion = 0;
+
+    void updateFromCvar(const char *cvar, const char *value) {
+        TraceCVar(cvar, value);
+        ++gSettingsVersion;
+
+        if (strcmp(cvar, "PB_PlayerRenderDist") == 0) {
+            playerRenderDist = atoi(value);
+            DEBUG_LOG("Set PB_PlayerRenderDist to " << playerRenderDist);
+        } else if (strcmp(cvar, "PB_PlayerRenderDistInCities") == 0) {
+            playerRenderDistInCities = atoi(value);
+            DEBUG_LOG("Set PB_PlayerRenderDistInCities to " << playerRenderDistInCities);
+        } else if (strcmp(cvar, "PB_PlayerRenderDistInCombat") == 0) {
+            playerRenderDistInCombat = atoi(value);
+            DEBUG_LOG("Set PB_PlayerRenderDistInCombat to " << playerRenderDistInCombat);
+        } else if (strcmp(cvar, "PB_PetRenderDist") == 0) {
+            petRenderDist = atoi(value);
+            DEBUG_LOG("Set PB_PetRenderDist to " << petRenderDist);
+        } else if (strcmp(cvar, "PB_PetRenderDistInCombat") == 0) {
+            petRenderDistInCombat = atoi(value);
+            DEBUG_LOG("Set PB_PetRenderDistInCombat to " << petRenderDistInCombat);
+        } else if (strcmp(cvar, "PB_SummonRenderDist") == 0) {
+            summonRenderDist = atoi(value);
+            DEBUG_LOG("Set PB_SummonRenderDist to " << summonRenderDist);
+        } else if (strcmp(cvar, "PB_SummonRenderDistInCombat") == 0) {
+            summonRenderDistInCombat = atoi(value);
+            DEBUG_LOG("Set PB_SummonRenderDistInCombat to " << summonRenderDistInCombat);
+        } else if (strcmp(cvar, "PB_TrashUnitRenderDist") == 0) {
+            trashUnitRenderDist = atoi(value);
+            DEBUG_LOG("Set PB_TrashUnitRenderDist to " << trashUnitRenderDist);
+        } else if (strcmp(cvar, "PB_TrashUnitRenderDistInCombat") == 0) {
+            trashUnitRenderDistInCombat = atoi(value);
+            DEBUG_LOG("Set PB_TrashUnitRenderDistInCombat to " << trashUnitRenderDistInCombat);
+        } else if (strcmp(cvar, "PB_CorpseRenderDist") == 0) {
+            corpseRenderDist = atoi(value);
+            DEBUG_LOG("Set PB_CorpseRenderDist to " << corpseRenderDist);
+        } else if (strcmp(cvar, "PB_Enabled") == 0) {
+            pbEnabled = atoi(value) != 0;
+            DEBUG_LOG("Set PB_Enabled to " << pbEnabled);
+        } else if (strcmp(cvar, "PB_AlwaysRenderRaidMarks") == 0) {
+            alwaysRenderRaidMarks = atoi(value) != 0;
+            DEBUG_LOG("Set PB_AlwaysRenderRaidMarks to " << alwaysRenderRaidMarks);
+        } else if (strcmp(cvar, "PB_AlwaysRenderPVP") == 0) {
+            alwaysRenderPVP = atoi(value) != 0;
+            DEBUG_LOG("Set PB_AlwaysRenderPVP to " << alwaysRenderPVP);
+        } else if (strcmp(cvar, "PB_HideAllPlayers") == 0) {
+            hideAllPlayers = atoi(value) != 0;
+            DEBUG_LOG("Set PB_HideAllPlayers to " << hideAllPlayers);
+        } else if (strcmp(cvar, "PB_FilterGuidEvents") == 0) {
+            filterGuidEvents = atoi(value) != 0;
+            DEBUG_LOG("Set PB_FilterGuidEvents to " << filterGuidEvents);
+        } else if (strcmp(cvar, "PB_AlwaysRenderPlayers") == 0) {
+            parseAlwaysRenderPlayers(value);
+        } else if (strcmp(cvar, "PB_NeverRenderPlayers") == 0) {
+            parseNeverRenderPlayers(value);
+        } else if (strcmp(cvar, "PB_ShowPlayerSpellVisuals") == 0) {
+            showPlayerSpellVisuals = atoi(value) != 0;
+            DEBUG_LOG("Set PB_ShowPlayerSpellVisuals to " << showPlayerSpellVisuals);
+        } else if (strcmp(cvar, "PB_ShowPlayerGroundEffects") == 0) {
+            showPlayerGroundEffects = atoi(value) != 0;
+            DEBUG_LOG("Set PB_ShowPlayerGroundEffects to " << showPlayerGroundEffects);
+        } else if (strcmp(cvar, "PB_ShowPlayerAuraVisuals") == 0) {
+            showPlayerAuraVisuals = atoi(value) != 0;
+            DEBUG_LOG("Set PB_ShowPlayerAuraVisuals to " << showPlayerAuraVisuals);
+        } else if (strcmp(cvar, "PB_ShowUnitAuraVisuals") == 0) {
+            showUnitAuraVisuals = atoi(value) != 0;
+            DEBUG_LOG("Set PB_ShowUnitAuraVisuals to " << showUnitAuraVisuals);
+        } else if (strcmp(cvar, "PB_HideSpellsForHiddenPlayers") == 0) {
+            hideSpellsForHiddenPlayers = atoi(value) != 0;
+            DEBUG_LOG("Set PB_HideSpellsForHiddenPlayers to " << hideSpellsForHiddenPlayers);
+        } else if (strcmp(cvar, "PB_ApplyHiddenSpellIdsToMe") == 0) {
+            applyHiddenSpellIdsToMe = atoi(value) != 0;
+            DEBUG_LOG("Set PB_ApplyHiddenSpellIdsToMe to " << applyHiddenSpellIdsToMe);
+        } else if (strcmp(cvar, "PB_DedupGroundEffects") == 0) {
+            dedupGroundEffects = atoi(value) != 0;
+            DEBUG_LOG("Set PB_DedupGroundEffects to " << dedupGroundEffects);
+        } else if (strcmp(cvar, "PB_HiddenSpellIds") == 0) {
+            hiddenSpellIdsString = value;
+            parseHiddenSpellIds(hiddenSpellIdsString);
+            DEBUG_LOG("Set PB_HiddenSpellIds to " << hiddenSpellIdsString << " (parsed " << hiddenSpellIds.size()
+                                                  << " spell IDs)");
+        } else if (strcmp(cvar, "PB_AlwaysShownSpellIds") == 0) {
+            alwaysShownSpellIdsString = value;
+            parseAlwaysShownSpellIds(alwaysShownSpellIdsString);
+            DEBUG_LOG("Set PB_AlwaysShownSpellIds to " << alwaysShownSpellIdsString << " (parsed "
+                                                       << alwaysShownSpellIds.size()
+                                                       << " spell IDs)");
+        } else if (strcmp(cvar, "PB_TrashCreatureIds") == 0) {
+            trashCreatureIdsString = value;
+            parseCreatureIds(trashCreatureIdsString, trashCreatureIds, "TrashCreatureIds");
+            ++gCreatureSettingsVersion;
+            DEBUG_LOG("Set PB_TrashCreatureIds to " << trashCreatureIdsString << " (parsed "
+                                                    << trashCreatureIds.size() << " creature IDs)");
+        } else if (strcmp(cvar, "PB_BossCreatureIds") == 0) {
+            bossCreatureIdsString = value;
+            parseCreatureIds(bossCreatureIdsString, bossCreatureIds, "BossCreatureIds");
+            ++gCreatureSettingsVersion;
+            DEBUG_LOG("Set PB_BossCreatureIds to " << bossCreatureIdsString << " (parsed "
+                                                   << bossCreatureIds.size() << " creature IDs)");
+        } else if (strcmp(cvar, "PB_BossHealthPerPlayer") == 0) {
+            bossHealthPerPlayer = atoi(value);
+            ++gCreatureSettingsVersion;
+            DEBUG_LOG("Set PB_BossHealthPerPlayer to " << bossHealthPerPlayer);
+        } else if (strcmp(cvar, "PB_ThrottledFrames") == 0) {
+            parseThrottledFrames(value);
+            DEBUG_LOG("Set PB_ThrottledFrames to " << throttledFramesString << " (parsed "
+                                                   << throttledFrameNames.size() << " frames)");
+        } else if (strcmp(cvar, "PB_ThrottledFrameRate") == 0) {
+            throttledFrameRate = atoi(value);
+            DEBUG_LOG("Set PB_ThrottledFrameRate to " << throttledFrameRate);
+        } else if (strcmp(cvar, "PB_ZoneContexts") == 0) {
+            parseZoneContexts(value);
+            DEBUG_LOG("Set PB_ZoneContexts to " << zoneContextsString << " (parsed "
+                                                << zoneContextOverrides.size() << " zones)");
+        } else if (strcmp(cvar, "PB_AnimationLodTiers") == 0) {
+            parseAnimationLodTiers(value);
+            DEBUG_LOG("Set PB_AnimationLodTiers to " << animationLodTiersString << " (parsed "
+                                                     << animationLodTiers.size() << " tiers)");
+        } else if (strcmp(cvar, "PB_NetCongestionBandwidth") == 0) {
+            netCongestionBandwidth = atoi(value);
+            DEBUG_LOG("Set PB_NetCongestionBandwidth to " << netCongestionBandwidth);
+        } else if (strcmp(cvar, "PB_NetCongestionLatency") == 0) {
+            netCongestionLatency = atoi(value);
+            DEBUG_LOG("Set PB_NetCongestionLatency to " << netCongestionLatency);
+        } else if (strcmp(cvar, "PB_NetCongestionRenderPercent") == 0) {
+            netCongestionRenderPercent = atoi(value);
+            DEBUG_LOG("Set PB_NetCongestionRenderPercent to " << netCongestionRenderPercent);
+        } else if (strcmp(cvar, "PB_UnitBudget") == 0) {
+            unitBudget = atoi(value);
+            DEBUG_LOG("Set PB_UnitBudget to " << unitBudget);
+        } else if (strcmp(cvar, "PB_GameObjectRenderDists") == 0) {
+            parseGameObjectRenderDists(value);
+            DEBUG_LOG("Set PB_GameObjectRenderDists to " << gameObjectRenderDistsString);
+        } else if (strcmp(cvar, "PB_CorpseBudget") == 0) {
+            corpseBudget = atoi(value);
+            DEBUG_LOG("Set PB_CorpseBudget to " << corpseBudget);
+        } else if (strcmp(cvar, "PB_RenderRecheckFrames") == 0) {
+            renderRecheckFrames = atoi(value);
+            DEBUG_LOG("Set PB_RenderRecheckFrames to " << renderRecheckFrames);
+        } else if (strcmp(cvar, "PB_CameraRelativeCulling") == 0) {
+            cameraRelativeCulling = atoi(value) != 0;
+            DEBUG_LOG("Set PB_CameraRelativeCulling to " << cameraRelativeCulling);
+        } else if (strcmp(cvar, "PB_CameraCullAngle") == 0) {
+            cameraCullAngle = atoi(value);
+            DEBUG_LOG("Set PB_CameraCullAngle to " << cameraCullAngle);
+        } else if (strcmp(cvar, "PB_MeasureEvents") == 0) {
+            measureEvents = atoi(value) != 0;
+            DEBUG_LOG("Set PB_MeasureEvents to " << measureEvents);
+        } else if (strcmp(cvar, "PB_CaptureTrace") == 0) {
+            if (atoi(value) != 0) {
+                StartTraceCapture("perf_boost_" + std::to_string(std::time(nullptr)) + ".pbtrace");
+            } else {
+                StopTraceCapture();
+            }
+        }
+    }
+
+    void applyDefaultSettings() {
+        const char *unset[] = {
+                "PB_PlayerRenderDist", "PB_PlayerRenderDistInCities", "PB_PlayerRenderDistInCombat",
+                "PB_PetRenderDist", "PB_PetRenderDistInCombat", "PB_SummonRenderDist", "PB_SummonRenderDistInCombat",
+                "PB_TrashUnitRenderDist", "PB_TrashUnitRenderDistInCombat", "PB_CorpseRenderDist",
+        };
+        for (auto cvar: unset) {
+            updateFromCvar(cvar, "-1");
+        }
+
+        const char *enabled[] = {
+                "PB_Enabled", "PB_AlwaysRenderRaidMarks", "PB_FilterGuidEvents", "PB_ShowPlayerSpellVisuals",
+                "PB_ShowPlayerGroundEffects", "PB_ShowPlayerAuraVisuals", "PB_ShowUnitAuraVisuals",
+                "PB_HideSpellsForHiddenPlayers",
+        };
+        for (auto cvar: enabled) {
+            updateFromCvar(cvar, "1");
+        }
+
+        const char *disabled[] = {"PB_AlwaysRenderPVP", "PB_HideAllPlayers", "PB_ApplyHiddenSpellIdsToMe",
+                                  "PB_MeasureEvents", "PB_NetCongestionBandwidth", "PB_NetCongestionLatency",
+                                  "PB_CameraRelativeCulling", "PB_UnitBudget", "PB_CorpseBudget",
+                                  "PB_RenderRecheckFrames", "PB_DedupGroundEffects"};
+        for (auto cvar: disabled) {
+            updateFromCvar(cvar, "0");
+        }
+
+        const char *empty[] = {
+                "PB_AlwaysRenderPlayers", "PB_NeverRenderPlayers", "PB_HiddenSpellIds", "PB_AlwaysShownSpellIds",
+                "PB_TrashCreatureIds", "PB_BossCreatureIds", "PB_ThrottledFrames",
+                "PB_ZoneContexts", "PB_AnimationLodTiers", "PB_GameObjectRenderDists",
+        };
+        for (auto cvar: empty) {
+            updateFromCvar(cvar, "");
+        }
+
+        updateFromCvar("PB_BossHealthPerPlayer", "10000");
+        updateFromCvar("PB_ThrottledFrameRate", "20");
+        updateFromCvar("PB_NetCongestionRenderPercent", "75");
+        updateFromCvar("PB_CameraCullAngle", "140");
+    }
+
+    std::vector<std::pair<std::string, std::string>> currentSettings() {
+        std::vector<std::pair<std::string, std::string>> settings = {
+                {"PB_Enabled",                     std::to_string(pbEnabled)},
+                {"PB_PlayerRenderDist",            std::to_string(playerRenderDist)},
+                {"PB_PlayerRenderDistInCities",    std::to_string(playerRenderDistInCities)},
+                {"PB_PlayerRenderDistInCombat",    std::to_string(playerRenderDistInCombat)},
+                {"PB_PetRenderDist",               std::to_string(petRenderDist)},
+                {"PB_PetRenderDistInCombat",       std::to_string(petRenderDistInCombat)},
+                {"PB_SummonRenderDist",            std::to_string(summonRenderDist)},
+                {"PB_SummonRenderDistInCombat",    std::to_string(summonRenderDistInCombat)},
+                {"PB_TrashUnitRenderDist",         std::to_string(trashUnitRenderDist)},
+                {"PB_TrashUnitRenderDistInCombat", std::to_string(trashUnitRenderDistInCombat)},
+                {"PB_CorpseRenderDist",            std::to_string(corpseRenderDist)},
+                {"PB_AlwaysRenderRaidMarks",       std::to_string(alwaysRenderRaidMarks)},
+                {"PB_AlwaysRenderPVP",             std::to_string(alwaysRenderPVP)},
+                {"PB_HideAllPlayers",              std::to_string(hideAllPlayers)},
+                {"PB_FilterGuidEvents",            std::to_string(filterGuidEvents)},
+                {"PB_AlwaysRenderPlayers",         alwaysRenderPlayersString},
+                {"PB_NeverRenderPlayers",          neverRenderPlayersString},
+                {"PB_ShowPlayerSpellVisuals",      std::to_string(showPlayerSpellVisuals)},
+                {"PB_ShowPlayerGroundEffects",     std::to_string(showPlayerGroundEffects)},
+                {"PB_ShowPlayerAuraVisuals",       std::to_string(showPlayerAuraVisuals)},
+                {"PB_ShowUnitAuraVisuals",         std::to_string(showUnitAuraVisuals)},
+                {"PB_HideSpellsForHiddenPlayers",  std::to_string(hideSpellsForHiddenPlayers)},
+                {"PB_ApplyHiddenSpellIdsToMe",     std::to_string(applyHiddenSpellIdsToMe)},
+                {"PB_DedupGroundEffects",          std::to_string(dedupGroundEffects)},
+                {"PB_HiddenSpellIds",              hiddenSpellIdsString},
+                {"PB_AlwaysShownSpellIds",         alwaysShownSpellIdsString},
+                {"PB_TrashCreatureIds",            trashCreatureIdsString},
+                {"PB_BossCreatureIds",             bossCreatureIdsString},
+                {"PB_BossHealthPerPlayer",         std::to_string(bossHealthPerPlayer)},
+                {"PB_ThrottledFrames",             throttledFramesString},
+                {"PB_ThrottledFrameRate",          std::to_string(throttledFrameRate)},
+                {"PB_MeasureEvents",               std::to_string(measureEvents)},
+                {"PB_ZoneContexts",                zoneContextsString},
+                {"PB_AnimationLodTiers",           animationLodTiersString},
+                {"PB_NetCongestionBandwidth",      std::to_string(netCongestionBandwidth)},
+                {"PB_NetCongestionLatency",        std::to_string(netCongestionLatency)},
+                {"PB_NetCongestionRenderPercent",  std::to_string(netCongestionRenderPercent)},
+                {"PB_UnitBudget",                  std::to_string(unitBudget)},
+                {"PB_CorpseBudget",                std::to_string(corpseBudget)},
+                {"PB_RenderRecheckFrames",         std::to_string(renderRecheckFrames)},
+                {"PB_GameObjectRenderDists",       gameObjectRenderDistsString},
+                {"PB_CameraRelativeCulling",       std::to_string(cameraRelativeCulling)},
+                {"PB_CameraCullAngle",             std::to_string(cameraCullAngle)},
+        };
+        return settings;
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace perf_boost {
+    extern bool pbEnabled;
+
+    extern int playerRenderDist;
+    extern int playerRenderDistInCities;
+    extern int playerRenderDistInCombat;
+    extern int petRenderDist;
+    extern int petRenderDistInCombat;
+    extern int summonRenderDist;
+    extern int summonRenderDistInCombat;
+    extern int trashUnitRenderDist;
+    extern int trashUnitRenderDistInCombat;
+    extern int corpseRenderDist;
+    extern bool alwaysRenderRaidMarks;
+    extern bool alwaysRenderPVP;
+    extern bool hideAllPlayers;
+    extern bool filterGuidEvents;
+
+    extern bool showPlayerSpellVisuals;
+    extern bool showPlayerGroundEffects;
+    extern bool showPlayerAuraVisuals;
+    extern bool showUnitAuraVisuals;
+    extern bool hideSpellsForHiddenPlayers;
+    extern bool applyHiddenSpellIdsToMe;
+    // draw one of several identical ground effects covering the same spot, preferring the player's own
+    extern bool dedupGroundEffects;
+
+    extern std::string hiddenSpellIdsString;
+    extern std::vector<uint32_t> hiddenSpellIds;
+    extern std::string alwaysShownSpellIdsString;
+    extern std::vector<uint32_t> alwaysShownSpellIds;
+
+    // trash/boss overrides by creature entry and the max health per raid member that makes a non-boss rank a boss
+    extern std::string trashCreatureIdsString;
+    extern std::vector<uint32_t> trashCreatureIds;
+    extern std::string bossCreatureIdsString;
+    extern std::vector<uint32_t> bossCreatureIds;
+    extern int bossHealthPerPlayer;
+
+    // UI frames whose OnUpdate runs at most throttledFrameRate times a second, see frame_throttle.hpp
+    extern std::string throttledFramesString;
+    extern std::vector<std::string> throttledFrameNames;
+    extern int throttledFrameRate;
+
+    // areaId:context entries classifying zones the built in table doesn't know or gets wrong, see zone_context.hpp
+    extern std::string zoneContextsString;
+    extern std::vector<std::pair<uint32_t, ZONE_CONTEXT>> zoneContextOverrides;
+
+    // distance:interval pairs sorted by distance, stored squared, see animation_lod.hpp
+    extern std::string animationLodTiersString;
+    extern std::vector<std::pair<float, int>> animationLodTiers;
+
+    // incoming KB/s and latency in ms above which the network counts as congested, 0 ignores it, see net_stats.hpp
+    extern int netCongestionBandwidth;
+    extern int netCongestionLatency;
+    // render distances are scaled to this percentage while congested
+    extern int netCongestionRenderPercent;
+
+    // most units drawn per frame picked by importance.hpp's score, 0 for no limit
+    extern int unitBudget;
+    // most corpses and dead units drawn per frame, the nearest ones and always the player's own corpse, 0 for no limit
+    extern int corpseBudget;
+
+    // most frames a ShouldRender answer is reused for, 0 or 1 decides every unit every frame, see render_schedule.hpp
+    extern int renderRecheckFrames;
+
+    // type:distance pairs hiding game objects of a type further away, -1 for types without a limit, see
+    // game_objects.hpp
+    extern std::string gameObjectRenderDistsString;
+    extern int gameObjectRenderDists[GAMEOBJECT_TYPE_MAX];
+
+    // measure render distances from the camera instead of the player and hide culled units outside a cone of
+    // cameraCullAngle degrees around the view direction, 0 only moves the origin.  See UpdateView in render.hpp
+    extern bool cameraRelativeCulling;
+    extern int cameraCullAngle;
+
+    // time addon OnEvent handlers per frame/event pair, see event_cost.hpp
+    extern bool measureEvents;
+
+    // AlwaysRenderPlayers names wait in unresolvedPlayers, are moved to alwaysRenderPlayersToCheck once a minute
+    // for the duration of a frame and end up in resolvedPlayers once seen with a guid
+    extern std::vector<PlayerData> unresolvedPlayers;
+    extern std::vector<PlayerData> alwaysRenderPlayersToCheck;
+    extern std::vector<PlayerData> resolvedPlayers;
+    extern std::string alwaysRenderPlayersString;
+    extern uint64_t lastOfflineCheckTime;
+
+    extern std::vector<PlayerData> neverRenderUnresolvedPlayers;
+    extern std::vector<PlayerData> neverRenderPlayersToCheck;
+    extern std::vector<PlayerData> neverRenderResolvedPlayers;
+    extern std::string neverRenderPlayersString;
+    extern uint64_t neverRenderLastOfflineCheckTime;
+
+    void parseHiddenSpellIds(const std::string &spellIdString);
+    void parseAlwaysShownSpellIds(const std::string &spellIdString);
+    void parseThrottledFrames(const std::string &value);
+    void parseZoneContexts(const std::string &value);
+    void parseAnimationLodTiers(const std::string &value);
+    void parseAlwaysRenderPlayers(const std::string &value);
+    void parseNeverRenderPlayers(const std::string &value);
+
+    // bumped by every updateFromCvar so anything derived from the settings knows to recompute
+    extern uint32_t gSettingsVersion;
+    // bumped only by PB_TrashCreatureIds, PB_BossCreatureIds and PB_BossHealthPerPlayer, what IsTrashCreature reads
+    extern uint32_t gCreatureSettingsVersion;
+
+    // apply a PB_ cvar value, unknown names are ignored
+    void updateFromCvar(const char *cvar, const char *value);
+
+    // the defaults loadConfig registers the cvars with, for host builds that have no cvars
+    void applyDefaultSettings();
+
+    // every PB_ cvar with its current value, in the form updateFromCvar accepts
+    std::vector<std::pair<std::string, std::string>> currentSettings();
+}
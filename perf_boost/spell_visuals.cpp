@@ -0,0 +1,313 @@
+#include "spell_visuals.hpp"
+#include "game_view.hpp"
+#include "render.hpp"
+#include "settings.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace perf_boost {
+    namespace {
+        // identical ground effects whose centres fall in the same cube of this size are drawn once
+        const float kGroundEffectCellYards = 5.0f;
+
+        struct GroundEffectSpot {
+            uint32_t spellVisual;
+            int32_t x;
+            int32_t y;
+            int32_t z;
+
+            bool operator<(const GroundEffectSpot &other) const {
+                return std::tie(spellVisual, x, y, z) < std::tie(other.spellVisual, other.x, other.y, other.z);
+            }
+        };
+
+        struct GroundEffectOwner {
+            uint64_t guid;
+            bool mine;
+        };
+
+        struct GroundEffectVerdict {
+            // as of frame
+            bool hide;
+            // the caster is the active player
+            bool mine;
+            // SpellVisual of the spell, 0 without a spell record
+            uint32_t spellVisual;
+            // the caster wasn't around, decided again each frame until it is
+            bool casterMissing;
+            // hidden with its caster by PB_HideSpellsForHiddenPlayers, only the caster's render answer is checked
+            // again each frame
+            bool followsCaster;
+            uint64_t caster;
+            uint32_t frame;
+        };
+
+        // shouldHideGroundEffectForUnit by dynamic object guid, dropped on any cvar change and when the object is freed
+        std::unordered_map<uint64_t, GroundEffectVerdict> groundEffectVerdicts;
+
+        // the dynamic object drawn for each spot.  Kept until it is freed, hidden or replaced by one of the player's
+        // own so the drawn copy doesn't change from one visual proc to the next
+        std::map<GroundEffectSpot, GroundEffectOwner> groundEffectSpots;
+        uint32_t groundEffectSettingsVersion = ~0u;
+
+        int32_t GroundEffectCell(float coordinate) {
+            return static_cast<int32_t>(std::floor(coordinate / kGroundEffectCellYards));
+        }
+
+        GroundEffectSpot GetGroundEffectSpot(const DynamicObjectFields *fields, uint32_t spellVisual) {
+            return {spellVisual, GroundEffectCell(fields->m_position.x),
+                    GroundEffectCell(fields->m_position.y), GroundEffectCell(fields->m_position.z)};
+        }
+
+        // true if another dynamic object is already drawn for this one's spot
+        bool isDuplicateGroundEffect(uint64_t guid, const DynamicObjectFields *fields,
+                                     const GroundEffectVerdict &verdict) {
+            bool mine = verdict.mine;
+            auto inserted = groundEffectSpots.emplace(GetGroundEffectSpot(fields, verdict.spellVisual),
+                                                      GroundEffectOwner{guid, mine});
+            auto &owner = inserted.first->second;
+            if (inserted.second || owner.guid == guid) {
+                return false;
+            }
+
+            if ((mine && !owner.mine) || GetObjectPtr(owner.guid) == nullptr) {
+                owner = {guid, mine};
+                return false;
+            }
+            return true;
+        }
+
+        void releaseGroundEffectSpot(uint64_t guid, const DynamicObjectFields *fields, uint32_t spellVisual) {
+            auto it = groundEffectSpots.find(GetGroundEffectSpot(fields, spellVisual));
+            if (it != groundEffectSpots.end() && it->second.guid == guid) {
+                groundEffectSpots.erase(it);
+            }
+        }
+
+        bool isAlwaysShownSpell(const SpellRec *spellRec) {
+            return !alwaysShownSpellIds.empty() &&
+                   std::find(alwaysShownSpellIds.begin(), alwaysShownSpellIds.end(), spellRec->Id) !=
+                   alwaysShownSpellIds.end();
+        }
+
+        // shouldHideGroundEffectForUnit short of the caster's render answer, followsCaster is set when a hidden
+        // caster would hide it
+        bool hideGroundEffectBySettings(uintptr_t *unitPtr, const SpellRec *spellRec, bool &followsCaster) {
+            followsCaster = false;
+            if (!spellRec || !unitPtr || !pbEnabled || isAlwaysShownSpell(spellRec)) {
+                return false;
+            }
+
+            if (unitPtr != gPlayerUnit && UnitGetType(unitPtr) == OBJECT_TYPE_PLAYER) {
+                // hide ground effects for players other than the player
+                if (!showPlayerGroundEffects) {
+                    return true;
+                }
+                followsCaster = hideSpellsForHiddenPlayers;
+            }
+
+            // Check if this spell ID should be hidden (apply to all units or just others based on cvar)
+            if (!hiddenSpellIds.empty() && (unitPtr != gPlayerUnit || applyHiddenSpellIdsToMe)) {
+                auto it = std::find(hiddenSpellIds.begin(), hiddenSpellIds.end(), spellRec->Id);
+                if (it != hiddenSpellIds.end()) {
+                    followsCaster = false;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        GroundEffectVerdict decideGroundEffect(const DynamicObjectFields *fields) {
+            auto unitPtr = ClntObjMgrObjectPtr(TYPE_MASK_UNIT, fields->m_caster);
+            auto spellRec = GetSpellInfo(fields->m_spellID);
+
+            GroundEffectVerdict verdict;
+            verdict.hide = hideGroundEffectBySettings(unitPtr, spellRec, verdict.followsCaster) ||
+                           (verdict.followsCaster && shouldRenderPlayer(unitPtr) == 0);
+            verdict.mine = unitPtr != nullptr && unitPtr == gPlayerUnit;
+            verdict.spellVisual = spellRec ? spellRec->SpellVisual : 0;
+            verdict.casterMissing = unitPtr == nullptr;
+            verdict.caster = fields->m_caster;
+            verdict.frame = gFrameIndex;
+            return verdict;
+        }
+    }
+
+    bool shouldHideSpellForUnit(uintptr_t *unitPtr, const SpellRec *spellRec) {
+        if (!spellRec || !unitPtr) {
+            return false;
+        }
+
+        if (pbEnabled) {
+            // Check if this spell ID should always be shown (applies to all units including player)
+            if (!alwaysShownSpellIds.empty()) {
+                auto it = std::find(alwaysShownSpellIds.begin(), alwaysShownSpellIds.end(), spellRec->Id);
+                if (it != alwaysShownSpellIds.end()) {
+                    return false; // Always show this spell
+                }
+            }
+
+            if (unitPtr != gPlayerUnit) {
+                auto unitType = UnitGetType(unitPtr);
+                if (unitType == OBJECT_TYPE_PLAYER) {
+                    // Check if we should show player spells
+                    if (!showPlayerSpellVisuals) {
+                        // hide visuals for players other than the player
+                        return true;
+                    }
+
+                    // Check if we should hide spells for hidden players
+                    if (hideSpellsForHiddenPlayers && shouldRenderPlayer(unitPtr) == 0) {
+                        // hide spells for players that would be hidden
+                        return true;
+                    }
+                }
+            }
+
+            // Check if this spell ID should be hidden (apply to all units or just others based on cvar)
+            if (!hiddenSpellIds.empty() && (unitPtr != gPlayerUnit || applyHiddenSpellIdsToMe)) {
+                auto it = std::find(hiddenSpellIds.begin(), hiddenSpellIds.end(), spellRec->Id);
+                if (it != hiddenSpellIds.end()) {
+                    return true;
+                }
+            }
+        }
+
+        return false; // Do not hide this spell
+    }
+
+    bool shouldHideGroundEffectForUnit(uintptr_t *unitPtr, const SpellRec *spellRec) {
+        bool followsCaster;
+        if (hideGroundEffectBySettings(unitPtr, spellRec, followsCaster)) {
+            return true;
+        }
+        // hide spells for players that would be hidden
+        return followsCaster && shouldRenderPlayer(unitPtr) == 0;
+    }
+
+    bool shouldHideAuraEffectForUnit(uintptr_t *unitPtr, const SpellRec *spellRec) {
+        if (!spellRec || !unitPtr) {
+            return false;
+        }
+
+        if (pbEnabled) {
+            // Check if this spell ID should always be shown (applies to all units including player)
+            if (!alwaysShownSpellIds.empty()) {
+                auto it = std::find(alwaysShownSpellIds.begin(), alwaysShownSpellIds.end(), spellRec->Id);
+                if (it != alwaysShownSpellIds.end()) {
+                    return false; // Always show this spell
+                }
+            }
+
+            if (unitPtr != gPlayerUnit) {
+                auto unitType = UnitGetType(unitPtr);
+                if (unitType == OBJECT_TYPE_PLAYER) {
+                    // Check if we should show player aura visuals
+                    if (!showPlayerAuraVisuals) {
+                        return true;
+                    }
+
+                    // Check if we should hide spells for hidden players
+                    if (hideSpellsForHiddenPlayers && shouldRenderPlayer(unitPtr) == 0) {
+                        // hide spells for players that would be hidden
+                        return true;
+                    }
+                } else {
+                    // Check if we should show unit aura visuals
+                    if (!showUnitAuraVisuals) {
+                        return true;
+                    }
+                }
+            }
+
+            // Check if this spell ID should be hidden (apply to all units or just others based on cvar)
+            if (!hiddenSpellIds.empty() && (unitPtr != gPlayerUnit || applyHiddenSpellIdsToMe)) {
+                auto it = std::find(hiddenSpellIds.begin(), hiddenSpellIds.end(), spellRec->Id);
+                if (it != hiddenSpellIds.end()) {
+                    return true;
+                }
+            }
+        }
+
+        return false; // Do not hide this spell
+    }
+
+    bool IsGroundEffectSpell(const SpellRec *spellRec) {
+        return spellRec->Effect[0] == 27 || spellRec->Effect[1] == 27 || spellRec->Effect[2] == 27;
+    }
+
+    bool shouldHideChannelVisual(uintptr_t *unitPtr) {
+        auto *unitFields = UnitGetFields(unitPtr);
+
+        auto channelSpellId = unitFields->channelSpell;
+        if (channelSpellId > 0) {
+            auto spellRec = GetSpellInfo(channelSpellId);
+            if (shouldHideSpellForUnit(unitPtr, spellRec)) {
+                return true; // Hide channel visual if the spell is hidden
+            }
+        }
+        return false;
+    }
+
+    bool shouldHideDynamicObjectVisual(uintptr_t *dynamicObjPtr) {
+        auto *dynamicObjectFields = DynamicObjectGetFields(dynamicObjPtr);
+
+        if (dynamicObjectFields != nullptr) {
+            if (groundEffectSettingsVersion != gSettingsVersion) {
+                groundEffectSettingsVersion = gSettingsVersion;
+                groundEffectVerdicts.clear();
+                groundEffectSpots.clear();
+            }
+
+            // visual procs fire every tick for every ground effect in view, only the first one each looks anything up
+            auto guid = UnitGetGuid(dynamicObjPtr);
+            auto inserted = groundEffectVerdicts.emplace(guid, GroundEffectVerdict());
+            auto &verdict = inserted.first->second;
+            if (inserted.second || (verdict.casterMissing && verdict.frame != gFrameIndex)) {
+                verdict = decideGroundEffect(dynamicObjectFields);
+            } else if (verdict.followsCaster && verdict.frame != gFrameIndex) {
+                // only the caster's render answer can have changed since
+                auto casterPtr = GetObjectPtr(verdict.caster);
+                if (casterPtr) {
+                    verdict.hide = shouldRenderPlayer(casterPtr) == 0;
+                    verdict.frame = gFrameIndex;
+                } else {
+                    verdict = decideGroundEffect(dynamicObjectFields);
+                }
+            }
+
+            if (pbEnabled && dedupGroundEffects && verdict.spellVisual != 0) {
+                if (verdict.hide) {
+                    // a hidden copy can't stand in for the others
+                    releaseGroundEffectSpot(guid, dynamicObjectFields, verdict.spellVisual);
+                } else if (isDuplicateGroundEffect(guid, dynamicObjectFields, verdict)) {
+                    return true;
+                }
+            }
+            return verdict.hide;
+        }
+        return false;
+    }
+
+    void ForgetGroundEffect(uint64_t guid) {
+        if (groundEffectVerdicts.erase(guid) == 0) {
+            return;
+        }
+        for (auto it = groundEffectSpots.begin(); it != groundEffectSpots.end(); ++it) {
+            if (it->second.guid == guid) {
+                groundEffectSpots.erase(it);
+                return;
+            }
+        }
+    }
+
+    void ResetGroundEffects() {
+        groundEffectVerdicts.clear();
+        groundEffectSpots.clear();
+        groundEffectSettingsVersion = ~0u;
+    }
+}
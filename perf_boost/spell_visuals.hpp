@@ -0,0 +1,27 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstdint>
+
+namespace perf_boost {
+    bool shouldHideSpellForUnit(uintptr_t *unitPtr, const SpellRec *spellRec);
+    bool shouldHideGroundEffectForUnit(uintptr_t *unitPtr, const SpellRec *spellRec);
+    bool shouldHideAuraEffectForUnit(uintptr_t *unitPtr, const SpellRec *spellRec);
+
+    // spell effect 27 is PERSISTENT_AREA_AURA used by ground effects
+    bool IsGroundEffectSpell(const SpellRec *spellRec);
+
+    // channel visual for the unit's current UNIT_FIELD_CHANNEL_SPELL
+    bool shouldHideChannelVisual(uintptr_t *unitPtr);
+
+    // ground effect visuals owned by a dynamic object, decided by its caster.  With PB_DedupGroundEffects only one
+    // dynamic object per spell visual and few yards of ground is drawn, the first one seen or the player's own.
+    // The caster's verdict is kept by guid until a cvar changes, for a frame while it depends on the caster's render
+    // answer or the caster isn't known yet
+    bool shouldHideDynamicObjectVisual(uintptr_t *dynamicObjPtr);
+
+    // drops the dynamic object's verdict and gives up its ground effect spot so an identical one close by is drawn
+    void ForgetGroundEffect(uint64_t guid);
+    void ResetGroundEffects();
+}
@@ -0,0 +1,114 @@
+#include "stats.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace perf_boost {
+    namespace {
+        RuntimeStats stats;
+        uint32_t frameRendered = 0;
+        uint32_t frameCulled = 0;
+        uint32_t frameAnimated = 0;
+        uint32_t frameAnimationDeferred = 0;
+        uint32_t frameRenderChecksReused = 0;
+        uint64_t lastFrameMs = 0;
+
+        // this and the previous frame, Lua may ask before ShouldRender has run for the current frame.  Appending is
+        // all the render path pays, the rare Lua lookups scan
+        using RenderDecisions = std::vector<std::pair<uint64_t, bool>>;
+        RenderDecisions renderDecisions;
+        RenderDecisions previousRenderDecisions;
+
+        int FindDecision(const RenderDecisions &decisions, uint64_t guid) {
+            for (auto it = decisions.rbegin(); it != decisions.rend(); ++it) {
+                if (it->first == guid) {
+                    return it->second ? 1 : 0;
+                }
+            }
+            return -1;
+        }
+
+        const float kFrameTimeSmoothing = 0.05f;
+    }
+
+    const RuntimeStats &GetRuntimeStats() {
+        return stats;
+    }
+
+    void StatsBeginFrame(uint64_t nowMs) {
+        if (lastFrameMs != 0 && nowMs >= lastFrameMs) {
+            stats.frameMs = static_cast<float>(nowMs - lastFrameMs);
+            stats.averageFrameMs = stats.averageFrameMs == 0.0f ? stats.frameMs :
+                                   stats.averageFrameMs + (stats.frameMs - stats.averageFrameMs) * kFrameTimeSmoothing;
+        }
+        lastFrameMs = nowMs;
+
+        stats.unitsRendered = frameRendered;
+        stats.unitsCulled = frameCulled;
+        stats.unitsAnimated = frameAnimated;
+        stats.unitsAnimationDeferred = frameAnimationDeferred;
+        stats.renderChecksReused = frameRenderChecksReused;
+        frameRendered = 0;
+        frameCulled = 0;
+        frameAnimated = 0;
+        frameAnimationDeferred = 0;
+        frameRenderChecksReused = 0;
+
+        previousRenderDecisions.swap(renderDecisions);
+        renderDecisions.clear();
+    }
+
+    void RecordRenderDecision(uint64_t guid, uint32_t clientResult, uint32_t result) {
+        if (result != 0) {
+            ++frameRendered;
+        } else if (clientResult != 0) {
+            ++frameCulled;
+        }
+        renderDecisions.emplace_back(guid, result != 0);
+    }
+
+    void CountSuppressedVisual() {
+        ++stats.visualsSuppressed;
+    }
+
+    void CountFilteredEvent() {
+        ++stats.eventsFiltered;
+    }
+
+    void CountAnimation(bool animated) {
+        if (animated) {
+            ++frameAnimated;
+        } else {
+            ++frameAnimationDeferred;
+        }
+    }
+
+    void CountRenderRecheck(bool evaluated) {
+        if (!evaluated) {
+            ++frameRenderChecksReused;
+        }
+    }
+
+    int IsUnitRendered(uint64_t guid) {
+        auto rendered = FindDecision(renderDecisions, guid);
+        return rendered >= 0 ? rendered : FindDecision(previousRenderDecisions, guid);
+    }
+
+    void CopyPreviousRenderDecisions(std::unordered_map<uint64_t, bool> &decisions) {
+        for (const auto &decision: previousRenderDecisions) {
+            decisions[decision.first] = decision.second;
+        }
+    }
+
+    void ResetStats() {
+        stats = RuntimeStats();
+        frameRendered = 0;
+        frameCulled = 0;
+        frameAnimated = 0;
+        frameAnimationDeferred = 0;
+        frameRenderChecksReused = 0;
+        lastFrameMs = 0;
+        renderDecisions.clear();
+        previousRenderDecisions.clear();
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace perf_boost {
+    // Runtime counters for PerfBoost_GetStats and the per guid answers behind PerfBoost_IsUnitRendered
+
+    struct RuntimeStats {
+        float frameMs = 0.0f;          // time between the last two world renders
+        float averageFrameMs = 0.0f;   // smoothed over roughly the last 20 frames
+        uint32_t unitsRendered = 0;    // ShouldRender answers in the last complete frame
+        uint32_t unitsCulled = 0;      // of those, hidden by perf_boost when the client would have drawn them
+        uint64_t visualsSuppressed = 0;
+        uint64_t eventsFiltered = 0;   // unit events dropped by PB_FilterGuidEvents
+        uint32_t unitsAnimated = 0;         // in the last complete frame
+        uint32_t unitsAnimationDeferred = 0;
+        uint32_t renderChecksReused = 0;    // ShouldRender answers reused by PB_RenderRecheckFrames last frame
+    };
+
+    const RuntimeStats &GetRuntimeStats();
+
+    // starts a new frame's counters, called by BeginFrame
+    void StatsBeginFrame(uint64_t nowMs);
+
+    void RecordRenderDecision(uint64_t guid, uint32_t clientResult, uint32_t result);
+    void CountSuppressedVisual();
+    void CountFilteredEvent();
+    void CountAnimation(bool animated);
+    void CountRenderRecheck(bool evaluated);
+
+    // 1 rendered, 0 hidden, -1 not asked about this or last frame
+    int IsUnitRendered(uint64_t guid);
+    // answers from the last complete frame
+    void CopyPreviousRenderDecisions(std::unordered_map<uint64_t, bool> &decisions);
+
+    void ResetStats();
+}
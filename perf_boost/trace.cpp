@@ -0,0 +1,401 @@
+#include "trace.hpp"
+#include "game_view.hpp"
+#include "logging.hpp"
+#include "render.hpp"
+#include "settings.hpp"
+#include "spell_visuals.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+namespace perf_boost {
+    namespace {
+        const char kTraceMagic[8] = {'P', 'B', 'T', 'R', 'A', 'C', 'E', '\0'};
+        // 2 added Camera records and 3 GameObject records, older traces read the same.  4 added targets, corpse
+        // owners and Group records
+        const uint32_t kTraceVersion = 4;
+        const size_t kMaxGroupMembers = 40;
+        const size_t kFlushSize = 64 * 1024;
+
+        std::ofstream traceFile;
+        std::vector<char> traceBuffer;
+        std::unordered_set<uint64_t> tracedNames;
+        uint64_t tracedRaidTargets[8];
+        std::vector<uint64_t> tracedGroup;
+
+        template<typename T>
+        void Put(const T &value) {
+            auto bytes = reinterpret_cast<const char *>(&value);
+            traceBuffer.insert(traceBuffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        void PutType(TraceRecordType type) {
+            Put(static_cast<uint8_t>(type));
+        }
+
+        void PutVector(const C3Vector &position) {
+            Put(position.x);
+            Put(position.y);
+            Put(position.z);
+        }
+
+        void PutString8(const char *value) {
+            auto length = static_cast<uint8_t>(std::min<size_t>(strlen(value), 255));
+            Put(length);
+            traceBuffer.insert(traceBuffer.end(), value, value + length);
+        }
+
+        void Flush() {
+            if (!traceBuffer.empty()) {
+                traceFile.write(traceBuffer.data(), traceBuffer.size());
+                traceBuffer.clear();
+            }
+        }
+
+        void MaybeFlush() {
+            if (traceBuffer.size() >= kFlushSize) {
+                Flush();
+            }
+        }
+
+        void PutUnit(uintptr_t *unit, uint8_t bits) {
+            auto guid = UnitGetGuid(unit);
+            auto type = UnitGetType(unit);
+            // corpses and game objects have their own, smaller descriptors
+            bool hasUnitFields = type == OBJECT_TYPE_UNIT || type == OBJECT_TYPE_PLAYER;
+            auto *unitFields = hasUnitFields ? UnitGetFields(unit) : nullptr;
+            auto *gameObjectFields = type == OBJECT_TYPE_GAMEOBJECT ? GameObjectGetFields(unit) : nullptr;
+
+            if (unitFields) {
+                bits |= TRACE_UNIT_FIELDS_LOADED;
+                if (unitFields->charmedBy != 0) {
+                    bits |= TRACE_UNIT_CHARMED;
+                }
+            }
+            if (gPlayerUnit && type == OBJECT_TYPE_PLAYER && UnitCanAttackUnit(gPlayerUnit, unit)) {
+                bits |= TRACE_UNIT_ATTACKABLE;
+            }
+
+            // names are only needed to resolve the player lists, write them once ahead of the first query
+            if (type == OBJECT_TYPE_PLAYER && tracedNames.insert(guid).second) {
+                auto name = UnitGetName(unit);
+                if (name) {
+                    PutType(TraceRecordType::UnitName);
+                    Put(guid);
+                    PutString8(name);
+                }
+            }
+
+            if (gameObjectFields) {
+                bits |= TRACE_UNIT_FIELDS_LOADED;
+                PutType(TraceRecordType::GameObject);
+                Put(guid);
+                Put(gameObjectFields->typeId);
+                Put(gameObjectFields->dynamicFlags);
+                Put(gameObjectFields->createdBy);
+            }
+
+            PutType(TraceRecordType::ShouldRender);
+            Put(guid);
+            Put(static_cast<uint8_t>(type));
+            Put(bits);
+            PutVector(UnitGetPosition(unit));
+            Put(unitFields ? unitFields->flags : 0u);
+            Put(unitFields ? unitFields->level : 0u);
+            Put(unitFields ? unitFields->health : 0u);
+            Put(unitFields ? unitFields->maxHealth : 0u);
+            Put(unitFields ? unitFields->dynamicFlags : 0u);
+            Put(unitFields ? unitFields->summonedBy : uint64_t(0));
+            Put(unitFields ? unitFields->petNameTimestamp : 0u);
+            Put(unitFields ? unitFields->target : uint64_t(0));
+            Put(unitFields ? unitFields->bytes0 : 0u);
+            Put(type == OBJECT_TYPE_CORPSE ? CorpseGetOwnerGuid(unit) : uint64_t(0));
+        }
+    }
+
+    bool gTraceCapturing = false;
+
+    bool StartTraceCapture(const std::string &path) {
+        StopTraceCapture();
+
+        traceFile.open(path, std::ios::binary | std::ios::trunc);
+        if (!traceFile.is_open()) {
+            DEBUG_LOG("Unable to open trace file " << path);
+            return false;
+        }
+
+        traceBuffer.reserve(kFlushSize * 2);
+        tracedNames.clear();
+        memset(tracedRaidTargets, 0, sizeof(tracedRaidTargets));
+        tracedGroup.clear();
+
+        traceFile.write(kTraceMagic, sizeof(kTraceMagic));
+        traceFile.write(reinterpret_cast<const char *>(&kTraceVersion), sizeof(kTraceVersion));
+
+        gTraceCapturing = true;
+
+        // replay starts from the settings in effect when the capture started
+        for (const auto &setting: currentSettings()) {
+            TraceCVar(setting.first.c_str(), setting.second.c_str());
+        }
+
+        DEBUG_LOG("Started trace capture to " << path);
+        return true;
+    }
+
+    void StopTraceCapture() {
+        if (!gTraceCapturing) {
+            return;
+        }
+
+        gTraceCapturing = false;
+        Flush();
+        traceFile.close();
+        DEBUG_LOG("Stopped trace capture");
+    }
+
+    void TraceFrame() {
+        if (!gTraceCapturing) {
+            return;
+        }
+
+        auto *unitFields = gPlayerUnit ? UnitGetFields(gPlayerUnit) : nullptr;
+
+        // ahead of the frame so the replayed BeginFrame reads the same group the live one did
+        uint64_t groupGuids[kMaxGroupMembers];
+        auto groupCount = GetGroupMemberGuids(groupGuids, kMaxGroupMembers);
+        if (groupCount != tracedGroup.size() || !std::equal(groupGuids, groupGuids + groupCount, tracedGroup.begin())) {
+            tracedGroup.assign(groupGuids, groupGuids + groupCount);
+            PutType(TraceRecordType::Group);
+            Put(static_cast<uint8_t>(groupCount));
+            for (auto guid: tracedGroup) {
+                Put(guid);
+            }
+        }
+
+        PutType(TraceRecordType::Frame);
+        Put(GetWowTimeMs());
+        Put(gPlayerUnit ? UnitGetGuid(gPlayerUnit) : uint64_t(0));
+        PutVector(gPlayerPosition);
+        Put(unitFields ? unitFields->flags : 0u);
+        Put(unitFields ? unitFields->level : 0u);
+        Put(GetZoneAreaId());
+        Put(unitFields ? unitFields->target : uint64_t(0));
+
+        if (gViewFromCamera) {
+            PutType(TraceRecordType::Camera);
+            PutVector(gViewPosition);
+            PutVector(gViewForward);
+        }
+
+        auto raidTargets = GetRaidTargetGuids();
+        if (memcmp(raidTargets, tracedRaidTargets, sizeof(tracedRaidTargets)) != 0) {
+            memcpy(tracedRaidTargets, raidTargets, sizeof(tracedRaidTargets));
+            PutType(TraceRecordType::RaidMarks);
+            for (auto guid: tracedRaidTargets) {
+                Put(guid);
+            }
+        }
+
+        MaybeFlush();
+    }
+
+    void TraceShouldRender(uintptr_t *unit, uint32_t clientResult) {
+        if (!gTraceCapturing || !unit) {
+            return;
+        }
+
+        PutUnit(unit, clientResult ? TRACE_UNIT_CLIENT_RESULT : 0);
+        MaybeFlush();
+    }
+
+    void TraceVisual(TraceVisualKind kind, uintptr_t *object, const SpellRec *spellRec) {
+        if (!gTraceCapturing || !object) {
+            return;
+        }
+
+        auto objectGuid = UnitGetGuid(object);
+        uint64_t casterGuid = objectGuid;
+        uintptr_t *caster = object;
+
+        if (kind == TraceVisualKind::DynamicObject) {
+            auto *dynamicObjectFields = DynamicObjectGetFields(object);
+            if (!dynamicObjectFields) {
+                return;
+            }
+            casterGuid = dynamicObjectFields->m_caster;
+            caster = ClntObjMgrObjectPtr(TYPE_MASK_UNIT, casterGuid);
+            spellRec = GetSpellInfo(dynamicObjectFields->m_spellID);
+        }
+
+        if (!spellRec) {
+            return;
+        }
+
+        if (caster) {
+            PutUnit(caster, TRACE_UNIT_SNAPSHOT);
+        }
+
+        PutType(TraceRecordType::Visual);
+        Put(static_cast<uint8_t>(kind));
+        Put(objectGuid);
+        Put(casterGuid);
+        Put(static_cast<uint8_t>(caster ? UnitGetType(caster) : OBJECT_TYPE_OBJECT));
+        Put(static_cast<uint32_t>(spellRec->Id));
+        Put(IsGroundEffectSpell(spellRec) ? static_cast<uint32_t>(TRACE_SPELL_GROUND_EFFECT) : 0u);
+        MaybeFlush();
+    }
+
+    void TraceUnitSignal(uint64_t guid, uint32_t eventCode, const char *name) {
+        if (!gTraceCapturing || !name) {
+            return;
+        }
+
+        PutType(TraceRecordType::UnitSignal);
+        Put(guid);
+        Put(eventCode);
+        PutString8(name);
+        MaybeFlush();
+    }
+
+    void TraceCVar(const char *cvar, const char *value) {
+        if (!gTraceCapturing) {
+            return;
+        }
+
+        PutType(TraceRecordType::CVar);
+        PutString8(cvar);
+        auto length = static_cast<uint16_t>(std::min<size_t>(strlen(value), 65535));
+        Put(length);
+        traceBuffer.insert(traceBuffer.end(), value, value + length);
+        MaybeFlush();
+    }
+
+    bool TraceReader::Open(const std::string &path) {
+        mFile.open(path, std::ios::binary);
+        if (!mFile.is_open()) {
+            return false;
+        }
+
+        char magic[sizeof(kTraceMagic)];
+        mFile.read(magic, sizeof(magic));
+        if (!mFile || memcmp(magic, kTraceMagic, sizeof(magic)) != 0 || !Get(mVersion) || mVersion == 0 ||
+            mVersion > kTraceVersion) {
+            mFailed = true;
+            return false;
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool TraceReader::Get(T &value) {
+        mFile.read(reinterpret_cast<char *>(&value), sizeof(T));
+        return static_cast<bool>(mFile);
+    }
+
+    bool TraceReader::GetString(std::string &value, size_t length) {
+        value.resize(length);
+        if (length > 0) {
+            mFile.read(&value[0], length);
+        }
+        return static_cast<bool>(mFile);
+    }
+
+    bool TraceReader::Next(TraceRecord &record) {
+        uint8_t type = 0;
+        if (!Get(type)) {
+            return false; // clean end of trace
+        }
+
+        bool ok = true;
+        record.type = static_cast<TraceRecordType>(type);
+        switch (record.type) {
+            case TraceRecordType::Frame: {
+                auto &frame = record.frame;
+                ok = Get(frame.timeMs) && Get(frame.playerGuid) && Get(frame.position.x) && Get(frame.position.y) &&
+                     Get(frame.position.z) && Get(frame.playerFlags) && Get(frame.playerLevel) &&
+                     Get(frame.zoneAreaId);
+                frame.playerTarget = 0;
+                if (ok && mVersion >= 4) {
+                    ok = Get(frame.playerTarget);
+                }
+                break;
+            }
+            case TraceRecordType::Camera: {
+                auto &camera = record.camera;
+                ok = Get(camera.position.x) && Get(camera.position.y) && Get(camera.position.z) &&
+                     Get(camera.forward.x) && Get(camera.forward.y) && Get(camera.forward.z);
+                break;
+            }
+            case TraceRecordType::RaidMarks:
+                for (auto &guid: record.raidTargets) {
+                    ok = ok && Get(guid);
+                }
+                break;
+            case TraceRecordType::ShouldRender: {
+                auto &unit = record.unit;
+                ok = Get(unit.guid) && Get(unit.type) && Get(unit.bits) && Get(unit.position.x) &&
+                     Get(unit.position.y) && Get(unit.position.z) && Get(unit.flags) && Get(unit.level) &&
+                     Get(unit.health) && Get(unit.maxHealth) && Get(unit.dynamicFlags) && Get(unit.summonedBy) &&
+                     Get(unit.petNameTimestamp);
+                unit.target = 0;
+                unit.bytes0 = 0;
+                unit.owner = 0;
+                if (ok && mVersion >= 4) {
+                    ok = Get(unit.target) && Get(unit.bytes0) && Get(unit.owner);
+                }
+                break;
+            }
+            case TraceRecordType::GameObject: {
+                auto &gameObject = record.gameObject;
+                ok = Get(gameObject.guid) && Get(gameObject.typeId) && Get(gameObject.dynamicFlags) &&
+                     Get(gameObject.createdBy);
+                break;
+            }
+            case TraceRecordType::Group: {
+                uint8_t count = 0;
+                ok = Get(count);
+                record.group.resize(count);
+                for (auto &guid: record.group) {
+                    ok = ok && Get(guid);
+                }
+                break;
+            }
+            case TraceRecordType::UnitName: {
+                uint8_t length = 0;
+                ok = Get(record.nameGuid) && Get(length) && GetString(record.name, length);
+                break;
+            }
+            case TraceRecordType::Visual: {
+                auto &visual = record.visual;
+                uint8_t kind = 0;
+                ok = Get(kind) && Get(visual.objectGuid) && Get(visual.casterGuid) && Get(visual.casterType) &&
+                     Get(visual.spellId) && Get(visual.spellFlags);
+                visual.kind = static_cast<TraceVisualKind>(kind);
+                break;
+            }
+            case TraceRecordType::UnitSignal: {
+                uint8_t length = 0;
+                ok = Get(record.signal.guid) && Get(record.signal.eventCode) && Get(length) &&
+                     GetString(record.name, length);
+                break;
+            }
+            case TraceRecordType::CVar: {
+                uint8_t nameLength = 0;
+                uint16_t valueLength = 0;
+                ok = Get(nameLength) && GetString(record.name, nameLength) && Get(valueLength) &&
+                     GetString(record.value, valueLength);
+                break;
+            }
+            default:
+                ok = false;
+                break;
+        }
+
+        if (!ok) {
+            mFailed = true;
+        }
+        return ok;
+    }
+}
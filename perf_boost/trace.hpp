@@ -0,0 +1,163 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace perf_boost {
+    // Binary capture of everything perf_boost sees from the client so real sessions can be replayed on the host
+    // (see tools/perf_boost_replay).  A trace is the 8 byte magic, a uint32 version and then a stream of records,
+    // each a one byte TraceRecordType followed by its fixed layout below.  Values are written in host byte order,
+    // which is little endian for both the 32-bit client and the x86-64 replay host.
+
+    enum class TraceRecordType : uint8_t {
+        // u64 timeMs, u64 playerGuid, f32 x/y/z, u32 playerFlags, u32 playerLevel, u32 zoneAreaId, since version 4
+        // u64 playerTarget
+        Frame = 1,
+        // u64 guid x 8, only written when a mark changed
+        RaidMarks = 2,
+        // u64 guid, u8 type, u8 TraceUnitBits, f32 x/y/z, u32 flags, level, health, maxHealth, dynamicFlags,
+        // u64 summonedBy, u32 petNameTimestamp, since version 4 u64 target, u32 bytes0, u64 corpse owner
+        ShouldRender = 3,
+        // u64 guid, u8 length, name bytes.  Written before the first record for a named player
+        UnitName = 4,
+        // u8 TraceVisualKind, u64 object guid, u64 caster guid, u8 caster type, u32 spell id, u32 spell flags
+        Visual = 5,
+        // u64 guid, u32 event code, u8 length, name bytes
+        UnitSignal = 6,
+        // u8 length, name bytes, u16 length, value bytes
+        CVar = 7,
+        // f32 x/y/z position, f32 x/y/z view direction.  Follows Frame when distances are measured from the camera
+        Camera = 8,
+        // u64 guid, u32 typeId, u32 dynamicFlags, u64 createdBy.  Precedes the ShouldRender record of a game object
+        // whose fields are loaded
+        GameObject = 9,
+        // u8 count, u64 guid x count.  Written ahead of the Frame record when the group changed
+        Group = 10,
+    };
+
+    enum TraceUnitBits : uint8_t {
+        TRACE_UNIT_CLIENT_RESULT = 0x01, // what CGUnit::ShouldRender answered before perf_boost
+        TRACE_UNIT_FIELDS_LOADED = 0x02, // unit fields, or a GameObject record for a game object
+        TRACE_UNIT_CHARMED = 0x04,
+        TRACE_UNIT_ATTACKABLE = 0x08,    // active player can attack this unit
+        TRACE_UNIT_SNAPSHOT = 0x10,      // unit state for a following visual record, not a ShouldRender query
+    };
+
+    enum class TraceVisualKind : uint8_t {
+        Spell = 0,         // CGUnit::GetAppropriateSpellVisual
+        GroundEffect = 1,  // CGUnit::GetAppropriateSpellVisual for a PERSISTENT_AREA_AURA spell
+        Aura = 2,          // CGUnit::PlaySpellVisual from the aura update
+        Channel = 3,       // CGUnit::PlayChannelVisual
+        DynamicObject = 4, // CGDynamicObject visual effect / vis kit proc
+    };
+
+    enum TraceSpellFlags : uint32_t {
+        TRACE_SPELL_GROUND_EFFECT = 0x01,
+    };
+
+    struct TraceFrameRecord {
+        uint64_t timeMs = 0;
+        uint64_t playerGuid = 0;
+        C3Vector position;
+        uint32_t playerFlags = 0;
+        uint32_t playerLevel = 0;
+        uint32_t zoneAreaId = 0;
+        uint64_t playerTarget = 0;
+    };
+
+    struct TraceUnitRecord {
+        uint64_t guid = 0;
+        uint8_t type = 0;
+        uint8_t bits = 0;
+        C3Vector position;
+        uint32_t flags = 0;
+        uint32_t level = 0;
+        uint32_t health = 0;
+        uint32_t maxHealth = 0;
+        uint32_t dynamicFlags = 0;
+        uint64_t summonedBy = 0;
+        uint32_t petNameTimestamp = 0;
+        uint64_t target = 0;
+        uint32_t bytes0 = 0;
+        uint64_t owner = 0;
+    };
+
+    struct TraceVisualRecord {
+        TraceVisualKind kind = TraceVisualKind::Spell;
+        uint64_t objectGuid = 0;
+        uint64_t casterGuid = 0;
+        uint8_t casterType = 0;
+        uint32_t spellId = 0;
+        uint32_t spellFlags = 0;
+    };
+
+    struct TraceSignalRecord {
+        uint64_t guid = 0;
+        uint32_t eventCode = 0;
+    };
+
+    struct TraceGameObjectRecord {
+        uint64_t guid = 0;
+        uint32_t typeId = 0;
+        uint32_t dynamicFlags = 0;
+        uint64_t createdBy = 0;
+    };
+
+    struct TraceCameraRecord {
+        C3Vector position;
+        C3Vector forward;
+    };
+
+    struct TraceRecord {
+        TraceRecordType type = TraceRecordType::Frame;
+        TraceFrameRecord frame;
+        TraceCameraRecord camera;
+        uint64_t raidTargets[8] = {};
+        std::vector<uint64_t> group;
+        TraceUnitRecord unit;
+        TraceGameObjectRecord gameObject;
+        TraceVisualRecord visual;
+        TraceSignalRecord signal;
+        uint64_t nameGuid = 0;
+        std::string name;   // UnitName, UnitSignal and CVar name
+        std::string value;  // CVar value
+    };
+
+    // cheap check for the hooks, everything below is a no-op while this is false
+    extern bool gTraceCapturing;
+
+    bool StartTraceCapture(const std::string &path);
+    void StopTraceCapture();
+
+    // player state, camera and raid marks, call after BeginFrame
+    void TraceFrame();
+    void TraceShouldRender(uintptr_t *unit, uint32_t clientResult);
+    // object is the casting unit, or the dynamic object for TraceVisualKind::DynamicObject
+    void TraceVisual(TraceVisualKind kind, uintptr_t *object, const SpellRec *spellRec);
+    void TraceUnitSignal(uint64_t guid, uint32_t eventCode, const char *name);
+    void TraceCVar(const char *cvar, const char *value);
+
+    class TraceReader {
+    public:
+        bool Open(const std::string &path);
+
+        // false at the end of the trace or on a truncated/unknown record
+        bool Next(TraceRecord &record);
+
+        bool failed() const { return mFailed; }
+        uint32_t version() const { return mVersion; }
+
+    private:
+        template<typename T>
+        bool Get(T &value);
+        bool GetString(std::string &value, size_t length);
+
+        std::ifstream mFile;
+        uint32_t mVersion = 0;
+        bool mFailed = false;
+    };
+}
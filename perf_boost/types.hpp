@@ -31,6 +31,7 @@
 
 #include <cstdint>
 #include <cstdarg>
+#include <cstring>
 
 namespace perf_boost {
     typedef struct C3Vector {
@@ -106,6 +107,26 @@ namespace perf_boost {
         UNIT_FLAG_UNK_29 = 0x20000000,           // used in Feing Death spell
     };
 
+    // creature_template.rank, from the client's creature cache
+    enum CreatureRank {
+        CREATURE_RANK_UNKNOWN = -1, // not in the creature cache yet
+        CREATURE_RANK_NORMAL = 0,
+        CREATURE_RANK_ELITE = 1,
+        CREATURE_RANK_RARE_ELITE = 2,
+        CREATURE_RANK_WORLDBOSS = 3,
+        CREATURE_RANK_RARE = 4,
+    };
+
+    // what kind of place the player's zone is, see zone_context.hpp
+    enum ZONE_CONTEXT {
+        ZONE_CONTEXT_OUTDOOR,
+        ZONE_CONTEXT_CITY,
+        ZONE_CONTEXT_DUNGEON,
+        ZONE_CONTEXT_RAID,
+        ZONE_CONTEXT_BATTLEGROUND,
+        ZONE_CONTEXT_COUNT
+    };
+
     typedef struct UnitFields {
         uint64_t charm;                          // Size:2
         uint64_t summon;                         // Size:2
@@ -219,6 +240,24 @@ namespace perf_boost {
         GAMEOBJECT_TYPE_MAX = 31
     } GameObjectType;
 
+    enum GAMEOBJECT_DYNAMIC_FLAGS {
+        GAMEOBJECT_DYNFLAG_ACTIVATE = 0x01,   // usable for one of the player's quests
+    };
+
+    struct GameObjectFields {
+        uint64_t createdBy;
+        uint32_t displayId;
+        uint32_t flags;
+        float rotation[4];
+        uint32_t state;
+        C3Vector position;
+        float facing;
+        uint32_t dynamicFlags;
+        uint32_t faction;
+        uint32_t typeId;
+        uint32_t level;
+    };
+
     struct DynamicObjectFields {
         uint64_t m_caster;
         uint32_t m_bytes;
@@ -313,7 +352,7 @@ namespace perf_boost {
         unsigned int StartRecoveryTime;
         unsigned int MaxTargetLevel;
         unsigned int SpellFamilyName;
-        unsigned __int64 SpellFamilyFlags;
+        uint64_t SpellFamilyFlags;
         unsigned int MaxAffectedTargets;
         unsigned int DmgClass;
         unsigned int PreventionType;
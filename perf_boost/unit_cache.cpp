@@ -0,0 +1,162 @@
+#include "unit_cache.hpp"
+#include "animation_lod.hpp"
+#include "creatures.hpp"
+#include "game_view.hpp"
+#include "render.hpp"
+#include "spell_visuals.hpp"
+
+#include <unordered_map>
+
+namespace perf_boost {
+    namespace {
+        // level, pet name and summoner don't change on a live unit, the refresh only catches anything we missed
+        const uint64_t kUnitClassRefreshMs = 5000;
+        // ObjectFree keeps the cache in step with the object manager, this only guards against missed frees
+        const size_t kMaxUnitClassEntries = 8192;
+
+        struct UnitClassEntry {
+            UnitClassification classification = {UNIT_CLASS_UNKNOWN, false};
+            bool playerControlled = false;
+            uint64_t refreshTimeMs = 0;
+            // PlayerCanAttackUnit, attackVersion 0 until first asked.  The refresh keeps these, the attack check has
+            // its own invalidation
+            bool attackable = false;
+            uint32_t attackVersion = 0;
+            uint32_t attackFactionTemplate = 0;
+            uint32_t attackFlags = 0;
+            // CreatureRaidSizeVersion the trash/boss classification was made with
+            uint32_t raidSizeVersion = 0;
+        };
+
+        std::unordered_map<uint64_t, UnitClassEntry> unitClassCache;
+        uint64_t unitClassCachePlayerGuid = 0;
+        uint32_t unitClassCacheCreatureVersion = 0;
+
+        // bumped whenever the active player's own faction template or flags change (pvp flag, duels, mind control)
+        uint32_t attackVersion = 1;
+        uint32_t attackPlayerFactionTemplate = 0;
+        uint32_t attackPlayerFlags = 0;
+    }
+
+    UnitClassification ClassifyUnit(uintptr_t *unitPtr) {
+        auto unitType = UnitGetType(unitPtr);
+        if (unitType == OBJECT_TYPE_PLAYER) {
+            return {UNIT_CLASS_PLAYER, false};
+        } else if (unitType == OBJECT_TYPE_CORPSE) {
+            return {UNIT_CLASS_CORPSE, false};
+        }
+
+        auto *unitFields = UnitGetFields(unitPtr);
+        if (unitFields == nullptr) {
+            return {UNIT_CLASS_UNKNOWN, false};
+        }
+
+        if ((unitFields->flags & UNIT_FLAG_PLAYER_CONTROLLED) != 0) {
+            bool trashLevel = unitFields->level < 63;
+            if (unitFields->summonedBy == gPlayerGuid) {
+                return {UNIT_CLASS_OWN_SUMMON, trashLevel};
+            }
+            return {unitFields->petNameTimestamp > 0 ? UNIT_CLASS_PET : UNIT_CLASS_SUMMON, trashLevel};
+        }
+
+        bool trash = IsTrashCreature(unitPtr, unitFields);
+        return {trash ? UNIT_CLASS_TRASH : UNIT_CLASS_BOSS, trash};
+    }
+
+    UnitClassification GetUnitClass(uintptr_t *unitPtr, uint64_t guid) {
+        // own summons depend on who we are, trash on the settings.  A raid size change only reclassifies NPCs
+        if (unitClassCachePlayerGuid != gPlayerGuid || unitClassCacheCreatureVersion != CreatureClassVersion()) {
+            unitClassCache.clear();
+            unitClassCachePlayerGuid = gPlayerGuid;
+            unitClassCacheCreatureVersion = CreatureClassVersion();
+        }
+
+        auto *unitFields = UnitGetFields(unitPtr);
+        bool playerControlled = unitFields && (unitFields->flags & UNIT_FLAG_PLAYER_CONTROLLED) != 0;
+
+        auto it = unitClassCache.find(guid);
+        if (it != unitClassCache.end()) {
+            auto &entry = it->second;
+            bool npc = entry.classification.unitClass == UNIT_CLASS_TRASH ||
+                       entry.classification.unitClass == UNIT_CLASS_BOSS;
+            if (entry.playerControlled == playerControlled && gFrameTimeMs - entry.refreshTimeMs < kUnitClassRefreshMs &&
+                (!npc || entry.raidSizeVersion == CreatureRaidSizeVersion())) {
+                return entry.classification;
+            }
+        }
+
+        auto classification = ClassifyUnit(unitPtr);
+        if (classification.unitClass == UNIT_CLASS_UNKNOWN) {
+            return classification;
+        }
+
+        if (it == unitClassCache.end()) {
+            if (unitClassCache.size() >= kMaxUnitClassEntries) {
+                unitClassCache.clear();
+            }
+            it = unitClassCache.emplace(guid, UnitClassEntry()).first;
+        }
+        auto &entry = it->second;
+        entry.classification = classification;
+        entry.playerControlled = playerControlled;
+        entry.refreshTimeMs = gFrameTimeMs;
+        entry.raidSizeVersion = CreatureRaidSizeVersion();
+        return classification;
+    }
+
+    bool PlayerCanAttackUnit(uintptr_t *unitPtr, uint64_t guid) {
+        if (!gPlayerUnit) {
+            return false;
+        }
+
+        auto *playerFields = UnitGetFields(gPlayerUnit);
+        auto *unitFields = UnitGetFields(unitPtr);
+        if (!playerFields || !unitFields) {
+            return UnitCanAttackUnit(gPlayerUnit, unitPtr);
+        }
+
+        if (playerFields->factionTemplate != attackPlayerFactionTemplate || playerFields->flags != attackPlayerFlags) {
+            attackPlayerFactionTemplate = playerFields->factionTemplate;
+            attackPlayerFlags = playerFields->flags;
+            ++attackVersion;
+        }
+
+        auto it = unitClassCache.find(guid);
+        if (it == unitClassCache.end()) {
+            GetUnitClass(unitPtr, guid);
+            it = unitClassCache.find(guid);
+            if (it == unitClassCache.end()) {
+                return UnitCanAttackUnit(gPlayerUnit, unitPtr);
+            }
+        }
+
+        auto &entry = it->second;
+        if (entry.attackVersion != attackVersion || entry.attackFactionTemplate != unitFields->factionTemplate ||
+            entry.attackFlags != unitFields->flags) {
+            entry.attackable = UnitCanAttackUnit(gPlayerUnit, unitPtr);
+            entry.attackVersion = attackVersion;
+            entry.attackFactionTemplate = unitFields->factionTemplate;
+            entry.attackFlags = unitFields->flags;
+        }
+        return entry.attackable;
+    }
+
+    void OnObjectFree(uintptr_t *objectPtr) {
+        if (objectPtr) {
+            auto guid = UnitGetGuid(objectPtr);
+            if (!unitClassCache.empty()) {
+                unitClassCache.erase(guid);
+            }
+            ForgetGroundEffect(guid);
+            ForgetAnimation(guid);
+        }
+    }
+
+    void ClearUnitClassCache() {
+        unitClassCache.clear();
+    }
+
+    size_t UnitClassCacheSize() {
+        return unitClassCache.size();
+    }
+}
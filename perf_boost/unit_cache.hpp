@@ -0,0 +1,42 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace perf_boost {
+    enum UNIT_CLASS : uint8_t {
+        UNIT_CLASS_UNKNOWN = 0,   // fields not loaded yet, never cached
+        UNIT_CLASS_PLAYER,
+        UNIT_CLASS_PET,           // player controlled with a pet name
+        UNIT_CLASS_SUMMON,        // player controlled without a name, totems, guardians...
+        UNIT_CLASS_OWN_SUMMON,    // anything the active player summoned
+        UNIT_CLASS_TRASH,         // see IsTrashCreature
+        UNIT_CLASS_BOSS,
+        UNIT_CLASS_CORPSE,
+    };
+
+    struct UnitClassification {
+        UNIT_CLASS unitClass;
+        // culled with the trash distance: trash, or player controlled units below level 63 that aren't culled as
+        // pets/summons
+        bool trashLevel;
+    };
+
+    // Descriptor based classification
+    UnitClassification ClassifyUnit(uintptr_t *unitPtr);
+
+    // ClassifyUnit memoized by guid.  Entries are refreshed when UNIT_FLAG_PLAYER_CONTROLLED flips (mind control)
+    // or once they are a few seconds old, and dropped when the client frees the object
+    UnitClassification GetUnitClass(uintptr_t *unitPtr, uint64_t guid);
+
+    // UnitCanAttackUnit(gPlayerUnit, unitPtr) kept in the unit's GetUnitClass entry.  The faction check is only redone
+    // when the unit's or the active player's faction template or unit flags change, false without an active player.
+    bool PlayerCanAttackUnit(uintptr_t *unitPtr, uint64_t guid);
+
+    // called from the client's ObjectFree before the object goes away, also lets spell_visuals.hpp forget it
+    void OnObjectFree(uintptr_t *objectPtr);
+    void ClearUnitClassCache();
+    size_t UnitClassCacheSize();
+}
@@ -0,0 +1,16 @@
+#include "unit_signals.hpp"
+#include "settings.hpp"
+
+#include <cstring>
+
+namespace perf_boost {
+    bool shouldFilterGuidEvent(const char *unitName, uint32_t eventCode) {
+        // check if names starts with 0x (raw guids from super wow)
+        // don't trigger with guid for any event codes below 182 (UNIT_COMBAT)
+        // don't trigger for 183(UNIT_NAME_UPDATE), 184(UNIT_PORTRAIT_UPDATE), 186(UNIT_INVENTORY_CHANGED), 345(PLAYER_GUILD_UPDATE)
+        // this turns off UNIT_AURA, UNIT_HEALTH, UNIT_MANA spam for guids
+        return filterGuidEvents && strncmp(unitName, "0x", 2) == 0 &&
+               (eventCode < 182 || eventCode == 183 || eventCode == 184 || eventCode == 186 ||
+                eventCode == 345);
+    }
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstdint>
+
+namespace perf_boost {
+    // true if the unit event for this name should not be sent to the UI
+    bool shouldFilterGuidEvent(const char *unitName, uint32_t eventCode);
+}
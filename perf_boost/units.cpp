@@ -0,0 +1,112 @@
+#include "units.hpp"
+#include "game_view.hpp"
+
+namespace perf_boost {
+    uint32_t UnitGetLevel(uintptr_t *unit) {
+        if (!unit) {
+            return false;
+        }
+
+        auto *unitFields = UnitGetFields(unit);
+
+        if (unitFields == nullptr) {
+            // we don't have attribute info.
+            return -1;
+        }
+
+        return unitFields->level;
+    }
+
+    bool UnitIsDead(uintptr_t *unit) {
+        if (!unit) {
+            return false;
+        }
+
+        auto *unitFields = UnitGetFields(unit);
+
+        if (unitFields == nullptr) {
+            // we don't have attribute info.
+            return false;
+        }
+
+        auto health = unitFields->health;
+        auto dynamicFlags = unitFields->dynamicFlags;
+
+        if (health < 1 || (dynamicFlags & 0x20) != 0) {
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    bool UnitIsControlledByPlayer(uintptr_t *unit) {
+        if (!unit) {
+            return false;
+        }
+
+        auto *unitFields = UnitGetFields(unit);
+        if (unitFields == nullptr) {
+            // we don't have attribute info.
+            return false;
+        }
+
+        auto flags = unitFields->flags;
+
+        if ((flags & UNIT_FLAG_PLAYER_CONTROLLED) != 0) {
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    bool UnitIsInCombat(uintptr_t *unit) {
+        if (!unit) {
+            return false;
+        }
+
+        auto *unitFields = UnitGetFields(unit);
+
+        if (unitFields == nullptr) {
+            // we don't have attribute info.
+            return false;
+        }
+
+        auto flags = unitFields->flags;
+        if ((flags & UNIT_FLAG_IN_COMBAT) != 0) {
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    bool UnitIsCharmed(uintptr_t *unit) {
+        if (!unit) {
+            return false;
+        }
+
+        auto *unitFields = UnitGetFields(unit);
+
+        if (unitFields == nullptr) {
+            // we don't have attribute info.
+            return false;
+        }
+
+        return unitFields->charmedBy != 0;
+    }
+
+    bool UnitIsPvpFlagged(uintptr_t *unit) {
+        if (!unit) {
+            return false;
+        }
+
+        auto *unitFields = UnitGetFields(unit);
+
+        if (unitFields == nullptr) {
+            // we don't have attribute info.
+            return false;
+        }
+
+        auto flags = unitFields->flags;
+        return (flags & UNIT_FLAG_PVP);
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstdint>
+
+namespace perf_boost {
+    // Descriptor field queries built on top of the game view.  All of them are safe to call with a null unit or
+    // before the unit's fields have arrived.
+
+    uint32_t UnitGetLevel(uintptr_t *unit);
+    bool UnitIsDead(uintptr_t *unit);
+    bool UnitIsControlledByPlayer(uintptr_t *unit);
+    bool UnitIsInCombat(uintptr_t *unit);
+    bool UnitIsCharmed(uintptr_t *unit);
+    bool UnitIsPvpFlagged(uintptr_t *unit);
+}
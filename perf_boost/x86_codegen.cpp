@@ -0,0 +1,174 @@
+#include "x86_codegen.hpp"
+
+#include <cstring>
+
+namespace perf_boost {
+    namespace {
+        const uint8_t kOperandSizePrefix = 0x66;
+
+        bool IsSegmentPrefix(uint8_t byte) {
+            return byte == 0x26 || byte == 0x2E || byte == 0x36 || byte == 0x3E || byte == 0x64 || byte == 0x65;
+        }
+
+        // bytes taken by a modrm byte and whatever sib/displacement follows it
+        size_t ModRmLength(const uint8_t *code) {
+            uint8_t mod = code[0] >> 6;
+            uint8_t rm = code[0] & 7;
+            if (mod == 3) {
+                return 1;
+            }
+
+            size_t length = 1;
+            if (rm == 4) {
+                length += 1;
+                // sib with no base register
+                if (mod == 0 && (code[1] & 7) == 5) {
+                    length += 4;
+                }
+            } else if (mod == 0 && rm == 5) {
+                length += 4;
+            }
+
+            if (mod == 1) {
+                length += 1;
+            } else if (mod == 2) {
+                length += 4;
+            }
+            return length;
+        }
+    }
+
+    void WriteRel32(uint8_t *code, uint32_t address, uint8_t opcode, uint32_t target) {
+        auto displacement = static_cast<int32_t>(target - (address + static_cast<uint32_t>(kRel32Size)));
+        code[0] = opcode;
+        std::memcpy(code + 1, &displacement, sizeof(displacement));
+    }
+
+    uint32_t Rel32Target(const uint8_t *code, uint32_t address) {
+        int32_t displacement;
+        std::memcpy(&displacement, code + 1, sizeof(displacement));
+        // wraps like the cpu does
+        return address + static_cast<uint32_t>(kRel32Size) + static_cast<uint32_t>(displacement);
+    }
+
+    size_t X86InstructionLength(const uint8_t *code) {
+        size_t prefixes = 0;
+        size_t immediate32 = 4;
+        while (prefixes < 4 && (code[prefixes] == kOperandSizePrefix || IsSegmentPrefix(code[prefixes]))) {
+            if (code[prefixes] == kOperandSizePrefix) {
+                immediate32 = 2;
+            }
+            ++prefixes;
+        }
+
+        const uint8_t *op = code + prefixes;
+        size_t length = prefixes + 1;
+        uint8_t opcode = op[0];
+
+        // add/or/adc/sbb/and/sub/xor/cmp in their r/m, r and al/eax, imm forms
+        if (opcode < 0x40 && (opcode & 7) < 6) {
+            switch (opcode & 7) {
+                case 4:
+                    return length + 1;
+                case 5:
+                    return length + immediate32;
+                default:
+                    return length + ModRmLength(op + 1);
+            }
+        }
+
+        if ((opcode >= 0x40 && opcode <= 0x61) || (opcode >= 0x90 && opcode <= 0x99) || opcode == 0x9C ||
+            opcode == 0x9D || opcode == kInt3Opcode) {
+            return length;
+        }
+        if (opcode == 0x6A || opcode == 0xA8 || (opcode >= 0xB0 && opcode <= 0xB7)) {
+            return length + 1;
+        }
+        if (opcode == 0x68 || opcode == 0xA9 || (opcode >= 0xB8 && opcode <= 0xBF)) {
+            return length + immediate32;
+        }
+        if (opcode >= 0xA0 && opcode <= 0xA3) {
+            return length + 4;
+        }
+        if (opcode == kCallRel32Opcode || opcode == kJmpRel32Opcode) {
+            // rel16 with an operand size prefix, never seen in practice
+            return prefixes == 0 ? length + 4 : 0;
+        }
+
+        switch (opcode) {
+            case 0x84: // test
+            case 0x85:
+            case 0x86: // xchg
+            case 0x87:
+            case 0x88: // mov
+            case 0x89:
+            case 0x8A:
+            case 0x8B:
+            case 0x8D: // lea
+            case 0xD1: // shifts by 1 and cl
+            case 0xD3:
+                return length + ModRmLength(op + 1);
+            case 0x80:
+            case 0x83:
+            case 0xC0:
+            case 0xC1:
+            case 0xC6:
+            case 0x6B:
+                return length + ModRmLength(op + 1) + 1;
+            case 0x81:
+            case 0xC7:
+            case 0x69:
+                return length + ModRmLength(op + 1) + immediate32;
+            case 0xF6:
+            case 0xF7: {
+                // only test has an immediate
+                bool test = ((op[1] >> 3) & 7) == 0;
+                size_t immediate = test ? (opcode == 0xF6 ? 1 : immediate32) : 0;
+                return length + ModRmLength(op + 1) + immediate;
+            }
+            case 0xFF: {
+                // inc, dec, push and indirect call/jmp, all absolute
+                uint8_t reg = (op[1] >> 3) & 7;
+                return reg == 7 ? 0 : length + ModRmLength(op + 1);
+            }
+            case 0x0F:
+                // movzx/movsx
+                if (op[1] == 0xB6 || op[1] == 0xB7 || op[1] == 0xBE || op[1] == 0xBF) {
+                    return length + 1 + ModRmLength(op + 2);
+                }
+                return 0;
+            default:
+                return 0;
+        }
+    }
+
+    size_t BuildTrampoline(const uint8_t *function, uint32_t functionAddress, uint8_t *trampoline,
+                           uint32_t trampolineAddress) {
+        size_t stolen = 0;
+        while (stolen < kRel32Size) {
+            size_t length = X86InstructionLength(function + stolen);
+            if (length == 0 || stolen + length > kMaxStolenBytes) {
+                return 0;
+            }
+
+            uint8_t opcode = function[stolen];
+            if (opcode == kCallRel32Opcode || opcode == kJmpRel32Opcode) {
+                uint32_t target = Rel32Target(function + stolen, functionAddress + stolen);
+                WriteRel32(trampoline + stolen, trampolineAddress + stolen, opcode, target);
+            } else {
+                std::memcpy(trampoline + stolen, function + stolen, length);
+            }
+            stolen += length;
+        }
+
+        WriteRel32(trampoline + stolen, trampolineAddress + stolen, kJmpRel32Opcode, functionAddress + stolen);
+        return stolen;
+    }
+
+    void WriteDetourJump(uint8_t *function, uint32_t functionAddress, uint32_t handler, size_t stolen) {
+        WriteRel32(function, functionAddress, kJmpRel32Opcode, handler);
+        if (stolen > kRel32Size) {
+            std::memset(function + kRel32Size, kInt3Opcode, stolen - kRel32Size);
+        }
+    }
+}
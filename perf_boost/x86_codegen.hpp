@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace perf_boost {
+    // Just enough 32 bit x86 to move the first instructions of a client function into a trampoline and jump over
+    // them, see detour.hpp.  Like call_site.hpp the bytes are passed separately from their address so everything
+    // can be tested on buffers on the host.
+
+    const uint8_t kCallRel32Opcode = 0xE8;
+    const uint8_t kJmpRel32Opcode = 0xE9;
+    const uint8_t kInt3Opcode = 0xCC;
+    const size_t kRel32Size = 5;
+    // whole instructions moved out of the way of the jump, its last byte can start an instruction of up to 15 bytes
+    const size_t kMaxStolenBytes = kRel32Size - 1 + 15;
+    const size_t kMaxTrampolineSize = kMaxStolenBytes + kRel32Size;
+
+    // opcode followed by the displacement to target from the end of the instruction
+    void WriteRel32(uint8_t *code, uint32_t address, uint8_t opcode, uint32_t target);
+    uint32_t Rel32Target(const uint8_t *code, uint32_t address);
+
+    // length of the instruction at code, 0 if it isn't one we know how to move.  Covers what compilers put at the
+    // start of functions (stack frame setup, register saves, moves, arithmetic, calls) but no short or conditional
+    // branches since their targets would be left behind.
+    size_t X86InstructionLength(const uint8_t *code);
+
+    // copies the instructions covering the first kRel32Size bytes of function into trampoline followed by a jmp back,
+    // relocating any call or jmp rel32 among them.  trampoline must hold kMaxTrampolineSize bytes.  Returns how many
+    // bytes of function were copied, 0 if the start of function can't be moved.
+    size_t BuildTrampoline(const uint8_t *function, uint32_t functionAddress, uint8_t *trampoline,
+                           uint32_t trampolineAddress);
+
+    // jmp to handler over the first stolen bytes of function, the rest filled with int3
+    void WriteDetourJump(uint8_t *function, uint32_t functionAddress, uint32_t handler, size_t stolen);
+}
@@ -0,0 +1,115 @@
+#include "zone_context.hpp"
+#include "game_view.hpp"
+#include "logging.hpp"
+#include "settings.hpp"
+
+#include <algorithm>
+
+namespace perf_boost {
+    namespace {
+        struct AreaContext {
+            uint32_t areaId;
+            ZONE_CONTEXT context;
+        };
+
+        // zone ids from AreaTable.dbc, sorted by id
+        const AreaContext kAreaContexts[] = {
+                {75,   ZONE_CONTEXT_CITY},          // Stonard
+                {209,  ZONE_CONTEXT_DUNGEON},       // Shadowfang Keep
+                {491,  ZONE_CONTEXT_DUNGEON},       // Razorfen Kraul
+                {717,  ZONE_CONTEXT_DUNGEON},       // The Stockade
+                {718,  ZONE_CONTEXT_DUNGEON},       // Wailing Caverns
+                {719,  ZONE_CONTEXT_DUNGEON},       // Blackfathom Deeps
+                {721,  ZONE_CONTEXT_DUNGEON},       // Gnomeregan
+                {722,  ZONE_CONTEXT_DUNGEON},       // Razorfen Downs
+                {796,  ZONE_CONTEXT_DUNGEON},       // Scarlet Monastery
+                {1176, ZONE_CONTEXT_DUNGEON},       // Zul'Farrak
+                {1337, ZONE_CONTEXT_DUNGEON},       // Uldaman
+                {1477, ZONE_CONTEXT_DUNGEON},       // Sunken Temple
+                {1497, ZONE_CONTEXT_CITY},          // Undercity
+                {1519, ZONE_CONTEXT_CITY},          // Stormwind City
+                {1537, ZONE_CONTEXT_CITY},          // Ironforge
+                {1581, ZONE_CONTEXT_DUNGEON},       // The Deadmines
+                {1583, ZONE_CONTEXT_DUNGEON},       // Blackrock Spire
+                {1584, ZONE_CONTEXT_DUNGEON},       // Blackrock Depths
+                {1637, ZONE_CONTEXT_CITY},          // Orgrimmar
+                {1638, ZONE_CONTEXT_CITY},          // Thunder Bluff
+                {1657, ZONE_CONTEXT_CITY},          // Darnassus
+                {1977, ZONE_CONTEXT_RAID},          // Zul'Gurub
+                {2017, ZONE_CONTEXT_DUNGEON},       // Stratholme
+                {2040, ZONE_CONTEXT_CITY},          // Alah'Thalas
+                {2057, ZONE_CONTEXT_DUNGEON},       // Scholomance
+                {2100, ZONE_CONTEXT_DUNGEON},       // Maraudon
+                {2159, ZONE_CONTEXT_RAID},          // Onyxia's Lair
+                {2437, ZONE_CONTEXT_DUNGEON},       // Ragefire Chasm
+                {2557, ZONE_CONTEXT_DUNGEON},       // Dire Maul
+                {2597, ZONE_CONTEXT_BATTLEGROUND},  // Alterac Valley
+                {2677, ZONE_CONTEXT_RAID},          // Blackwing Lair
+                {2717, ZONE_CONTEXT_RAID},          // Molten Core
+                {3277, ZONE_CONTEXT_BATTLEGROUND},  // Warsong Gulch
+                {3358, ZONE_CONTEXT_BATTLEGROUND},  // Arathi Basin
+                {3428, ZONE_CONTEXT_RAID},          // Ahn'Qiraj
+                {3429, ZONE_CONTEXT_RAID},          // Ruins of Ahn'Qiraj
+                {3456, ZONE_CONTEXT_RAID},          // Naxxramas
+        };
+
+        const char *kZoneContextNames[ZONE_CONTEXT_COUNT] = {"outdoor", "city", "dungeon", "raid", "battleground"};
+
+        ZoneState currentZone;
+        uint32_t zoneSettingsVersion = ~0u;
+    }
+
+    ZONE_CONTEXT ClassifyArea(uint32_t areaId) {
+        for (const auto &entry: zoneContextOverrides) {
+            if (entry.first == areaId) {
+                return entry.second;
+            }
+        }
+
+        auto end = std::end(kAreaContexts);
+        auto it = std::lower_bound(std::begin(kAreaContexts), end, areaId,
+                                   [](const AreaContext &entry, uint32_t id) { return entry.areaId < id; });
+        return it != end && it->areaId == areaId ? it->context : ZONE_CONTEXT_OUTDOOR;
+    }
+
+    const char *ZoneContextName(ZONE_CONTEXT context) {
+        return context >= 0 && context < ZONE_CONTEXT_COUNT ? kZoneContextNames[context] : "unknown";
+    }
+
+    bool ParseZoneContext(const std::string &name, ZONE_CONTEXT &context) {
+        for (int i = 0; i < ZONE_CONTEXT_COUNT; ++i) {
+            if (name == kZoneContextNames[i]) {
+                context = static_cast<ZONE_CONTEXT>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const ZoneState &CurrentZone() {
+        return currentZone;
+    }
+
+    bool UpdateZoneContext() {
+        auto areaId = GetZoneAreaId();
+        if (areaId == currentZone.areaId && zoneSettingsVersion == gSettingsVersion) {
+            return false;
+        }
+        zoneSettingsVersion = gSettingsVersion;
+
+        auto context = ClassifyArea(areaId);
+        if (areaId == currentZone.areaId && context == currentZone.context) {
+            return false;
+        }
+
+        currentZone.areaId = areaId;
+        currentZone.context = context;
+        DEBUG_LOG("Zone changed to " << areaId << " (" << ZoneContextName(context) << ")");
+        return true;
+    }
+
+    void ResetZoneContext() {
+        currentZone = ZoneState();
+        zoneSettingsVersion = ~0u;
+    }
+}
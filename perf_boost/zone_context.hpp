@@ -0,0 +1,29 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace perf_boost {
+    // Tracks which zone the player is in and what kind of place it is.  BeginFrame polls the zone once per frame but
+    // everything depending on it only runs when the zone or its classification actually changed.
+
+    struct ZoneState {
+        uint32_t areaId = 0;
+        ZONE_CONTEXT context = ZONE_CONTEXT_OUTDOOR;
+    };
+
+    // PB_ZoneContexts entries first, then the built in table of cities, dungeons, raids and battlegrounds
+    ZONE_CONTEXT ClassifyArea(uint32_t areaId);
+
+    // "outdoor", "city", "dungeon", "raid" or "battleground"
+    const char *ZoneContextName(ZONE_CONTEXT context);
+    bool ParseZoneContext(const std::string &name, ZONE_CONTEXT &context);
+
+    const ZoneState &CurrentZone();
+
+    // true when the zone or its classification changed since the last call
+    bool UpdateZoneContext();
+    void ResetZoneContext();
+}
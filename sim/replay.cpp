@@ -0,0 +1,285 @@
+#include "replay.hpp"
+#include "render.hpp"
+#include "settings.hpp"
+#include "spell_visuals.hpp"
+#include "unit_signals.hpp"
+
+#include <chrono>
+#include <cstring>
+
+namespace perf_boost {
+    namespace sim {
+        namespace {
+            class ScopedTimer {
+            public:
+                explicit ScopedTimer(ReplayCounter &counter)
+                        : mCounter(counter), mStart(std::chrono::steady_clock::now()) {}
+
+                ~ScopedTimer() {
+                    auto elapsed = std::chrono::steady_clock::now() - mStart;
+                    mCounter.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+                    ++mCounter.calls;
+                }
+
+            private:
+                ReplayCounter &mCounter;
+                std::chrono::steady_clock::time_point mStart;
+            };
+
+            template<typename F>
+            bool Timed(ReplayCounter &counter, F decide) {
+                bool hidden;
+                {
+                    ScopedTimer timer(counter);
+                    hidden = decide();
+                }
+                if (hidden) {
+                    ++counter.hidden;
+                }
+                return hidden;
+            }
+        }
+
+        bool Replayer::Replay(const std::string &path) {
+            TraceReader reader;
+            if (!reader.Open(path)) {
+                return false;
+            }
+
+            Begin();
+            TraceRecord record;
+            while (reader.Next(record)) {
+                Apply(record);
+            }
+            End();
+
+            return !reader.failed();
+        }
+
+        void Replayer::Begin() {
+            mWorld.Reset();
+            applyDefaultSettings();
+            gPlayerUnit = nullptr;
+            gPlayerPosition = C3Vector();
+            gPlayerInCombat = false;
+            gPlayerInCity = false;
+            gViewFromCamera = false;
+
+            mStats = ReplayStats();
+            mDecisions.clear();
+            mGameObject = TraceGameObjectRecord();
+            mInFrame = false;
+
+            for (const auto &entry: mOverrides) {
+                updateFromCvar(entry.first.c_str(), entry.second.c_str());
+            }
+        }
+
+        void Replayer::End() {
+            if (mInFrame) {
+                EndFrame();
+                mInFrame = false;
+            }
+        }
+
+        void Replayer::Apply(const TraceRecord &record) {
+            ++mStats.records;
+
+            switch (record.type) {
+                case TraceRecordType::Frame: {
+                    End();
+
+                    auto &frame = record.frame;
+                    auto *player = mWorld.Find(frame.playerGuid);
+                    if (!player) {
+                        player = &mWorld.SetActivePlayer(frame.playerGuid, frame.position);
+                    }
+                    player->position = frame.position;
+                    player->unitFields.flags = frame.playerFlags;
+                    player->unitFields.level = frame.playerLevel;
+                    player->unitFields.target = frame.playerTarget;
+                    mWorld.SetZoneAreaId(frame.zoneAreaId);
+                    mWorld.SetTime(frame.timeMs);
+                    // only set again if the Camera record follows
+                    mWorld.ClearCamera();
+
+                    ++mStats.frames;
+                    BeginFrame();
+                    mInFrame = true;
+                    break;
+                }
+                case TraceRecordType::Camera:
+                    mWorld.SetCamera(record.camera.position, record.camera.forward);
+                    // recorded right after the live BeginFrame read the camera
+                    UpdateView();
+                    break;
+                case TraceRecordType::RaidMarks:
+                    for (int mark = 1; mark <= 8; ++mark) {
+                        mWorld.SetRaidMark(mark, record.raidTargets[mark - 1]);
+                    }
+                    // recorded right after the live BeginFrame took its snapshot
+                    SnapshotRaidMarks();
+                    break;
+                case TraceRecordType::ShouldRender: {
+                    auto &unit = ApplyUnit(record.unit);
+                    if (record.unit.bits & TRACE_UNIT_SNAPSHOT) {
+                        break;
+                    }
+
+                    uint32_t clientResult = (record.unit.bits & TRACE_UNIT_CLIENT_RESULT) ? 1 : 0;
+                    uint32_t result = 0;
+                    Timed(mStats.shouldRender, [&]() {
+                        result = shouldRenderObject(unit.ptr(), clientResult);
+                        return result == 0;
+                    });
+                    if ((result != 0) != (clientResult != 0)) {
+                        ++mStats.changedByPerfBoost;
+                    }
+                    mDecisions.push_back(result != 0 ? 1 : 0);
+                    break;
+                }
+                case TraceRecordType::Group:
+                    mWorld.SetGroup(record.group);
+                    break;
+                case TraceRecordType::GameObject:
+                    mGameObject = record.gameObject;
+                    break;
+                case TraceRecordType::UnitName: {
+                    auto *object = mWorld.Find(record.nameGuid);
+                    if (!object) {
+                        object = &mWorld.AddPlayer(record.nameGuid, "", C3Vector());
+                    }
+                    object->name = record.name;
+                    break;
+                }
+                case TraceRecordType::Visual:
+                    ApplyVisual(record.visual);
+                    break;
+                case TraceRecordType::UnitSignal:
+                    Timed(mStats.unitSignal, [&]() {
+                        return shouldFilterGuidEvent(record.name.c_str(), record.signal.eventCode);
+                    });
+                    break;
+                case TraceRecordType::CVar:
+                    ApplyCVar(record.name, record.value);
+                    break;
+            }
+        }
+
+        SimObject &Replayer::ApplyUnit(const TraceUnitRecord &unit) {
+            auto type = static_cast<OBJECT_TYPE_ID>(unit.type);
+            auto *object = mWorld.Find(unit.guid);
+            if (!object || object->type != type) {
+                switch (type) {
+                    case OBJECT_TYPE_PLAYER:
+                        object = &mWorld.AddPlayer(unit.guid, object ? object->name.c_str() : "", unit.position);
+                        break;
+                    case OBJECT_TYPE_CORPSE:
+                        object = &mWorld.AddCorpse(unit.guid, unit.position);
+                        break;
+                    case OBJECT_TYPE_GAMEOBJECT:
+                        object = &mWorld.AddGameObject(unit.guid, GAMEOBJECT_TYPE_MAX, unit.position);
+                        break;
+                    default:
+                        object = &mWorld.AddUnit(unit.guid, unit.level, unit.position);
+                        object->type = type;
+                        break;
+                }
+            }
+
+            object->position = unit.position;
+            object->hostile = (unit.bits & TRACE_UNIT_ATTACKABLE) != 0;
+            object->corpseOwner = unit.owner;
+
+            if (type == OBJECT_TYPE_GAMEOBJECT) {
+                // traces before version 3 have no GameObject records, those objects are never hidden
+                object->gameObjectFieldsLoaded =
+                        (unit.bits & TRACE_UNIT_FIELDS_LOADED) != 0 && mGameObject.guid == unit.guid;
+                auto &gameObjectFields = object->gameObjectFields;
+                gameObjectFields.typeId = mGameObject.typeId;
+                gameObjectFields.dynamicFlags = mGameObject.dynamicFlags;
+                gameObjectFields.createdBy = mGameObject.createdBy;
+                gameObjectFields.position = unit.position;
+                mGameObject = TraceGameObjectRecord();
+                return *object;
+            }
+            object->unitFieldsLoaded = (unit.bits & TRACE_UNIT_FIELDS_LOADED) != 0;
+
+            auto &fields = object->unitFields;
+            fields.flags = unit.flags;
+            fields.level = unit.level;
+            fields.health = unit.health;
+            fields.maxHealth = unit.maxHealth;
+            fields.dynamicFlags = unit.dynamicFlags;
+            fields.summonedBy = unit.summonedBy;
+            fields.petNameTimestamp = unit.petNameTimestamp;
+            fields.target = unit.target;
+            fields.bytes0 = unit.bytes0;
+            // the trace only keeps whether the unit is charmed, not by whom
+            fields.charmedBy = (unit.bits & TRACE_UNIT_CHARMED) ? 1 : 0;
+            return *object;
+        }
+
+        void Replayer::ApplyVisual(const TraceVisualRecord &visual) {
+            auto *spellRec = mWorld.GetSpell(visual.spellId);
+            if (!spellRec) {
+                auto &spell = mWorld.AddSpell(visual.spellId);
+                if (visual.spellFlags & TRACE_SPELL_GROUND_EFFECT) {
+                    spell.Effect[0] = 27;
+                }
+                spellRec = &spell;
+            }
+
+            if (visual.kind == TraceVisualKind::DynamicObject) {
+                auto *dynamicObject = mWorld.Find(visual.objectGuid);
+                if (!dynamicObject || dynamicObject->type != OBJECT_TYPE_DYNAMICOBJECT) {
+                    dynamicObject = &mWorld.AddDynamicObject(visual.objectGuid, visual.casterGuid, visual.spellId,
+                                                             C3Vector());
+                }
+                dynamicObject->dynamicObjectFields.m_caster = visual.casterGuid;
+                dynamicObject->dynamicObjectFields.m_spellID = visual.spellId;
+
+                Timed(mStats.dynamicObjectVisual, [&]() {
+                    return shouldHideDynamicObjectVisual(dynamicObject->ptr());
+                });
+                return;
+            }
+
+            auto *caster = mWorld.Find(visual.casterGuid);
+            if (!caster) {
+                ++mStats.missingCasters;
+                return;
+            }
+
+            switch (visual.kind) {
+                case TraceVisualKind::Spell:
+                    Timed(mStats.spellVisual, [&]() { return shouldHideSpellForUnit(caster->ptr(), spellRec); });
+                    break;
+                case TraceVisualKind::GroundEffect:
+                    Timed(mStats.groundEffect, [&]() {
+                        return shouldHideGroundEffectForUnit(caster->ptr(), spellRec);
+                    });
+                    break;
+                case TraceVisualKind::Aura:
+                    Timed(mStats.auraVisual, [&]() { return shouldHideAuraEffectForUnit(caster->ptr(), spellRec); });
+                    break;
+                case TraceVisualKind::Channel:
+                    caster->unitFields.channelSpell = visual.spellId;
+                    Timed(mStats.channelVisual, [&]() { return shouldHideChannelVisual(caster->ptr()); });
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void Replayer::ApplyCVar(const std::string &cvar, const std::string &value) {
+            // turning the capture on and off is recorded too, never act on it
+            if (cvar == "PB_CaptureTrace") {
+                return;
+            }
+
+            auto it = mOverrides.find(cvar);
+            updateFromCvar(cvar.c_str(), it != mOverrides.end() ? it->second.c_str() : value.c_str());
+        }
+    }
+}
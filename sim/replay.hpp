@@ -0,0 +1,68 @@
+#pragma once
+
+#include "sim_object_manager.hpp"
+#include "trace.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace perf_boost {
+    namespace sim {
+        struct ReplayCounter {
+            uint64_t calls = 0;
+            uint64_t hidden = 0;       // ShouldRender returned 0, a visual was hidden or an event filtered
+            uint64_t nanoseconds = 0;  // time spent in the core, including timer overhead
+        };
+
+        struct ReplayStats {
+            uint64_t records = 0;
+            uint64_t frames = 0;
+            uint64_t changedByPerfBoost = 0; // ShouldRender answers that differ from the client's own
+            uint64_t missingCasters = 0;     // visuals whose caster was never seen, skipped
+
+            ReplayCounter shouldRender;
+            ReplayCounter spellVisual;
+            ReplayCounter groundEffect;
+            ReplayCounter auraVisual;
+            ReplayCounter channelVisual;
+            ReplayCounter dynamicObjectVisual;
+            ReplayCounter unitSignal;
+        };
+
+        // Feeds a trace written by StartTraceCapture through perf_boost_core against the simulated object manager,
+        // recreating each object from its recorded state right before the query that used it.
+        class Replayer {
+        public:
+            explicit Replayer(SimObjectManager &world) : mWorld(world) {}
+
+            // applied at the start and in place of any recorded value for the same cvar, to try other settings
+            void SetOverride(const std::string &cvar, const std::string &value) { mOverrides[cvar] = value; }
+
+            // resets the world and settings, false if the trace couldn't be opened or is truncated
+            bool Replay(const std::string &path);
+
+            void Begin();
+            void Apply(const TraceRecord &record);
+            void End();
+
+            const ReplayStats &stats() const { return mStats; }
+            // every ShouldRender answer in trace order
+            const std::vector<uint8_t> &decisions() const { return mDecisions; }
+
+        private:
+            SimObject &ApplyUnit(const TraceUnitRecord &unit);
+            void ApplyVisual(const TraceVisualRecord &visual);
+            void ApplyCVar(const std::string &cvar, const std::string &value);
+
+            SimObjectManager &mWorld;
+            std::map<std::string, std::string> mOverrides;
+            ReplayStats mStats;
+            std::vector<uint8_t> mDecisions;
+            // applied by the ShouldRender record that follows it
+            TraceGameObjectRecord mGameObject;
+            bool mInFrame = false;
+        };
+    }
+}
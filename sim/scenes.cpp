@@ -0,0 +1,111 @@
+#include "scenes.hpp"
+
+#include <cmath>
+#include <sstream>
+
+namespace perf_boost {
+    namespace sim {
+        namespace {
+            // small LCG so scenes are identical across platforms and standard libraries
+            class Random {
+            public:
+                explicit Random(uint32_t seed) : mState(seed) {}
+
+                float Next() {
+                    mState = mState * 1664525u + 1013904223u;
+                    return (mState >> 8) / 16777216.0f;
+                }
+
+                C3Vector InDisc(float radius) {
+                    float angle = Next() * 6.2831853f;
+                    float r = radius * std::sqrt(Next());
+                    C3Vector position;
+                    position.x = r * std::cos(angle);
+                    position.y = r * std::sin(angle);
+                    position.z = (Next() - 0.5f) * 4.0f;
+                    return position;
+                }
+
+            private:
+                uint32_t mState;
+            };
+        }
+
+        std::vector<SimObject *> BuildRaidStack(SimObjectManager &world, uint32_t seed) {
+            Random random(seed);
+            std::vector<SimObject *> objects;
+
+            world.Reset();
+            world.SetActivePlayer(1, C3Vector()).unitFields.flags |= UNIT_FLAG_IN_COMBAT;
+
+            uint64_t guid = 100;
+            for (int i = 0; i < 39; ++i) {
+                std::string name = "Raider" + std::to_string(i);
+                auto &raider = world.AddPlayer(guid++, name.c_str(), random.InDisc(15.0f));
+                raider.unitFields.flags |= UNIT_FLAG_IN_COMBAT;
+                objects.push_back(&raider);
+
+                // a hunter/warlock pet for every 5th raider, a totem for every 8th
+                if (i % 5 == 0 || i % 8 == 0) {
+                    auto &summon = world.AddUnit(guid++, 60, random.InDisc(15.0f));
+                    summon.unitFields.flags = UNIT_FLAG_PLAYER_CONTROLLED;
+                    summon.unitFields.summonedBy = raider.guid;
+                    summon.unitFields.petNameTimestamp = i % 5 == 0 ? 1 : 0;
+                    objects.push_back(&summon);
+                }
+            }
+
+            auto &boss = world.AddUnit(guid++, 63, random.InDisc(5.0f));
+            boss.creatureEntry = 16028; // Patchwerk
+            boss.creatureRank = CREATURE_RANK_WORLDBOSS;
+            boss.unitFields.maxHealth = boss.unitFields.health = 4322950;
+            objects.push_back(&boss);
+            world.SetRaidMark(8, boss.guid);
+
+            // elite packs of a few kinds, up to level 63 like the Naxxramas trash
+            for (int i = 0; i < 30; ++i) {
+                auto &trash = world.AddUnit(guid++, 61 + i % 3, random.InDisc(80.0f));
+                trash.creatureEntry = 16017 + i % 3;
+                trash.creatureRank = CREATURE_RANK_ELITE;
+                trash.unitFields.maxHealth = trash.unitFields.health = 120000;
+                objects.push_back(&trash);
+            }
+
+            return objects;
+        }
+
+        std::vector<SimObject *> BuildCity(SimObjectManager &world, int numPlayers, uint32_t seed) {
+            Random random(seed);
+            std::vector<SimObject *> objects;
+
+            world.Reset();
+            world.SetActivePlayer(1, C3Vector());
+            world.SetZoneAreaId(1537); // Ironforge
+
+            uint64_t guid = 100;
+            for (int i = 0; i < numPlayers; ++i) {
+                std::string name = "Citizen" + std::to_string(i);
+                auto &player = world.AddPlayer(guid++, name.c_str(), random.InDisc(120.0f));
+                if (i % 10 == 0) {
+                    player.unitFields.flags |= UNIT_FLAG_PVP;
+                    // a few enemy players wandering through
+                    player.hostile = i % 20 == 0;
+                }
+                objects.push_back(&player);
+            }
+
+            return objects;
+        }
+
+        std::string BuildSpellIdList(int count, uint32_t firstId, uint32_t step) {
+            std::ostringstream ss;
+            for (int i = 0; i < count; ++i) {
+                if (i > 0) {
+                    ss << ",";
+                }
+                ss << firstId + i * step;
+            }
+            return ss.str();
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "sim_object_manager.hpp"
+
+#include <string>
+#include <vector>
+
+namespace perf_boost {
+    namespace sim {
+        // Synthetic scenes shared by the tests and benchmarks.  All of them reset the world first, place the active
+        // player (guid 1) at the origin and are deterministic for a given seed.
+
+        // 39 other raid members, their pets and totems stacked within ~15 yards, a world boss and 30 level 61-63
+        // elite trash mobs spread out to 80 yards
+        std::vector<SimObject *> BuildRaidStack(SimObjectManager &world, uint32_t seed = 1);
+
+        // players spread uniformly over a 120 yard radius around the player, e.g. the Ironforge bank
+        std::vector<SimObject *> BuildCity(SimObjectManager &world, int numPlayers, uint32_t seed = 1);
+
+        // comma separated spell ids firstId, firstId + step, ...
+        std::string BuildSpellIdList(int count, uint32_t firstId, uint32_t step = 1);
+    }
+}
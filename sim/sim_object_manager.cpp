@@ -0,0 +1,248 @@
+#include "sim_object_manager.hpp"
+#include "animation_lod.hpp"
+#include "creatures.hpp"
+#include "game_view.hpp"
+#include "importance.hpp"
+#include "net_stats.hpp"
+#include "render_schedule.hpp"
+#include "spell_visuals.hpp"
+#include "unit_cache.hpp"
+#include "zone_context.hpp"
+
+#include <algorithm>
+
+namespace perf_boost {
+    namespace sim {
+        SimObjectManager &SimObjectManager::Instance() {
+            static SimObjectManager instance;
+            return instance;
+        }
+
+        void SimObjectManager::Reset() {
+            mObjects.clear();
+            ClearUnitClassCache();
+            ClearCreatureClassCache();
+            ResetZoneContext();
+            ResetNetStats();
+            ResetImportance();
+            ResetRenderSchedule();
+            ResetGroundEffects();
+            ResetAnimationLod();
+            mSpells.clear();
+            mActivePlayerGuid = 0;
+            for (auto &guid: mRaidTargets) {
+                guid = 0;
+            }
+            mZoneAreaId = 0;
+            mAttackChecks = 0;
+            mSpellLookups = 0;
+            mHasCamera = false;
+            mGroup.clear();
+            mTimeMs = 100000;
+        }
+
+        SimObject &SimObjectManager::Add(uint64_t guid, OBJECT_TYPE_ID type, const C3Vector &position) {
+            auto &slot = mObjects[guid];
+            if (slot) {
+                OnObjectFree(slot->ptr());
+            }
+            slot.reset(new SimObject());
+            slot->type = type;
+            slot->guid = guid;
+            slot->position = position;
+            slot->unitFields.health = 1;
+            slot->unitFields.maxHealth = 1;
+            slot->unitFields.level = 60;
+            return *slot;
+        }
+
+        SimObject &SimObjectManager::AddPlayer(uint64_t guid, const char *name, const C3Vector &position) {
+            auto &object = Add(guid, OBJECT_TYPE_PLAYER, position);
+            object.name = name;
+            object.unitFields.flags = UNIT_FLAG_PLAYER_CONTROLLED;
+            return object;
+        }
+
+        SimObject &SimObjectManager::AddUnit(uint64_t guid, uint32_t level, const C3Vector &position) {
+            auto &object = Add(guid, OBJECT_TYPE_UNIT, position);
+            object.unitFields.level = level;
+            return object;
+        }
+
+        SimObject &SimObjectManager::AddCorpse(uint64_t guid, const C3Vector &position) {
+            auto &object = Add(guid, OBJECT_TYPE_CORPSE, position);
+            object.unitFieldsLoaded = false;
+            return object;
+        }
+
+        SimObject &SimObjectManager::AddDynamicObject(uint64_t guid, uint64_t caster, int32_t spellId,
+                                                      const C3Vector &position) {
+            auto &object = Add(guid, OBJECT_TYPE_DYNAMICOBJECT, position);
+            object.unitFieldsLoaded = false;
+            object.dynamicObjectFields.m_caster = caster;
+            object.dynamicObjectFields.m_spellID = spellId;
+            object.dynamicObjectFields.m_position = position;
+            return object;
+        }
+
+        SimObject &SimObjectManager::AddGameObject(uint64_t guid, GameObjectType type, const C3Vector &position) {
+            auto &object = Add(guid, OBJECT_TYPE_GAMEOBJECT, position);
+            object.unitFieldsLoaded = false;
+            object.gameObjectFields.typeId = type;
+            object.gameObjectFields.position = position;
+            return object;
+        }
+
+        void SimObjectManager::Remove(uint64_t guid) {
+            auto it = mObjects.find(guid);
+            if (it != mObjects.end()) {
+                // like the client, caches hear about the object before it is gone
+                OnObjectFree(it->second->ptr());
+                mObjects.erase(it);
+            }
+        }
+
+        SimObject *SimObjectManager::Find(uint64_t guid) {
+            auto it = mObjects.find(guid);
+            return it != mObjects.end() ? it->second.get() : nullptr;
+        }
+
+        SimObject &SimObjectManager::SetActivePlayer(uint64_t guid, const C3Vector &position) {
+            auto &player = AddPlayer(guid, "Me", position);
+            mActivePlayerGuid = guid;
+            return player;
+        }
+
+        void SimObjectManager::SetRaidMark(int mark, uint64_t guid) {
+            mRaidTargets[mark - 1] = guid;
+        }
+
+        SpellRec &SimObjectManager::AddSpell(uint32_t spellId) {
+            auto &slot = mSpells[spellId];
+            slot.reset(new SpellRec());
+            slot->Id = spellId;
+            return *slot;
+        }
+
+        const SpellRec *SimObjectManager::GetSpell(uint32_t spellId) const {
+            auto it = mSpells.find(spellId);
+            return it != mSpells.end() ? it->second.get() : nullptr;
+        }
+    }
+
+    // game_view.hpp implemented against the simulated object manager
+
+    std::uint64_t ClntObjMgrGetActivePlayerGuid() {
+        return sim::SimObjectManager::Instance().activePlayerGuid();
+    }
+
+    uintptr_t *GetObjectPtr(std::uint64_t guid) {
+        auto object = sim::SimObjectManager::Instance().Find(guid);
+        return object ? object->ptr() : nullptr;
+    }
+
+    uintptr_t *ClntObjMgrObjectPtr(OBJECT_TYPE_MASK typeMask, std::uint64_t guid) {
+        auto object = sim::SimObjectManager::Instance().Find(guid);
+        if (!object) {
+            return nullptr;
+        }
+
+        // players are units too
+        bool matches = (typeMask & (1 << object->type)) != 0 ||
+                       (object->type == OBJECT_TYPE_PLAYER && (typeMask & TYPE_MASK_UNIT) != 0);
+        return matches ? object->ptr() : nullptr;
+    }
+
+    OBJECT_TYPE_ID UnitGetType(uintptr_t *unit) {
+        return sim::SimObjectManager::Instance().FromPtr(unit)->type;
+    }
+
+    uint64_t UnitGetGuid(uintptr_t *unit) {
+        if (!unit) {
+            return 0;
+        }
+        return sim::SimObjectManager::Instance().FromPtr(unit)->guid;
+    }
+
+    C3Vector UnitGetPosition(uintptr_t *unit) {
+        if (!unit) {
+            return C3Vector();
+        }
+        return sim::SimObjectManager::Instance().FromPtr(unit)->position;
+    }
+
+    UnitFields *UnitGetFields(uintptr_t *unit) {
+        auto object = sim::SimObjectManager::Instance().FromPtr(unit);
+        return object->unitFieldsLoaded ? &object->unitFields : nullptr;
+    }
+
+    char *UnitGetName(uintptr_t *unit) {
+        if (!unit) {
+            return nullptr;
+        }
+        auto object = sim::SimObjectManager::Instance().FromPtr(unit);
+        return object->name.empty() ? nullptr : &object->name[0];
+    }
+
+    bool UnitCanAttackUnit(uintptr_t *unit1, uintptr_t *unit2) {
+        if (unit1 == nullptr || unit2 == nullptr) {
+            return false;
+        }
+
+        // the sim has no faction table, hostility is set per object and seen the same way by everyone
+        auto &world = sim::SimObjectManager::Instance();
+        world.CountAttackCheck();
+        return world.FromPtr(unit2)->hostile;
+    }
+
+    uint32_t UnitGetCreatureEntry(uintptr_t *unit) {
+        return unit ? sim::SimObjectManager::Instance().FromPtr(unit)->creatureEntry : 0;
+    }
+
+    CreatureRank UnitGetCreatureRank(uintptr_t *unit) {
+        return unit ? sim::SimObjectManager::Instance().FromPtr(unit)->creatureRank : CREATURE_RANK_UNKNOWN;
+    }
+
+    DynamicObjectFields *DynamicObjectGetFields(uintptr_t *dynamicObj) {
+        auto object = sim::SimObjectManager::Instance().FromPtr(dynamicObj);
+        return object->dynamicObjectFieldsLoaded ? &object->dynamicObjectFields : nullptr;
+    }
+
+    uint64_t CorpseGetOwnerGuid(uintptr_t *corpse) {
+        return sim::SimObjectManager::Instance().FromPtr(corpse)->corpseOwner;
+    }
+
+    GameObjectFields *GameObjectGetFields(uintptr_t *gameObject) {
+        auto object = sim::SimObjectManager::Instance().FromPtr(gameObject);
+        return object->gameObjectFieldsLoaded ? &object->gameObjectFields : nullptr;
+    }
+
+    const uint64_t *GetRaidTargetGuids() {
+        return sim::SimObjectManager::Instance().raidTargets();
+    }
+
+    uint32_t GetZoneAreaId() {
+        return sim::SimObjectManager::Instance().zoneAreaId();
+    }
+
+    size_t GetGroupMemberGuids(uint64_t *guids, size_t maxGuids) {
+        auto &group = sim::SimObjectManager::Instance().group();
+        size_t count = std::min(group.size(), maxGuids);
+        std::copy(group.begin(), group.begin() + count, guids);
+        return count;
+    }
+
+    bool GetActiveCamera(C3Vector &position, C3Vector &forward) {
+        return sim::SimObjectManager::Instance().GetCamera(position, forward);
+    }
+
+    const SpellRec *GetSpellInfo(uint32_t spellId) {
+        auto &world = sim::SimObjectManager::Instance();
+        world.CountSpellLookup();
+        return world.GetSpell(spellId);
+    }
+
+    uint64_t GetWowTimeMs() {
+        return sim::SimObjectManager::Instance().timeMs();
+    }
+}
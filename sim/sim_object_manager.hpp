@@ -0,0 +1,121 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace perf_boost {
+    namespace sim {
+        // A stand-in for the client object manager so perf_boost_core can run on the host.  Objects live at stable
+        // addresses and those addresses are the "unit pointers" handed to the core, exactly like the client's.
+        struct SimObject {
+            OBJECT_TYPE_ID type = OBJECT_TYPE_UNIT;
+            uint64_t guid = 0;
+            C3Vector position;
+            std::string name;
+            // what UnitCanAttackUnit answers when this object is the target
+            bool hostile = false;
+            uint32_t creatureEntry = 0;
+            // unknown falls back to the level < 63 trash rule
+            CreatureRank creatureRank = CREATURE_RANK_UNKNOWN;
+
+            UnitFields unitFields = {};
+            bool unitFieldsLoaded = true;
+
+            DynamicObjectFields dynamicObjectFields = {};
+            bool dynamicObjectFieldsLoaded = true;
+
+            GameObjectFields gameObjectFields = {};
+            bool gameObjectFieldsLoaded = true;
+
+            // player a corpse belongs to
+            uint64_t corpseOwner = 0;
+
+            uintptr_t *ptr() { return reinterpret_cast<uintptr_t *>(this); }
+        };
+
+        class SimObjectManager {
+        public:
+            static SimObjectManager &Instance();
+
+            // drop all objects, spells, raid marks and reset the clock
+            void Reset();
+
+            // objects start alive (health 1) at level 60 with no flags set
+            SimObject &AddPlayer(uint64_t guid, const char *name, const C3Vector &position);
+            SimObject &AddUnit(uint64_t guid, uint32_t level, const C3Vector &position);
+            SimObject &AddCorpse(uint64_t guid, const C3Vector &position);
+            SimObject &AddDynamicObject(uint64_t guid, uint64_t caster, int32_t spellId, const C3Vector &position);
+            SimObject &AddGameObject(uint64_t guid, GameObjectType type, const C3Vector &position);
+            // replacing or removing an object goes through OnObjectFree like the client's ObjectFree
+            void Remove(uint64_t guid);
+
+            SimObject *Find(uint64_t guid);
+            SimObject *FromPtr(uintptr_t *ptr) { return reinterpret_cast<SimObject *>(ptr); }
+
+            // creates and becomes the active player
+            SimObject &SetActivePlayer(uint64_t guid, const C3Vector &position);
+            uint64_t activePlayerGuid() const { return mActivePlayerGuid; }
+
+            void SetRaidMark(int mark, uint64_t guid);   // mark 1-8, guid 0 clears
+            const uint64_t *raidTargets() const { return mRaidTargets; }
+
+            // no camera until one is set, GetActiveCamera then returns false like on a loading screen
+            void SetCamera(const C3Vector &position, const C3Vector &forward) {
+                mHasCamera = true;
+                mCameraPosition = position;
+                mCameraForward = forward;
+            }
+            void ClearCamera() { mHasCamera = false; }
+            bool GetCamera(C3Vector &position, C3Vector &forward) const {
+                position = mCameraPosition;
+                forward = mCameraForward;
+                return mHasCamera;
+            }
+
+            // raid or party members besides the active player
+            void SetGroup(const std::vector<uint64_t> &guids) { mGroup = guids; }
+            const std::vector<uint64_t> &group() const { return mGroup; }
+
+            void SetZoneAreaId(uint32_t areaId) { mZoneAreaId = areaId; }
+            uint32_t zoneAreaId() const { return mZoneAreaId; }
+
+            SpellRec &AddSpell(uint32_t spellId);
+            const SpellRec *GetSpell(uint32_t spellId) const;
+
+            void AdvanceTime(uint64_t ms) { mTimeMs += ms; }
+            void SetTime(uint64_t ms) { mTimeMs = ms; }
+            uint64_t timeMs() const { return mTimeMs; }
+
+            size_t size() const { return mObjects.size(); }
+
+            // UnitCanAttackUnit calls since Reset
+            void CountAttackCheck() { ++mAttackChecks; }
+            uint64_t attackChecks() const { return mAttackChecks; }
+            // GetSpellInfo calls since Reset
+            void CountSpellLookup() { ++mSpellLookups; }
+            uint64_t spellLookups() const { return mSpellLookups; }
+
+        private:
+            SimObject &Add(uint64_t guid, OBJECT_TYPE_ID type, const C3Vector &position);
+
+            std::unordered_map<uint64_t, std::unique_ptr<SimObject>> mObjects;
+            std::unordered_map<uint32_t, std::unique_ptr<SpellRec>> mSpells;
+            uint64_t mActivePlayerGuid = 0;
+            uint64_t mRaidTargets[8] = {};
+            uint32_t mZoneAreaId = 0;
+            uint64_t mAttackChecks = 0;
+            uint64_t mSpellLookups = 0;
+            bool mHasCamera = false;
+            std::vector<uint64_t> mGroup;
+            C3Vector mCameraPosition;
+            C3Vector mCameraForward;
+            // start well past the 60 second player list recheck interval
+            uint64_t mTimeMs = 100000;
+        };
+    }
+}
@@ -0,0 +1,106 @@
+#include "animation_lod.hpp"
+#include "stats.hpp"
+#include "test_helpers.hpp"
+
+namespace perf_boost {
+    namespace {
+        // CGUnit::Animate's time step at 60 fps
+        const int32_t kStep = 16;
+    }
+
+    class AnimationLodTest : public CoreTest {
+    protected:
+        void SetUp() override {
+            CoreTest::SetUp();
+            ResetStats();
+            updateFromCvar("PB_AnimationLodTiers", "80:4, 40:2,bad,10:0");
+            BeginFrame();
+        }
+
+        void TearDown() override {
+            ResetStats();
+        }
+
+        // how many of the next frames animate the unit
+        int AnimatedFrames(sim::SimObject &unit, int frames) {
+            int animated = 0;
+            for (int i = 0; i < frames; ++i) {
+                BeginFrame();
+                animated += AnimationStepForUnit(unit.ptr(), kStep) != 0 ? 1 : 0;
+            }
+            return animated;
+        }
+    };
+
+    TEST_F(AnimationLodTest, TiersParsedAndSorted) {
+        ASSERT_EQ(2u, animationLodTiers.size());
+        EXPECT_EQ(1, AnimationIntervalForDistanceSq(39.0f * 39.0f));
+        EXPECT_EQ(2, AnimationIntervalForDistanceSq(40.0f * 40.0f));
+        EXPECT_EQ(2, AnimationIntervalForDistanceSq(79.0f * 79.0f));
+        EXPECT_EQ(4, AnimationIntervalForDistanceSq(200.0f * 200.0f));
+    }
+
+    TEST_F(AnimationLodTest, FartherUnitsAnimateLessOften) {
+        auto &near = world().AddUnit(10, 60, At(20.0f));
+        auto &middle = world().AddUnit(11, 60, At(50.0f));
+        auto &far = world().AddUnit(12, 60, At(100.0f));
+
+        EXPECT_EQ(8, AnimatedFrames(near, 8));
+        EXPECT_EQ(4, AnimatedFrames(middle, 8));
+        EXPECT_EQ(2, AnimatedFrames(far, 8));
+        EXPECT_EQ(kStep, AnimationStepForUnit(me->ptr(), kStep));
+    }
+
+    TEST_F(AnimationLodTest, MeasuredFromTheCameraWhenCullingFromIt) {
+        auto &unit = world().AddUnit(10, 60, At(100.0f));
+        world().SetCamera(At(90.0f), At(1.0f));
+        EXPECT_EQ(2, AnimatedFrames(unit, 8));
+
+        updateFromCvar("PB_CameraRelativeCulling", "1");
+        EXPECT_EQ(8, AnimatedFrames(unit, 8));
+    }
+
+    TEST_F(AnimationLodTest, StaggeredAndCounted) {
+        std::vector<sim::SimObject *> units;
+        for (uint64_t guid = 10; guid < 18; ++guid) {
+            units.push_back(&world().AddUnit(guid, 60, At(100.0f)));
+        }
+
+        BeginFrame();
+        for (auto unit: units) {
+            AnimationStepForUnit(unit->ptr(), kStep);
+        }
+        BeginFrame();
+
+        // a quarter of the tier each frame rather than all of it every 4th
+        EXPECT_EQ(2u, GetRuntimeStats().unitsAnimated);
+        EXPECT_EQ(6u, GetRuntimeStats().unitsAnimationDeferred);
+    }
+
+    TEST_F(AnimationLodTest, NoTiersAnimatesEverything) {
+        updateFromCvar("PB_AnimationLodTiers", "");
+        auto &far = world().AddUnit(12, 60, At(500.0f));
+        EXPECT_EQ(4, AnimatedFrames(far, 4));
+    }
+
+    TEST_F(AnimationLodTest, DeferredTimeHandedBack) {
+        auto &far = world().AddUnit(12, 60, At(100.0f));
+        int32_t animatedTime = 0;
+        int lastAnimated = -1;
+        for (int frame = 0; frame < 8; ++frame) {
+            BeginFrame();
+            auto step = AnimationStepForUnit(far.ptr(), kStep);
+            if (step != 0) {
+                animatedTime += step;
+                lastAnimated = frame;
+            }
+        }
+        ASSERT_GE(lastAnimated, 0);
+        EXPECT_EQ(kStep * (lastAnimated + 1), animatedTime);
+
+        // and turning the tiers off hands back whatever is still held
+        updateFromCvar("PB_AnimationLodTiers", "");
+        BeginFrame();
+        EXPECT_EQ(kStep * 9, animatedTime + AnimationStepForUnit(far.ptr(), kStep));
+    }
+}
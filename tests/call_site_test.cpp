@@ -0,0 +1,90 @@
+#include "call_site.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace perf_boost {
+    namespace {
+        const uint32_t kSite = 0x005FF4C6;
+        const uint32_t kOriginal = 0x0060EDF0;
+        const uint32_t kHandler = 0x10001230;
+
+        std::array<uint8_t, kCallRel32Size> CallTo(uint32_t address, uint32_t target) {
+            std::array<uint8_t, kCallRel32Size> code{};
+            WriteCallTarget(code.data(), address, target);
+            return code;
+        }
+    }
+
+    TEST(CallSiteTest, EncodesRelativeToNextInstruction) {
+        auto code = CallTo(kSite, kOriginal);
+        // 0x0060EDF0 - 0x005FF4CB
+        std::array<uint8_t, kCallRel32Size> expected{0xE8, 0x25, 0xF9, 0x00, 0x00};
+        EXPECT_EQ(expected, code);
+
+        uint32_t target = 0;
+        ASSERT_TRUE(ReadCallTarget(code.data(), kSite, target));
+        EXPECT_EQ(kOriginal, target);
+    }
+
+    TEST(CallSiteTest, BackwardCallRoundTrips) {
+        auto code = CallTo(0x006EC807, 0x0060D450);
+        EXPECT_EQ(0xFF, code[4]);
+
+        uint32_t target = 0;
+        ASSERT_TRUE(ReadCallTarget(code.data(), 0x006EC807, target));
+        EXPECT_EQ(0x0060D450u, target);
+    }
+
+    TEST(CallSiteTest, OnlyReadsCallRel32) {
+        std::array<uint8_t, kCallRel32Size> jump{0xE9, 0, 0, 0, 0};
+        uint32_t target = 0;
+        EXPECT_FALSE(ReadCallTarget(jump.data(), kSite, target));
+    }
+
+    TEST(CallSiteTest, PatchesAndRestoresExpectedCall) {
+        auto code = CallTo(kSite, kOriginal);
+        CallSite site{"aura visual", kSite, kOriginal, kHandler, CALL_SITE_PENDING};
+
+        ASSERT_TRUE(PatchCallSite(site, code.data()));
+        EXPECT_EQ(CALL_SITE_PATCHED, site.status);
+        uint32_t target = 0;
+        ASSERT_TRUE(ReadCallTarget(code.data(), kSite, target));
+        EXPECT_EQ(kHandler, target);
+        EXPECT_TRUE(VerifyCallSite(site, code.data()));
+
+        // patching twice is harmless
+        EXPECT_TRUE(PatchCallSite(site, code.data()));
+
+        ASSERT_TRUE(RestoreCallSite(site, code.data()));
+        EXPECT_EQ(CallTo(kSite, kOriginal), code);
+        EXPECT_EQ(CALL_SITE_PENDING, site.status);
+        EXPECT_TRUE(VerifyCallSite(site, code.data()));
+    }
+
+    TEST(CallSiteTest, UnexpectedCodeIsLeftAlone) {
+        auto code = CallTo(kSite, 0x00401000);
+        auto before = code;
+        CallSite site{"aura visual", kSite, kOriginal, kHandler, CALL_SITE_PENDING};
+
+        EXPECT_FALSE(PatchCallSite(site, code.data()));
+        EXPECT_EQ(CALL_SITE_MISMATCH, site.status);
+        EXPECT_EQ(before, code);
+
+        std::array<uint8_t, kCallRel32Size> nops{0x90, 0x90, 0x90, 0x90, 0x90};
+        site.status = CALL_SITE_PENDING;
+        EXPECT_FALSE(PatchCallSite(site, nops.data()));
+        EXPECT_EQ(CALL_SITE_MISMATCH, site.status);
+    }
+
+    TEST(CallSiteTest, VerifyNoticesOverwrittenCall) {
+        auto code = CallTo(kSite, kOriginal);
+        CallSite site{"aura visual", kSite, kOriginal, kHandler, CALL_SITE_PENDING};
+        ASSERT_TRUE(PatchCallSite(site, code.data()));
+
+        WriteCallTarget(code.data(), kSite, 0x20002000);
+        EXPECT_FALSE(VerifyCallSite(site, code.data()));
+        EXPECT_FALSE(RestoreCallSite(site, code.data()));
+    }
+}
@@ -0,0 +1,143 @@
+#include "creatures.hpp"
+#include "test_helpers.hpp"
+#include "unit_cache.hpp"
+
+namespace perf_boost {
+    class CreaturesTest : public CoreTest {
+    protected:
+        void SetUp() override {
+            CoreTest::SetUp();
+            BeginFrame();
+            // a full raid
+            SetGroupSize(39);
+        }
+
+        sim::SimObject &AddCreature(uint64_t guid, uint32_t entry, uint32_t level, CreatureRank rank,
+                                    uint32_t maxHealth) {
+            auto &unit = world().AddUnit(guid, level, At(5.0f));
+            unit.creatureEntry = entry;
+            unit.creatureRank = rank;
+            unit.unitFields.maxHealth = unit.unitFields.health = maxHealth;
+            return unit;
+        }
+
+        bool IsTrash(sim::SimObject &unit) {
+            return IsTrashCreature(unit.ptr(), &unit.unitFields);
+        }
+    };
+
+    TEST_F(CreaturesTest, EliteTrashAtBossLevelIsTrash) {
+        auto &gargoyle = AddCreature(20, 16168, 63, CREATURE_RANK_ELITE, 250000);
+        auto &patchwerk = AddCreature(21, 16028, 63, CREATURE_RANK_WORLDBOSS, 4322950);
+        auto &captain = AddCreature(22, 16145, 63, CREATURE_RANK_ELITE, 1000000);
+
+        EXPECT_TRUE(IsTrash(gargoyle));
+        EXPECT_FALSE(IsTrash(patchwerk));
+        // 10000 per player * 40
+        EXPECT_FALSE(IsTrash(captain));
+    }
+
+    TEST_F(CreaturesTest, HealthRuleScalesWithRaidSize) {
+        auto &elite = AddCreature(20, 100, 62, CREATURE_RANK_ELITE, 150000);
+        EXPECT_TRUE(IsTrash(elite));
+
+        SetGroupSize(4);
+        EXPECT_EQ(5u, RaidSizeForPlayerCount(5));
+        EXPECT_FALSE(IsTrash(elite));
+
+        updateFromCvar("PB_BossHealthPerPlayer", "-1");
+        EXPECT_TRUE(IsTrash(elite));
+    }
+
+    TEST_F(CreaturesTest, UserListsWin) {
+        auto &patchwerk = AddCreature(20, 16028, 63, CREATURE_RANK_WORLDBOSS, 4322950);
+        auto &trash = AddCreature(21, 16168, 60, CREATURE_RANK_ELITE, 1000);
+
+        updateFromCvar("PB_TrashCreatureIds", "16028");
+        updateFromCvar("PB_BossCreatureIds", " 16168 ");
+        EXPECT_TRUE(IsTrash(patchwerk));
+        EXPECT_FALSE(IsTrash(trash));
+    }
+
+    TEST_F(CreaturesTest, UnknownRankFallsBackToLevel) {
+        auto &low = AddCreature(20, 100, 62, CREATURE_RANK_UNKNOWN, 1000000);
+        auto &high = AddCreature(21, 101, 63, CREATURE_RANK_UNKNOWN, 1);
+        EXPECT_TRUE(IsTrash(low));
+        EXPECT_FALSE(IsTrash(high));
+
+        // decided again once the cache record arrives
+        high.creatureRank = CREATURE_RANK_NORMAL;
+        EXPECT_TRUE(IsTrash(high));
+    }
+
+    TEST_F(CreaturesTest, MemoizedPerEntry) {
+        auto &first = AddCreature(20, 100, 62, CREATURE_RANK_ELITE, 1000);
+        EXPECT_TRUE(IsTrash(first));
+
+        // same entry, the answer is not looked at again
+        auto &second = AddCreature(21, 100, 62, CREATURE_RANK_WORLDBOSS, 1000);
+        EXPECT_TRUE(IsTrash(second));
+
+        // until something it depends on changes
+        auto version = CreatureClassVersion();
+        updateFromCvar("PB_BossCreatureIds", "");
+        EXPECT_NE(version, CreatureClassVersion());
+        EXPECT_FALSE(IsTrash(second));
+    }
+
+    TEST_F(CreaturesTest, RaidSizeComesFromTheGroup) {
+        auto &elite = AddCreature(20, 100, 62, CREATURE_RANK_ELITE, 150000);
+        auto &enemy = world().AddPlayer(30, "Enemy", At(5.0f));
+        enemy.hostile = true;
+        EXPECT_EQ(UNIT_CLASS_TRASH, GetUnitClass(elite.ptr(), elite.guid).unitClass);
+        EXPECT_TRUE(PlayerCanAttackUnit(enemy.ptr(), enemy.guid));
+
+        // a city full of strangers is not a raid
+        std::vector<sim::SimObject *> strangers;
+        for (uint64_t guid = 100; guid < 140; ++guid) {
+            strangers.push_back(&world().AddPlayer(guid, "Stranger", At(10.0f)));
+        }
+        world().SetGroup({101, 102});
+        world().AdvanceTime(1000);
+        BeginFrame();
+        for (auto *stranger: strangers) {
+            shouldRenderObject(stranger->ptr(), 1);
+        }
+        BeginFrame();
+        EXPECT_EQ(UNIT_CLASS_BOSS, GetUnitClass(elite.ptr(), elite.guid).unitClass);
+
+        // only the health rule is decided again, the attack answers stay
+        auto checks = world().attackChecks();
+        EXPECT_TRUE(PlayerCanAttackUnit(enemy.ptr(), enemy.guid));
+        EXPECT_EQ(checks, world().attackChecks());
+    }
+
+    TEST_F(CreaturesTest, UnitCacheFollowsCreatureClass) {
+        auto &elite = AddCreature(20, 100, 63, CREATURE_RANK_ELITE, 1000);
+        EXPECT_EQ(UNIT_CLASS_TRASH, GetUnitClass(elite.ptr(), elite.guid).unitClass);
+
+        updateFromCvar("PB_BossCreatureIds", "100");
+        EXPECT_EQ(UNIT_CLASS_BOSS, GetUnitClass(elite.ptr(), elite.guid).unitClass);
+    }
+
+    TEST_F(CreaturesTest, UnrelatedSettingsKeepTheCaches) {
+        auto &elite = AddCreature(20, 100, 63, CREATURE_RANK_ELITE, 1000);
+        auto &enemy = world().AddPlayer(30, "Enemy", At(5.0f));
+        enemy.hostile = true;
+        EXPECT_EQ(UNIT_CLASS_TRASH, GetUnitClass(elite.ptr(), elite.guid).unitClass);
+        EXPECT_TRUE(PlayerCanAttackUnit(enemy.ptr(), enemy.guid));
+
+        auto version = CreatureClassVersion();
+        auto checks = world().attackChecks();
+        updateFromCvar("PB_PlayerRenderDist", "30");
+        updateFromCvar("PB_HiddenSpellIds", "2121");
+        EXPECT_EQ(version, CreatureClassVersion());
+        EXPECT_EQ(UNIT_CLASS_TRASH, GetUnitClass(elite.ptr(), elite.guid).unitClass);
+        EXPECT_TRUE(PlayerCanAttackUnit(enemy.ptr(), enemy.guid));
+        EXPECT_EQ(checks, world().attackChecks());
+
+        updateFromCvar("PB_BossHealthPerPlayer", "10");
+        EXPECT_NE(version, CreatureClassVersion());
+        EXPECT_EQ(UNIT_CLASS_BOSS, GetUnitClass(elite.ptr(), elite.guid).unitClass);
+    }
+}
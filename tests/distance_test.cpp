@@ -0,0 +1,82 @@
+#include "distance.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace perf_boost {
+    TEST(DistanceTest, AxisAlignedIsExact) {
+        C3Vector v;
+        v.y = -25.0f;
+        EXPECT_FLOAT_EQ(25.0f, fastApproxDistance(v));
+    }
+
+    TEST(DistanceTest, ApproximationOnlyOverestimates) {
+        for (int i = 0; i < 1000; ++i) {
+            C3Vector v;
+            v.x = std::sin(i * 0.37f) * 40.0f;
+            v.y = std::cos(i * 0.11f) * 40.0f;
+            v.z = std::sin(i * 0.05f) * 10.0f;
+
+            float exact = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+            if (exact < 0.001f) {
+                continue;
+            }
+            // worst case is ~14.6% long along (1, 0.5, 0.25)-ish directions, never short
+            float approx = fastApproxDistance(v);
+            EXPECT_GE(approx, exact * 0.999f);
+            EXPECT_LE(approx, exact * 1.15f);
+        }
+    }
+
+    TEST(DistanceTest, DistanceBetweenTruncates) {
+        C3Vector a, b;
+        a.x = 10.9f;
+        EXPECT_EQ(10, ApproximateDistanceBetween(a, b));
+        EXPECT_EQ(10, ApproximateDistanceBetween(b, a));
+    }
+
+    TEST(DistanceTest, BatchMatchesScalarForEveryTailLength) {
+        C3Vector origin;
+        origin.x = -3.5f;
+        origin.y = 12.25f;
+        origin.z = 1.0f;
+
+        // cover the 4 wide body plus every 0-3 leftover
+        for (size_t count = 0; count <= 37; ++count) {
+            PositionBatch batch;
+            for (size_t i = 0; i < count; ++i) {
+                C3Vector position;
+                position.x = std::sin(i * 0.71f) * 120.0f;
+                position.y = std::cos(i * 0.29f) * 120.0f;
+                position.z = std::sin(i * 0.13f) * 15.0f;
+                batch.push_back(position);
+            }
+
+            std::vector<float> batched;
+            SquaredDistancesTo(origin, batch, batched);
+            std::vector<float> scalar(count);
+            if (count > 0) {
+                SquaredDistancesToScalar(origin, batch.x.data(), batch.y.data(), batch.z.data(), count, scalar.data());
+            }
+
+            ASSERT_EQ(count, batched.size());
+            for (size_t i = 0; i < count; ++i) {
+                C3Vector position;
+                position.x = batch.x[i];
+                position.y = batch.y[i];
+                position.z = batch.z[i];
+                EXPECT_FLOAT_EQ(scalar[i], batched[i]) << "count " << count << " index " << i;
+                EXPECT_FLOAT_EQ(SquaredDistanceBetween(position, origin), batched[i]);
+            }
+        }
+    }
+
+    TEST(DistanceTest, SquaredThresholdIsExactAtTheBoundary) {
+        C3Vector a, b;
+        b.x = 24.0f;
+        b.y = 32.0f; // 40 yards, the approximation puts this at 44
+        EXPECT_LE(SquaredDistanceBetween(a, b), 40.0f * 40.0f);
+        EXPECT_EQ(44, ApproximateDistanceBetween(a, b));
+    }
+}
@@ -0,0 +1,97 @@
+#include "event_cost.hpp"
+#include "test_helpers.hpp"
+
+#include <chrono>
+#include <string>
+
+namespace perf_boost {
+    class EventCostTest : public CoreTest {
+    protected:
+        void SetUp() override {
+            CoreTest::SetUp();
+            ResetEventCost();
+            updateFromCvar("PB_MeasureEvents", "1");
+        }
+
+        void TearDown() override {
+            ResetEventCost();
+        }
+
+        void Handle(const char *frameName, const char *eventName, int microseconds = 0) {
+            EventCostBegin();
+            auto start = std::chrono::steady_clock::now();
+            while (std::chrono::steady_clock::now() - start < std::chrono::microseconds(microseconds)) {
+            }
+            EventCostEnd(frameName, eventName);
+        }
+    };
+
+    TEST_F(EventCostTest, AggregatesPerFrameAndEvent) {
+        Handle("DBM", "CHAT_MSG_MONSTER_YELL");
+        Handle("DBM", "CHAT_MSG_MONSTER_YELL");
+        Handle("DBM", "UNIT_HEALTH", 2000);
+        Handle("pfUI", "UNIT_HEALTH");
+
+        auto costs = EventCostTop(10);
+        ASSERT_EQ(3u, costs.size());
+        EXPECT_EQ("DBM", costs[0].frame);
+        EXPECT_EQ("UNIT_HEALTH", costs[0].event);
+        EXPECT_GE(costs[0].microseconds, 2000u);
+
+        for (const auto &cost: costs) {
+            EXPECT_EQ(cost.event == "CHAT_MSG_MONSTER_YELL" ? 2u : 1u, cost.calls);
+        }
+        EXPECT_EQ(1u, EventCostTop(1).size());
+    }
+
+    TEST_F(EventCostTest, NestedHandlersChargedSeparately) {
+        EventCostBegin();
+        Handle("inner", "PLAYER_TARGET_CHANGED", 1000);
+        EventCostEnd("outer", "UNIT_AURA");
+
+        auto costs = EventCostTop(2);
+        ASSERT_EQ(2u, costs.size());
+        EXPECT_GE(costs[0].microseconds, costs[1].microseconds);
+        EXPECT_GE(costs[1].microseconds, 1000u);
+
+        // unbalanced end after an error in a handler is ignored
+        EventCostEnd("outer", "UNIT_AURA");
+        EXPECT_EQ(1u, EventCostTop(2)[0].calls);
+    }
+
+    TEST_F(EventCostTest, FullTableCountsDropped) {
+        for (size_t i = 0; i < kEventCostSlots; ++i) {
+            Handle(("frame" + std::to_string(i)).c_str(), "BAG_UPDATE");
+        }
+
+        auto recorded = EventCostTop(kEventCostSlots).size();
+        EXPECT_LT(recorded, kEventCostSlots);
+        EXPECT_EQ(kEventCostSlots - recorded, EventCostDropped());
+
+        // pairs already in the table are still counted
+        Handle("frame0", "BAG_UPDATE");
+        EXPECT_EQ(kEventCostSlots - recorded, EventCostDropped());
+    }
+
+    TEST_F(EventCostTest, DisabledRecordsNothing) {
+        updateFromCvar("PB_MeasureEvents", "0");
+        Handle("DBM", "UNIT_HEALTH");
+
+        EXPECT_TRUE(EventCostTop(10).empty());
+        EXPECT_TRUE(EventCostWrapScript().empty());
+        EXPECT_NE(std::string::npos, EventCostStateScript().find("nil"));
+
+        updateFromCvar("PB_MeasureEvents", "1");
+        EXPECT_NE(std::string::npos, EventCostWrapScript().find("EnumerateFrames"));
+        EXPECT_EQ(std::string::npos, EventCostStateScript().find("nil"));
+
+        // a handler that started while measuring was off isn't charged and doesn't unbalance the next one
+        updateFromCvar("PB_MeasureEvents", "0");
+        EventCostBegin();
+        updateFromCvar("PB_MeasureEvents", "1");
+        EventCostEnd("DBM", "UNIT_HEALTH");
+        Handle("DBM", "UNIT_HEALTH");
+        ASSERT_EQ(1u, EventCostTop(10).size());
+        EXPECT_EQ(1u, EventCostTop(10)[0].calls);
+    }
+}
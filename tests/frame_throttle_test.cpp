@@ -0,0 +1,81 @@
+#include "frame_throttle.hpp"
+#include "test_helpers.hpp"
+
+#include <chrono>
+
+namespace perf_boost {
+    class FrameThrottleTest : public CoreTest {
+    protected:
+        void SetUp() override {
+            CoreTest::SetUp();
+            ResetFrameThrottle();
+            updateFromCvar("PB_ThrottledFrames", "pfUIBuffFrame, DBM_Timers");
+        }
+
+        void TearDown() override {
+            ResetFrameThrottle();
+        }
+    };
+
+    TEST_F(FrameThrottleTest, SkipsUpdatesUntilIntervalElapsed) {
+        int id = FrameThrottleId("pfUIBuffFrame");
+        EXPECT_EQ(id, FrameThrottleId("pfUIBuffFrame"));
+
+        // 20 per second, three 20 ms frames are skipped and the handler sees the time it missed
+        EXPECT_LT(FrameThrottleUpdate(id, 0.02f), 0.0f);
+        EXPECT_LT(FrameThrottleUpdate(id, 0.02f), 0.0f);
+        EXPECT_NEAR(0.06f, FrameThrottleUpdate(id, 0.02f), 1e-5f);
+        EXPECT_LT(FrameThrottleUpdate(id, 0.02f), 0.0f);
+    }
+
+    TEST_F(FrameThrottleTest, RateZeroOnlyMeasures) {
+        updateFromCvar("PB_ThrottledFrameRate", "0");
+        int id = FrameThrottleId("DBM_Timers");
+
+        for (int i = 0; i < 5; ++i) {
+            EXPECT_FLOAT_EQ(0.01f, FrameThrottleUpdate(id, 0.01f));
+        }
+        EXPECT_EQ(5u, FrameThrottleStats()[0].updates);
+    }
+
+    TEST_F(FrameThrottleTest, FramesRemovedFromListRunEveryUpdate) {
+        int id = FrameThrottleId("DBM_Timers");
+        EXPECT_LT(FrameThrottleUpdate(id, 0.01f), 0.0f);
+
+        updateFromCvar("PB_ThrottledFrames", "pfUIBuffFrame");
+        EXPECT_NEAR(0.02f, FrameThrottleUpdate(id, 0.01f), 1e-5f);
+        EXPECT_FLOAT_EQ(0.01f, FrameThrottleUpdate(id, 0.01f));
+    }
+
+    TEST_F(FrameThrottleTest, StatsSortedByCost) {
+        int cheap = FrameThrottleId("pfUIBuffFrame");
+        int expensive = FrameThrottleId("DBM_Timers");
+
+        FrameThrottleBegin(cheap);
+        FrameThrottleEnd(cheap);
+        FrameThrottleBegin(expensive);
+        auto start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(2)) {
+        }
+        FrameThrottleEnd(expensive);
+
+        auto stats = FrameThrottleStats();
+        ASSERT_EQ(2u, stats.size());
+        EXPECT_EQ("DBM_Timers", stats[0].name);
+        EXPECT_EQ(1u, stats[0].runs);
+        EXPECT_GE(stats[0].microseconds, 2000u);
+        EXPECT_EQ("pfUIBuffFrame", stats[1].name);
+    }
+
+    TEST_F(FrameThrottleTest, WrapScriptListsValidFrames) {
+        updateFromCvar("PB_ThrottledFrames", "");
+        EXPECT_TRUE(FrameThrottleWrapScript().empty());
+
+        updateFromCvar("PB_ThrottledFrames", "pfUIBuffFrame,bad\") os.exit() --,DBM_Timers");
+        ASSERT_EQ(2u, throttledFrameNames.size());
+        auto script = FrameThrottleWrapScript();
+        EXPECT_NE(std::string::npos, script.find("\"pfUIBuffFrame\""));
+        EXPECT_NE(std::string::npos, script.find("\"DBM_Timers\""));
+        EXPECT_EQ(std::string::npos, script.find("os.exit"));
+    }
+}
@@ -0,0 +1,99 @@
+#include "game_objects.hpp"
+#include "render_schedule.hpp"
+#include "test_helpers.hpp"
+
+namespace perf_boost {
+    class GameObjectsTest : public CoreTest {
+    protected:
+        void SetUp() override {
+            CoreTest::SetUp();
+            updateFromCvar("PB_GameObjectRenderDists", "chair:20, mailbox:40,17:10");
+            BeginFrame();
+        }
+
+        uint32_t ShouldRender(sim::SimObject &object) {
+            return shouldRenderObject(object.ptr(), 1);
+        }
+    };
+
+    TEST_F(GameObjectsTest, TypesByNameOrNumber) {
+        GameObjectType type;
+        ASSERT_TRUE(ParseGameObjectType("fishingnode", type));
+        EXPECT_EQ(GAMEOBJECT_TYPE_FISHINGNODE, type);
+        ASSERT_TRUE(ParseGameObjectType("19", type));
+        EXPECT_EQ(GAMEOBJECT_TYPE_MAILBOX, type);
+        EXPECT_STREQ("summoning_ritual", GameObjectTypeName(GAMEOBJECT_TYPE_SUMMONING_RITUAL));
+
+        EXPECT_FALSE(ParseGameObjectType("31", type));
+        EXPECT_FALSE(ParseGameObjectType("bench", type));
+        EXPECT_FALSE(ParseGameObjectType("", type));
+    }
+
+    TEST_F(GameObjectsTest, SettingParsed) {
+        EXPECT_EQ(20, gameObjectRenderDists[GAMEOBJECT_TYPE_CHAIR]);
+        EXPECT_EQ(40, gameObjectRenderDists[GAMEOBJECT_TYPE_MAILBOX]);
+        EXPECT_EQ(10, gameObjectRenderDists[GAMEOBJECT_TYPE_FISHINGNODE]);
+        EXPECT_EQ(-1, gameObjectRenderDists[GAMEOBJECT_TYPE_GOOBER]);
+
+        // doors and transports can't be given a distance and the previous list is gone
+        updateFromCvar("PB_GameObjectRenderDists", "door:5,transport:5,chair:bad,goober:15");
+        EXPECT_EQ(-1, gameObjectRenderDists[GAMEOBJECT_TYPE_DOOR]);
+        EXPECT_EQ(-1, gameObjectRenderDists[GAMEOBJECT_TYPE_TRANSPORT]);
+        EXPECT_EQ(-1, gameObjectRenderDists[GAMEOBJECT_TYPE_CHAIR]);
+        EXPECT_EQ(15, gameObjectRenderDists[GAMEOBJECT_TYPE_GOOBER]);
+    }
+
+    TEST_F(GameObjectsTest, CulledPerType) {
+        auto &nearChair = world().AddGameObject(10, GAMEOBJECT_TYPE_CHAIR, At(15.0f));
+        auto &farChair = world().AddGameObject(11, GAMEOBJECT_TYPE_CHAIR, At(25.0f));
+        auto &mailbox = world().AddGameObject(12, GAMEOBJECT_TYPE_MAILBOX, At(25.0f));
+        auto &banner = world().AddGameObject(13, GAMEOBJECT_TYPE_GENERIC, At(500.0f));
+
+        EXPECT_EQ(1u, ShouldRender(nearChair));
+        EXPECT_EQ(0u, ShouldRender(farChair));
+        EXPECT_EQ(1u, ShouldRender(mailbox));
+        EXPECT_EQ(1u, ShouldRender(banner));
+
+        // the client's own answer still wins
+        EXPECT_EQ(0u, shouldRenderObject(nearChair.ptr(), 0));
+
+        updateFromCvar("PB_GameObjectRenderDists", "");
+        EXPECT_EQ(1u, ShouldRender(farChair));
+    }
+
+    TEST_F(GameObjectsTest, NeverHidden) {
+        updateFromCvar("PB_GameObjectRenderDists", "chest:0,fishingnode:0");
+        auto &door = world().AddGameObject(10, GAMEOBJECT_TYPE_DOOR, At(300.0f));
+        auto &boat = world().AddGameObject(11, GAMEOBJECT_TYPE_MO_TRANSPORT, At(300.0f));
+        auto &questChest = world().AddGameObject(12, GAMEOBJECT_TYPE_CHEST, At(5.0f));
+        questChest.gameObjectFields.dynamicFlags = GAMEOBJECT_DYNFLAG_ACTIVATE;
+        auto &chest = world().AddGameObject(13, GAMEOBJECT_TYPE_CHEST, At(5.0f));
+        auto &myBobber = world().AddGameObject(14, GAMEOBJECT_TYPE_FISHINGNODE, At(15.0f));
+        myBobber.gameObjectFields.createdBy = kPlayerGuid;
+        auto &theirBobber = world().AddGameObject(15, GAMEOBJECT_TYPE_FISHINGNODE, At(15.0f));
+        theirBobber.gameObjectFields.createdBy = 99;
+        auto &loading = world().AddGameObject(16, GAMEOBJECT_TYPE_CHEST, At(5.0f));
+        loading.gameObjectFieldsLoaded = false;
+
+        EXPECT_EQ(1u, ShouldRender(door));
+        EXPECT_EQ(1u, ShouldRender(boat));
+        EXPECT_EQ(1u, ShouldRender(questChest));
+        EXPECT_EQ(0u, ShouldRender(chest));
+        EXPECT_EQ(1u, ShouldRender(myBobber));
+        EXPECT_EQ(0u, ShouldRender(theirBobber));
+        EXPECT_EQ(1u, ShouldRender(loading));
+    }
+
+    TEST_F(GameObjectsTest, ReusedBySchedule) {
+        updateFromCvar("PB_RenderRecheckFrames", "8");
+        auto &chair = world().AddGameObject(10, GAMEOBJECT_TYPE_CHAIR, At(80.0f));
+        EXPECT_EQ(0u, ShouldRender(chair));
+
+        // far past the boundary and nothing moves, the answer is reused
+        for (int frame = 0; frame < 3; ++frame) {
+            BeginFrame();
+            EXPECT_EQ(0, ScheduledRenderDecision(chair.guid, chair.position));
+            EXPECT_EQ(0u, ShouldRender(chair));
+        }
+    }
+}
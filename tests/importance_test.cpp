@@ -0,0 +1,160 @@
+#include "importance.hpp"
+#include "replay.hpp"
+#include "test_helpers.hpp"
+#include "trace.hpp"
+
+#include <cstdio>
+
+namespace perf_boost {
+    class ImportanceTest : public CoreTest {
+    protected:
+        void SetUp() override {
+            CoreTest::SetUp();
+            BeginFrame();
+        }
+
+        void TearDown() override {
+            StopTraceCapture();
+            EndFrame();
+        }
+
+        uint8_t FlagsOf(sim::SimObject &object) {
+            return ImportanceFlags(object.ptr(), object.guid);
+        }
+
+        // players lined up a quarter yard apart so their order changes with any movement
+        std::vector<sim::SimObject *> LineUp(size_t count) {
+            std::vector<sim::SimObject *> players;
+            for (size_t i = 0; i < count; ++i) {
+                char name[16];
+                std::snprintf(name, sizeof(name), "Player%zu", i);
+                players.push_back(&world().AddPlayer(100 + i, name, At(10.0f + 0.25f * i)));
+            }
+            return players;
+        }
+    };
+
+    TEST_F(ImportanceTest, FlagsForEveryReason) {
+        auto &target = world().AddUnit(10, 60, At(50.0f));
+        auto &targetOfTarget = world().AddPlayer(11, "Tank", At(50.0f));
+        auto &member = world().AddPlayer(12, "Member", At(50.0f));
+        auto &healer = world().AddPlayer(13, "Healer", At(50.0f));
+        auto &healed = world().AddPlayer(14, "Healed", At(50.0f));
+        auto &attacker = world().AddUnit(15, 60, At(50.0f));
+        auto &enemy = world().AddPlayer(16, "Enemy", At(50.0f));
+        auto &marked = world().AddUnit(17, 60, At(50.0f));
+        auto &bystander = world().AddUnit(18, 60, At(50.0f));
+
+        me->unitFields.target = target.guid;
+        target.unitFields.target = targetOfTarget.guid;
+        healer.unitFields.bytes0 = 5 << 8; // priest
+        healer.unitFields.target = healed.guid;
+        member.unitFields.target = bystander.guid;
+        world().SetGroup({member.guid, healer.guid});
+        attacker.unitFields.target = kPlayerGuid;
+        attacker.unitFields.flags |= UNIT_FLAG_IN_COMBAT;
+        enemy.hostile = true;
+        world().SetRaidMark(8, marked.guid);
+        // the group is only re-read once a second
+        world().AdvanceTime(1000);
+        BeginFrame();
+
+        EXPECT_EQ(IMPORTANCE_TARGET, FlagsOf(target));
+        EXPECT_EQ(IMPORTANCE_TARGET_OF_TARGET, FlagsOf(targetOfTarget));
+        EXPECT_EQ(IMPORTANCE_GROUP, FlagsOf(member));
+        EXPECT_EQ(IMPORTANCE_GROUP, FlagsOf(healer));
+        EXPECT_EQ(IMPORTANCE_HEALER_FOCUS, FlagsOf(healed));
+        EXPECT_EQ(IMPORTANCE_ATTACKING_ME, FlagsOf(attacker));
+        EXPECT_EQ(IMPORTANCE_HOSTILE_PLAYER, FlagsOf(enemy));
+        EXPECT_EQ(IMPORTANCE_MARKED, FlagsOf(marked));
+        // only healers' targets count
+        EXPECT_EQ(0, FlagsOf(bystander));
+    }
+
+    TEST_F(ImportanceTest, ReasonsOutrankDistance) {
+        EXPECT_GT(ImportanceScore(IMPORTANCE_TARGET, 1000.0f * 1000.0f),
+                  ImportanceScore(IMPORTANCE_TARGET_OF_TARGET | IMPORTANCE_GROUP | IMPORTANCE_MARKED, 0.0f));
+        EXPECT_GT(ImportanceScore(IMPORTANCE_MARKED, 100.0f * 100.0f), ImportanceScore(0, 0.0f));
+        EXPECT_GT(ImportanceScore(0, 10.0f * 10.0f), ImportanceScore(0, 10.5f * 10.5f));
+        // flat past 16383 yards
+        EXPECT_EQ(ImportanceScore(0, 20000.0f * 20000.0f), ImportanceScore(0, 30000.0f * 30000.0f));
+    }
+
+    TEST_F(ImportanceTest, BudgetKeepsTheMostImportant) {
+        updateFromCvar("PB_UnitBudget", "5");
+        auto players = LineUp(20);
+        auto &farTarget = world().AddPlayer(50, "FarTarget", At(-60.0f));
+        me->unitFields.target = farTarget.guid;
+
+        // the first frame can't know how many units there are
+        BeginFrame();
+        for (auto *player: players) {
+            EXPECT_EQ(1u, shouldRenderObject(player->ptr(), 1));
+        }
+        EXPECT_EQ(1u, shouldRenderObject(farTarget.ptr(), 1));
+
+        BeginFrame();
+        EXPECT_EQ(1u, shouldRenderObject(farTarget.ptr(), 1));
+        size_t rendered = 0;
+        for (size_t i = 0; i < players.size(); ++i) {
+            bool drawn = shouldRenderObject(players[i]->ptr(), 1) != 0;
+            EXPECT_EQ(i < 4, drawn) << i;
+            rendered += drawn ? 1 : 0;
+        }
+        EXPECT_EQ(4u, rendered);
+
+        // units new this frame get in if they beat the cut off
+        auto &close = world().AddPlayer(51, "Close", At(1.0f));
+        auto &far = world().AddPlayer(52, "Far", At(80.0f));
+        EXPECT_EQ(1u, shouldRenderObject(close.ptr(), 1));
+        EXPECT_EQ(0u, shouldRenderObject(far.ptr(), 1));
+    }
+
+    TEST_F(ImportanceTest, SelectionStableInReplay) {
+        std::string path = ::testing::TempDir() + "perf_boost_importance_test.pbtrace";
+        auto players = LineUp(60);
+
+        // everyone shuffles a little every frame, enough to reorder neighbours
+        ASSERT_TRUE(StartTraceCapture(path));
+        uint32_t seed = 1;
+        const int frames = 40;
+        for (int frame = 0; frame < frames; ++frame) {
+            for (size_t i = 0; i < players.size(); ++i) {
+                seed = seed * 1103515245u + 12345u;
+                float jitter = (static_cast<float>((seed >> 16) % 1000) / 1000.0f - 0.5f) * 0.8f;
+                players[i]->position = At(10.0f + 0.25f * i + jitter);
+            }
+            world().AdvanceTime(16);
+            BeginFrame();
+            TraceFrame();
+            for (auto *player: players) {
+                TraceShouldRender(player->ptr(), 1);
+            }
+            EndFrame();
+        }
+        StopTraceCapture();
+
+        sim::Replayer replayer(world());
+        replayer.SetOverride("PB_UnitBudget", "20");
+        ASSERT_TRUE(replayer.Replay(path));
+        std::remove(path.c_str());
+
+        auto &decisions = replayer.decisions();
+        ASSERT_EQ(players.size() * frames, decisions.size());
+        size_t flips = 0;
+        // from the second frame on the budget applies
+        for (int frame = 2; frame < frames; ++frame) {
+            size_t drawn = 0;
+            for (size_t i = 0; i < players.size(); ++i) {
+                auto decision = decisions[frame * players.size() + i];
+                drawn += decision;
+                if (decision != decisions[(frame - 1) * players.size() + i]) {
+                    ++flips;
+                }
+            }
+            EXPECT_EQ(20u, drawn) << "frame " << frame;
+        }
+        // jitter of 0.4 yards never beats the 2 yard bonus, the same 20 stay drawn
+        EXPECT_EQ(0u, flips);
+    }
+}
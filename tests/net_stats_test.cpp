@@ -0,0 +1,132 @@
+#include "net_stats.hpp"
+#include "stats.hpp"
+#include "test_helpers.hpp"
+
+namespace perf_boost {
+    class NetStatsTest : public CoreTest {
+    protected:
+        void SetUp() override {
+            CoreTest::SetUp();
+            ResetStats();
+            updateFromCvar("PB_PlayerRenderDist", "40");
+            updateFromCvar("PB_NetCongestionBandwidth", "50");
+            updateFromCvar("PB_NetCongestionLatency", "500");
+            Frame();
+        }
+
+        void TearDown() override {
+            ResetStats();
+        }
+
+        uint32_t Frame(std::initializer_list<sim::SimObject *> objects = {}, uint64_t ms = 20) {
+            world().AdvanceTime(ms);
+            BeginFrame();
+            uint32_t rendered = 0;
+            for (auto object: objects) {
+                rendered += shouldRenderObject(object->ptr(), 1);
+            }
+            EndFrame();
+            return rendered;
+        }
+    };
+
+    TEST_F(NetStatsTest, CongestionHeldAfterTraffic) {
+        RecordNetStats(20.0f, 120.0f);
+        Frame();
+        EXPECT_FALSE(NetCongested());
+
+        RecordNetStats(80.0f, 120.0f);
+        Frame();
+        EXPECT_TRUE(NetCongested());
+
+        RecordNetStats(20.0f, 120.0f);
+        Frame({}, 1000);
+        EXPECT_TRUE(NetCongested());
+        Frame({}, 3000);
+        EXPECT_FALSE(NetCongested());
+
+        RecordNetStats(10.0f, 900.0f);
+        Frame();
+        EXPECT_TRUE(NetCongested());
+    }
+
+    TEST_F(NetStatsTest, DecisionsFrozenWhileCongested) {
+        auto &leaving = world().AddPlayer(10, "Leaving", At(35.0f));
+        auto &arriving = world().AddPlayer(11, "Arriving", At(45.0f));
+        EXPECT_EQ(1u, Frame({&leaving, &arriving}));
+
+        RecordNetStats(80.0f, 120.0f);
+        leaving.position = At(45.0f);
+        arriving.position = At(35.0f);
+        Frame();
+        EXPECT_EQ(1u, shouldRenderObject(leaving.ptr(), 1));
+        EXPECT_EQ(0u, shouldRenderObject(arriving.ptr(), 1));
+
+        // new units face render distances scaled to 75%, 30 yards
+        auto &newNear = world().AddPlayer(12, "NewNear", At(25.0f));
+        auto &newFar = world().AddPlayer(13, "NewFar", At(35.0f));
+        EXPECT_EQ(1u, shouldRenderObject(newNear.ptr(), 1));
+        EXPECT_EQ(0u, shouldRenderObject(newFar.ptr(), 1));
+        EndFrame();
+
+        RecordNetStats(10.0f, 120.0f);
+        Frame({}, 5000);
+        EXPECT_FALSE(NetCongested());
+        EXPECT_EQ(0u, shouldRenderObject(leaving.ptr(), 1));
+        EXPECT_EQ(1u, shouldRenderObject(arriving.ptr(), 1));
+        EXPECT_EQ(1u, shouldRenderObject(newFar.ptr(), 1));
+    }
+
+    TEST_F(NetStatsTest, BudgetRankingKeptThroughCongestion) {
+        updateFromCvar("PB_UnitBudget", "2");
+        auto &first = world().AddPlayer(10, "First", At(5.0f));
+        auto &second = world().AddPlayer(11, "Second", At(10.0f));
+        auto &third = world().AddPlayer(12, "Third", At(15.0f));
+        auto &fourth = world().AddPlayer(13, "Fourth", At(20.0f));
+        Frame({&first, &second, &third, &fourth});
+        EXPECT_EQ(2u, Frame({&first, &second, &third, &fourth}));
+
+        RecordNetStats(80.0f, 120.0f);
+        for (int frame = 0; frame < 3; ++frame) {
+            EXPECT_EQ(2u, Frame({&first, &second, &third, &fourth}));
+        }
+
+        // the first frame after the freeze doesn't admit everyone
+        RecordNetStats(10.0f, 120.0f);
+        EXPECT_EQ(2u, Frame({&first, &second, &third, &fourth}, 5000));
+        EXPECT_FALSE(NetCongested());
+        EXPECT_EQ(1u, shouldRenderObject(first.ptr(), 1));
+        EXPECT_EQ(0u, shouldRenderObject(fourth.ptr(), 1));
+    }
+
+    TEST_F(NetStatsTest, DisabledThresholdsNeverCongest) {
+        updateFromCvar("PB_NetCongestionBandwidth", "0");
+        updateFromCvar("PB_NetCongestionLatency", "0");
+        RecordNetStats(1000.0f, 5000.0f);
+        Frame();
+        EXPECT_FALSE(NetCongested());
+    }
+
+    TEST_F(NetStatsTest, CongestionEndsWhenSamplingStops) {
+        auto &player = world().AddPlayer(10, "Player", At(35.0f));
+        RecordNetStats(80.0f, 120.0f);
+        Frame();
+        EXPECT_TRUE(NetCongested());
+
+        // turned off while congested, no sample will ever come in to clear it
+        updateFromCvar("PB_NetCongestionBandwidth", "0");
+        updateFromCvar("PB_NetCongestionLatency", "0");
+        player.position = At(45.0f);
+        EXPECT_EQ(0u, Frame({&player}));
+        EXPECT_FALSE(NetCongested());
+
+        // samples that stop arriving over the threshold end it after the hold time
+        updateFromCvar("PB_NetCongestionBandwidth", "50");
+        RecordNetStats(80.0f, 120.0f);
+        Frame();
+        EXPECT_TRUE(NetCongested());
+        Frame({}, 1000);
+        Frame({}, 3000);
+        EXPECT_FALSE(NetCongested());
+    }
+}
@@ -0,0 +1,114 @@
+#include "render_schedule.hpp"
+#include "scenes.hpp"
+#include "stats.hpp"
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace perf_boost {
+    class RenderScheduleTest : public CoreTest {
+    protected:
+        void SetUp() override {
+            CoreTest::SetUp();
+            ResetStats();
+            updateFromCvar("PB_PlayerRenderDist", "40");
+            updateFromCvar("PB_RenderRecheckFrames", "8");
+            BeginFrame();
+        }
+
+        void TearDown() override {
+            ResetStats();
+        }
+
+        // answers for everyone on a new frame and how many of them were decided instead of reused
+        std::vector<uint32_t> Frame(const std::vector<sim::SimObject *> &units, uint32_t &evaluated) {
+            world().AdvanceTime(16);
+            BeginFrame();
+            std::vector<uint32_t> answers;
+            evaluated = 0;
+            for (auto *unit: units) {
+                if (ScheduledRenderDecision(unit->guid, unit->position) < 0) {
+                    ++evaluated;
+                }
+                answers.push_back(shouldRenderObject(unit->ptr(), 1));
+            }
+            return answers;
+        }
+    };
+
+    TEST_F(RenderScheduleTest, IntervalFromMarginAndSpeed) {
+        const float kInfinity = std::numeric_limits<float>::infinity();
+        EXPECT_EQ(1u, RenderRecheckInterval(0.0f, 0.0f));
+        EXPECT_EQ(8u, RenderRecheckInterval(kInfinity, 1.0f));
+        EXPECT_EQ(8u, RenderRecheckInterval(5.0f, 0.0f));
+        // 5 yards at half a yard a frame is 10 frames, capped
+        EXPECT_EQ(8u, RenderRecheckInterval(5.0f, 0.5f));
+        // 3 frames rounds down to 2
+        EXPECT_EQ(2u, RenderRecheckInterval(0.75f, 0.25f));
+        EXPECT_EQ(1u, RenderRecheckInterval(0.2f, 0.25f));
+
+        updateFromCvar("PB_RenderRecheckFrames", "0");
+        EXPECT_EQ(1u, RenderRecheckInterval(kInfinity, 0.0f));
+    }
+
+    TEST_F(RenderScheduleTest, CityWorkSpreadEvenly) {
+        auto players = sim::BuildCity(world(), 300, 3);
+        me = world().Find(kPlayerGuid);
+
+        uint32_t evaluated = 0;
+        auto expected = Frame(players, evaluated);
+        EXPECT_EQ(300u, evaluated);
+
+        uint32_t most = 0;
+        uint32_t total = 0;
+        for (int frame = 0; frame < 16; ++frame) {
+            EXPECT_EQ(expected, Frame(players, evaluated)) << "frame " << frame;
+            most = std::max(most, evaluated);
+            total += evaluated;
+        }
+        // nobody moves, each unit comes due once every 8 frames and no frame gets many more than its share
+        EXPECT_EQ(600u, total);
+        EXPECT_LT(most, 60u);
+
+        BeginFrame();
+        EXPECT_EQ(300u - evaluated, GetRuntimeStats().renderChecksReused);
+    }
+
+    TEST_F(RenderScheduleTest, CrossingTheBoundaryIsSeenRightAway) {
+        auto &player = world().AddPlayer(10, "Runner", At(60.0f));
+        std::vector<sim::SimObject *> units{&player};
+        uint32_t evaluated = 0;
+        EXPECT_EQ(0u, Frame(units, evaluated)[0]);
+        EXPECT_EQ(0u, Frame(units, evaluated)[0]);
+        EXPECT_EQ(0u, evaluated);
+
+        // a charge or a teleport, faster than the measured speed
+        player.position = At(30.0f);
+        EXPECT_EQ(1u, Frame(units, evaluated)[0]);
+        EXPECT_EQ(1u, evaluated);
+
+        // the player walking up to it counts too
+        me->position = At(25.0f);
+        player.position = At(90.0f);
+        Frame(units, evaluated);
+        me->position = At(55.0f);
+        EXPECT_EQ(1u, Frame(units, evaluated)[0]);
+    }
+
+    TEST_F(RenderScheduleTest, SettingChangesDecideAgain) {
+        auto &player = world().AddPlayer(10, "Stander", At(30.0f));
+        std::vector<sim::SimObject *> units{&player};
+        uint32_t evaluated = 0;
+        Frame(units, evaluated);
+        Frame(units, evaluated);
+        EXPECT_EQ(0u, evaluated);
+
+        updateFromCvar("PB_PlayerRenderDist", "20");
+        EXPECT_EQ(0u, Frame(units, evaluated)[0]);
+        EXPECT_EQ(1u, evaluated);
+
+        world().SetRaidMark(1, player.guid);
+        EXPECT_EQ(1u, Frame(units, evaluated)[0]);
+    }
+}
@@ -0,0 +1,288 @@
+#include "test_helpers.hpp"
+
+#include <cmath>
+
+namespace perf_boost {
+    class RenderTest : public CoreTest {
+    protected:
+        void SetUp() override {
+            CoreTest::SetUp();
+            updateFromCvar("PB_PlayerRenderDist", "40");
+            updateFromCvar("PB_TrashUnitRenderDist", "30");
+            BeginFrame();
+        }
+
+        void TearDown() override {
+            EndFrame();
+        }
+
+        uint32_t Render(sim::SimObject &object) {
+            return shouldRenderObject(object.ptr(), 1);
+        }
+    };
+
+    TEST_F(RenderTest, BeginFrameCapturesPlayerState) {
+        EXPECT_EQ(me->ptr(), gPlayerUnit);
+
+        me->position = At(5.0f, 6.0f);
+        me->unitFields.flags |= UNIT_FLAG_IN_COMBAT;
+        world().SetZoneAreaId(1537);
+        BeginFrame();
+
+        EXPECT_FLOAT_EQ(5.0f, gPlayerPosition.x);
+        EXPECT_TRUE(gPlayerInCombat);
+        EXPECT_TRUE(gPlayerInCity);
+    }
+
+    TEST_F(RenderTest, PlayersCulledByDistance) {
+        auto &near = world().AddPlayer(10, "Near", At(39.0f));
+        auto &far = world().AddPlayer(11, "Far", At(41.0f));
+
+        EXPECT_EQ(1u, Render(near));
+        EXPECT_EQ(0u, Render(far));
+    }
+
+    TEST_F(RenderTest, DistanceIsExactInEveryDirection) {
+        // 38.2 yards away, the old octagonal approximation called this 40 and hid it
+        auto &diagonal = world().AddPlayer(10, "Diagonal", At(27.0f, 27.0f));
+        auto &boundary = world().AddPlayer(11, "Boundary", At(24.0f, 32.0f));
+        auto &inside = world().AddPlayer(12, "Inside", At(0.0f, 0.0f, 39.9f));
+
+        EXPECT_EQ(1u, Render(diagonal));
+        EXPECT_EQ(0u, Render(boundary));
+        EXPECT_EQ(1u, Render(inside));
+    }
+
+    TEST_F(RenderTest, DistancesResolvedPerCategory) {
+        updateFromCvar("PB_PetRenderDist", "10");
+        updateFromCvar("PB_PetRenderDistInCombat", "0");
+        updateFromCvar("PB_CorpseRenderDist", "-1");
+        BeginFrame();
+
+        EXPECT_FLOAT_EQ(1600.0f, gRenderDistSq[RENDER_CATEGORY_PLAYER]);
+        EXPECT_FLOAT_EQ(100.0f, gRenderDistSq[RENDER_CATEGORY_PET]);
+        EXPECT_FLOAT_EQ(900.0f, gRenderDistSq[RENDER_CATEGORY_TRASH]);
+        EXPECT_TRUE(std::isinf(gRenderDistSq[RENDER_CATEGORY_CORPSE]));
+
+        me->unitFields.flags |= UNIT_FLAG_IN_COMBAT;
+        BeginFrame();
+        EXPECT_FLOAT_EQ(0.0f, gRenderDistSq[RENDER_CATEGORY_PET]);
+    }
+
+    TEST_F(RenderTest, CombatThenCityDistancesTakePrecedence) {
+        auto &other = world().AddPlayer(10, "Other", At(20.0f));
+        updateFromCvar("PB_PlayerRenderDistInCities", "10");
+        updateFromCvar("PB_PlayerRenderDistInCombat", "25");
+
+        gPlayerInCity = true;
+        EXPECT_EQ(0u, Render(other));
+
+        gPlayerInCombat = true;
+        EXPECT_EQ(1u, Render(other));
+    }
+
+    TEST_F(RenderTest, ExceptionsOverrideDistance) {
+        auto &marked = world().AddPlayer(10, "Marked", At(100.0f));
+        auto &charmed = world().AddPlayer(11, "Charmed", At(100.0f));
+        charmed.unitFields.charmedBy = 99;
+        world().SetRaidMark(8, 10);
+        BeginFrame();
+
+        EXPECT_EQ(1u, Render(marked));
+        EXPECT_EQ(1u, Render(charmed));
+
+        updateFromCvar("PB_AlwaysRenderRaidMarks", "0");
+        EXPECT_EQ(0u, Render(marked));
+    }
+
+    TEST_F(RenderTest, RaidMarksSnapshottedPerFrame) {
+        world().SetRaidMark(3, 30);
+        world().SetRaidMark(1, 50);
+        world().SetRaidMark(7, 20);
+        EXPECT_EQ(-1, GetRaidMarkForGuid(50));
+
+        BeginFrame();
+        EXPECT_EQ(3, GetRaidMarkForGuid(30));
+        EXPECT_EQ(1, GetRaidMarkForGuid(50));
+        EXPECT_EQ(7, GetRaidMarkForGuid(20));
+        EXPECT_EQ(-1, GetRaidMarkForGuid(40));
+        EXPECT_EQ(-1, GetRaidMarkForGuid(0));
+
+        world().SetRaidMark(1, 0);
+        EXPECT_EQ(1, GetRaidMarkForGuid(50));
+        BeginFrame();
+        EXPECT_EQ(-1, GetRaidMarkForGuid(50));
+        EXPECT_EQ(3, GetRaidMarkForGuid(30));
+    }
+
+    TEST_F(RenderTest, OnlyAttackablePvpPlayersAlwaysRender) {
+        updateFromCvar("PB_AlwaysRenderPVP", "1");
+        auto &friendly = world().AddPlayer(10, "Friend", At(100.0f));
+        auto &enemy = world().AddPlayer(11, "Enemy", At(100.0f));
+        friendly.unitFields.flags |= UNIT_FLAG_PVP;
+        enemy.unitFields.flags |= UNIT_FLAG_PVP;
+        enemy.hostile = true;
+
+        EXPECT_EQ(0u, Render(friendly));
+        EXPECT_EQ(1u, Render(enemy));
+    }
+
+    TEST_F(RenderTest, HideAllPlayersWinsOverEverything) {
+        auto &marked = world().AddPlayer(10, "Marked", At(1.0f));
+        world().SetRaidMark(1, 10);
+        BeginFrame();
+        updateFromCvar("PB_HideAllPlayers", "1");
+
+        EXPECT_EQ(0u, Render(marked));
+    }
+
+    TEST_F(RenderTest, PlayerListsResolveByNameOnRecheck) {
+        auto &friendPlayer = world().AddPlayer(10, "Friend", At(100.0f));
+        auto &annoying = world().AddPlayer(11, "Annoying", At(1.0f));
+        updateFromCvar("PB_AlwaysRenderPlayers", "Friend");
+        updateFromCvar("PB_NeverRenderPlayers", "Annoying");
+
+        EndFrame();
+        BeginFrame();
+        EXPECT_EQ(1u, Render(friendPlayer));
+        EXPECT_EQ(0u, Render(annoying));
+        EndFrame();
+
+        // resolved by guid from now on, nothing left to check
+        EXPECT_TRUE(unresolvedPlayers.empty());
+        EXPECT_TRUE(neverRenderUnresolvedPlayers.empty());
+        BeginFrame();
+        EXPECT_EQ(1u, Render(friendPlayer));
+        EXPECT_EQ(0u, Render(annoying));
+    }
+
+    TEST_F(RenderTest, TrashCulledButBossesAlwaysRender) {
+        auto &trash = world().AddUnit(20, 60, At(35.0f));
+        auto &boss = world().AddUnit(21, 63, At(35.0f));
+
+        EXPECT_EQ(0u, Render(trash));
+        EXPECT_EQ(1u, Render(boss));
+    }
+
+    TEST_F(RenderTest, PetsAndSummonsExceptMyOwn) {
+        updateFromCvar("PB_PetRenderDist", "10");
+        updateFromCvar("PB_SummonRenderDist", "0");
+
+        auto &pet = world().AddUnit(20, 63, At(20.0f));
+        pet.unitFields.flags = UNIT_FLAG_PLAYER_CONTROLLED;
+        pet.unitFields.summonedBy = 50;
+        pet.unitFields.petNameTimestamp = 1;
+
+        auto &totem = world().AddUnit(21, 63, At(1.0f));
+        totem.unitFields.flags = UNIT_FLAG_PLAYER_CONTROLLED;
+        totem.unitFields.summonedBy = 50;
+
+        auto &mine = world().AddUnit(22, 63, At(1.0f));
+        mine.unitFields.flags = UNIT_FLAG_PLAYER_CONTROLLED;
+        mine.unitFields.summonedBy = kPlayerGuid;
+
+        EXPECT_EQ(0u, Render(pet));
+        EXPECT_EQ(0u, Render(totem));
+        EXPECT_EQ(1u, Render(mine));
+    }
+
+    TEST_F(RenderTest, CorpsesAndDeadUnits) {
+        updateFromCvar("PB_CorpseRenderDist", "5");
+        auto &corpse = world().AddCorpse(30, At(6.0f));
+        auto &deadUnit = world().AddUnit(31, 63, At(6.0f));
+        deadUnit.unitFields.health = 0;
+
+        EXPECT_EQ(0u, Render(corpse));
+        EXPECT_EQ(0u, Render(deadUnit));
+    }
+
+    TEST_F(RenderTest, CorpseBudgetKeepsTheNearestAndMine) {
+        updateFromCvar("PB_CorpseBudget", "4");
+        std::vector<sim::SimObject *> dead;
+        for (int i = 0; i < 10; ++i) {
+            // corpses and dead units alternate with distance
+            if (i % 2 == 0) {
+                dead.push_back(&world().AddCorpse(30 + i, At(2.0f + 2.0f * i)));
+            } else {
+                auto &unit = world().AddUnit(30 + i, 63, At(2.0f + 2.0f * i));
+                unit.unitFields.health = 0;
+                dead.push_back(&unit);
+            }
+        }
+        auto &mine = world().AddCorpse(50, At(60.0f));
+        mine.corpseOwner = kPlayerGuid;
+        auto &alive = world().AddUnit(51, 63, At(20.0f));
+
+        // everything the first frame, the budget ranks what it saw
+        for (auto *object: dead) {
+            EXPECT_EQ(1u, Render(*object));
+        }
+        BeginFrame();
+        for (size_t i = 0; i < dead.size(); ++i) {
+            EXPECT_EQ(i < 4 ? 1u : 0u, Render(*dead[i])) << i;
+        }
+        EXPECT_EQ(1u, Render(mine));
+        // the living aren't counted against it
+        EXPECT_EQ(1u, Render(alive));
+    }
+
+    TEST_F(RenderTest, ClientDecisionAndDisableAreRespected) {
+        auto &far = world().AddPlayer(10, "Far", At(100.0f));
+
+        EXPECT_EQ(0u, shouldRenderObject(far.ptr(), 0));
+        EXPECT_EQ(1u, shouldRenderObject(me->ptr(), 1));
+
+        updateFromCvar("PB_Enabled", "0");
+        EXPECT_EQ(1u, Render(far));
+    }
+
+    TEST_F(RenderTest, CameraRelativeCullingMeasuresFromTheCamera) {
+        updateFromCvar("PB_PlayerRenderDist", "25");
+        updateFromCvar("PB_CameraRelativeCulling", "1");
+        updateFromCvar("PB_CameraCullAngle", "0");
+        // zoomed out 50 yards behind the player, looking at them
+        world().SetCamera(At(-50.0f), At(2.0f));
+        auto &nearCamera = world().AddPlayer(10, "NearCamera", At(-30.0f));
+        auto &nearPlayer = world().AddPlayer(11, "NearPlayer", At(20.0f));
+        auto &behindCamera = world().AddPlayer(12, "BehindCamera", At(-60.0f));
+
+        BeginFrame();
+        EXPECT_TRUE(gViewFromCamera);
+        EXPECT_EQ(1u, Render(nearCamera));
+        EXPECT_EQ(0u, Render(nearPlayer));
+        EXPECT_EQ(1u, Render(behindCamera));
+
+        // no camera on loading screens, back to the player
+        world().ClearCamera();
+        BeginFrame();
+        EXPECT_FALSE(gViewFromCamera);
+        EXPECT_EQ(0u, Render(nearCamera));
+        EXPECT_EQ(1u, Render(nearPlayer));
+    }
+
+    TEST_F(RenderTest, CameraConeHidesUnitsBehindTheCamera) {
+        updateFromCvar("PB_PlayerRenderDist", "25");
+        updateFromCvar("PB_CameraRelativeCulling", "1");
+        world().SetCamera(At(-50.0f), At(1.0f));
+        auto &ahead = world().AddPlayer(10, "Ahead", At(-30.0f));
+        auto &behind = world().AddPlayer(11, "Behind", At(-60.0f));
+        // 42 and 76 degrees off the view direction, the default cone is 140 wide
+        auto &inside = world().AddPlayer(12, "Inside", At(-40.0f, 9.0f));
+        auto &outside = world().AddPlayer(13, "Outside", At(-45.0f, 20.0f));
+        auto &boss = world().AddUnit(14, 63, At(-60.0f));
+
+        BeginFrame();
+        EXPECT_EQ(1u, Render(ahead));
+        EXPECT_EQ(0u, Render(behind));
+        EXPECT_EQ(1u, Render(inside));
+        EXPECT_EQ(0u, Render(outside));
+        // only what would be culled by distance is culled by the cone
+        EXPECT_EQ(1u, Render(boss));
+
+        // the whole sphere
+        updateFromCvar("PB_CameraCullAngle", "360");
+        BeginFrame();
+        EXPECT_EQ(1u, Render(behind));
+        EXPECT_EQ(1u, Render(outside));
+    }
+}
@@ -0,0 +1,41 @@
+#include "test_helpers.hpp"
+
+namespace perf_boost {
+    using SettingsTest = CoreTest;
+
+    TEST_F(SettingsTest, IntegerCvars) {
+        updateFromCvar("PB_PlayerRenderDist", "40");
+        updateFromCvar("PB_CorpseRenderDist", "0");
+        updateFromCvar("PB_HideAllPlayers", "1");
+        updateFromCvar("PB_NotACvar", "12");
+
+        EXPECT_EQ(40, playerRenderDist);
+        EXPECT_EQ(0, corpseRenderDist);
+        EXPECT_TRUE(hideAllPlayers);
+    }
+
+    TEST_F(SettingsTest, SpellIdListsSkipWhitespaceAndGarbage) {
+        updateFromCvar("PB_HiddenSpellIds", " 123, 456 ,,abc,\t789");
+        ASSERT_EQ(3u, hiddenSpellIds.size());
+        EXPECT_EQ(123u, hiddenSpellIds[0]);
+        EXPECT_EQ(456u, hiddenSpellIds[1]);
+        EXPECT_EQ(789u, hiddenSpellIds[2]);
+
+        updateFromCvar("PB_AlwaysShownSpellIds", "10");
+        ASSERT_EQ(1u, alwaysShownSpellIds.size());
+
+        updateFromCvar("PB_HiddenSpellIds", "");
+        EXPECT_TRUE(hiddenSpellIds.empty());
+    }
+
+    TEST_F(SettingsTest, PlayerListsStartUnresolved) {
+        updateFromCvar("PB_AlwaysRenderPlayers", " Tank , Healer,,");
+        ASSERT_EQ(2u, unresolvedPlayers.size());
+        EXPECT_STREQ("Tank", unresolvedPlayers[0].name);
+        EXPECT_STREQ("Healer", unresolvedPlayers[1].name);
+        EXPECT_TRUE(resolvedPlayers.empty());
+
+        updateFromCvar("PB_NeverRenderPlayers", "Spammer");
+        ASSERT_EQ(1u, neverRenderUnresolvedPlayers.size());
+    }
+}
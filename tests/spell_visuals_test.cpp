@@ -0,0 +1,169 @@
+#include "spell_visuals.hpp"
+#include "test_helpers.hpp"
+
+namespace perf_boost {
+    class SpellVisualsTest : public CoreTest {
+    protected:
+        void SetUp() override {
+            CoreTest::SetUp();
+            BeginFrame();
+            other = &world().AddPlayer(10, "Other", At(10.0f));
+            mob = &world().AddUnit(20, 60, At(10.0f));
+            spell = &world().AddSpell(100);
+        }
+
+        sim::SimObject *other = nullptr;
+        sim::SimObject *mob = nullptr;
+        SpellRec *spell = nullptr;
+    };
+
+    TEST_F(SpellVisualsTest, HiddenSpellIdsSkipMeUnlessAsked) {
+        updateFromCvar("PB_HiddenSpellIds", "100");
+
+        EXPECT_TRUE(shouldHideSpellForUnit(other->ptr(), spell));
+        EXPECT_FALSE(shouldHideSpellForUnit(me->ptr(), spell));
+
+        updateFromCvar("PB_ApplyHiddenSpellIdsToMe", "1");
+        EXPECT_TRUE(shouldHideSpellForUnit(me->ptr(), spell));
+    }
+
+    TEST_F(SpellVisualsTest, AlwaysShownBeatsEverything) {
+        updateFromCvar("PB_HiddenSpellIds", "100");
+        updateFromCvar("PB_AlwaysShownSpellIds", "100");
+        updateFromCvar("PB_ShowPlayerSpellVisuals", "0");
+
+        EXPECT_FALSE(shouldHideSpellForUnit(other->ptr(), spell));
+    }
+
+    TEST_F(SpellVisualsTest, PlayerToggles) {
+        updateFromCvar("PB_ShowPlayerSpellVisuals", "0");
+        EXPECT_TRUE(shouldHideSpellForUnit(other->ptr(), spell));
+        EXPECT_FALSE(shouldHideSpellForUnit(mob->ptr(), spell));
+        EXPECT_FALSE(shouldHideSpellForUnit(me->ptr(), spell));
+
+        updateFromCvar("PB_ShowUnitAuraVisuals", "0");
+        EXPECT_TRUE(shouldHideAuraEffectForUnit(mob->ptr(), spell));
+        EXPECT_FALSE(shouldHideAuraEffectForUnit(other->ptr(), spell));
+    }
+
+    TEST_F(SpellVisualsTest, SpellsOfHiddenPlayersAreHidden) {
+        updateFromCvar("PB_PlayerRenderDist", "5");
+        EXPECT_TRUE(shouldHideSpellForUnit(other->ptr(), spell));
+
+        updateFromCvar("PB_HideSpellsForHiddenPlayers", "0");
+        EXPECT_FALSE(shouldHideSpellForUnit(other->ptr(), spell));
+    }
+
+    TEST_F(SpellVisualsTest, DynamicObjectsFollowTheirCaster) {
+        spell->Effect[1] = 27;
+        EXPECT_TRUE(IsGroundEffectSpell(spell));
+
+        auto &blizzard = world().AddDynamicObject(40, other->guid, 100, At(10.0f));
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(blizzard.ptr()));
+
+        updateFromCvar("PB_ShowPlayerGroundEffects", "0");
+        EXPECT_TRUE(shouldHideDynamicObjectVisual(blizzard.ptr()));
+
+        auto &orphan = world().AddDynamicObject(41, 999, 100, At(10.0f));
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(orphan.ptr()));
+    }
+
+    TEST_F(SpellVisualsTest, StackedGroundEffectsDrawnOnce) {
+        spell->SpellVisual = 7;
+        auto &first = world().AddDynamicObject(40, other->guid, 100, At(10.0f));
+        auto &second = world().AddDynamicObject(41, mob->guid, 100, At(11.0f));
+        auto &elsewhere = world().AddDynamicObject(42, mob->guid, 100, At(30.0f));
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(first.ptr()));
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(second.ptr()));
+
+        updateFromCvar("PB_DedupGroundEffects", "1");
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(first.ptr()));
+        EXPECT_TRUE(shouldHideDynamicObjectVisual(second.ptr()));
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(elsewhere.ptr()));
+        // the drawn copy stays the same on every proc
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(first.ptr()));
+        EXPECT_TRUE(shouldHideDynamicObjectVisual(second.ptr()));
+
+        // a different spell visual on the same spot is its own effect
+        auto &consecration = world().AddSpell(101);
+        consecration.SpellVisual = 8;
+        auto &consecrated = world().AddDynamicObject(43, mob->guid, 101, At(11.0f));
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(consecrated.ptr()));
+
+        // mine takes over the spot
+        auto &mine = world().AddDynamicObject(44, me->guid, 100, At(10.5f));
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(mine.ptr()));
+        EXPECT_TRUE(shouldHideDynamicObjectVisual(first.ptr()));
+
+        // and once it expires the next one asking is drawn
+        world().Remove(mine.guid);
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(second.ptr()));
+        EXPECT_TRUE(shouldHideDynamicObjectVisual(first.ptr()));
+    }
+
+    TEST_F(SpellVisualsTest, HiddenGroundEffectsDontStandInForOthers) {
+        spell->SpellVisual = 7;
+        updateFromCvar("PB_DedupGroundEffects", "1");
+        auto &players = world().AddDynamicObject(40, other->guid, 100, At(10.0f));
+        auto &mobs = world().AddDynamicObject(41, mob->guid, 100, At(10.0f));
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(players.ptr()));
+        EXPECT_TRUE(shouldHideDynamicObjectVisual(mobs.ptr()));
+
+        updateFromCvar("PB_ShowPlayerGroundEffects", "0");
+        EXPECT_TRUE(shouldHideDynamicObjectVisual(players.ptr()));
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(mobs.ptr()));
+    }
+
+    TEST_F(SpellVisualsTest, GroundEffectVerdictsReused) {
+        auto &blizzard = world().AddDynamicObject(40, mob->guid, 100, At(10.0f));
+        auto lookups = world().spellLookups();
+        for (int proc = 0; proc < 5; ++proc) {
+            BeginFrame();
+            EXPECT_FALSE(shouldHideDynamicObjectVisual(blizzard.ptr()));
+        }
+        EXPECT_EQ(lookups + 1, world().spellLookups());
+
+        updateFromCvar("PB_HiddenSpellIds", "100");
+        EXPECT_TRUE(shouldHideDynamicObjectVisual(blizzard.ptr()));
+        EXPECT_TRUE(shouldHideDynamicObjectVisual(blizzard.ptr()));
+        EXPECT_EQ(lookups + 2, world().spellLookups());
+
+        // a new object with a freed one's guid is decided again
+        world().Remove(blizzard.guid);
+        world().AddSpell(101);
+        auto &respawned = world().AddDynamicObject(40, mob->guid, 101, At(10.0f));
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(respawned.ptr()));
+    }
+
+    TEST_F(SpellVisualsTest, PlayerGroundEffectsFollowTheirRenderAnswer) {
+        auto &blizzard = world().AddDynamicObject(40, other->guid, 100, At(10.0f));
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(blizzard.ptr()));
+
+        // the caster walks out of render distance without any cvar changing
+        updateFromCvar("PB_PlayerRenderDist", "20");
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(blizzard.ptr()));
+        auto lookups = world().spellLookups();
+        BeginFrame();
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(blizzard.ptr()));
+        other->position = At(30.0f);
+        BeginFrame();
+        EXPECT_TRUE(shouldHideDynamicObjectVisual(blizzard.ptr()));
+        // only the caster's render answer was asked again
+        EXPECT_EQ(lookups, world().spellLookups());
+
+        // an orphaned effect's caster showing up
+        auto &orphan = world().AddDynamicObject(41, 50, 100, At(10.0f));
+        EXPECT_FALSE(shouldHideDynamicObjectVisual(orphan.ptr()));
+        world().AddPlayer(50, "Late", At(40.0f));
+        BeginFrame();
+        EXPECT_TRUE(shouldHideDynamicObjectVisual(orphan.ptr()));
+    }
+
+    TEST_F(SpellVisualsTest, ChannelVisualUsesChannelSpell) {
+        updateFromCvar("PB_HiddenSpellIds", "100");
+        EXPECT_FALSE(shouldHideChannelVisual(other->ptr()));
+
+        other->unitFields.channelSpell = 100;
+        EXPECT_TRUE(shouldHideChannelVisual(other->ptr()));
+    }
+}
@@ -0,0 +1,69 @@
+#include "stats.hpp"
+#include "test_helpers.hpp"
+
+namespace perf_boost {
+    class StatsTest : public CoreTest {
+    protected:
+        void SetUp() override {
+            CoreTest::SetUp();
+            ResetStats();
+            updateFromCvar("PB_PlayerRenderDist", "40");
+        }
+
+        void TearDown() override {
+            ResetStats();
+        }
+
+        void Frame(std::initializer_list<sim::SimObject *> objects) {
+            world().AdvanceTime(20);
+            BeginFrame();
+            for (auto object: objects) {
+                shouldRenderObject(object->ptr(), 1);
+            }
+            EndFrame();
+        }
+    };
+
+    TEST_F(StatsTest, CountsLastCompleteFrame) {
+        auto &near = world().AddPlayer(10, "Near", At(10.0f));
+        auto &far = world().AddPlayer(11, "Far", At(50.0f));
+        auto &farther = world().AddPlayer(12, "Farther", At(60.0f));
+
+        Frame({&near, &far, &farther});
+        EXPECT_EQ(0u, GetRuntimeStats().unitsRendered);
+
+        Frame({&near});
+        EXPECT_EQ(1u, GetRuntimeStats().unitsRendered);
+        EXPECT_EQ(2u, GetRuntimeStats().unitsCulled);
+        EXPECT_FLOAT_EQ(20.0f, GetRuntimeStats().frameMs);
+        EXPECT_FLOAT_EQ(20.0f, GetRuntimeStats().averageFrameMs);
+    }
+
+    TEST_F(StatsTest, UnitRenderedAnswersForTwoFrames) {
+        auto &near = world().AddPlayer(10, "Near", At(10.0f));
+        auto &far = world().AddPlayer(11, "Far", At(50.0f));
+
+        Frame({&near, &far});
+        EXPECT_EQ(1, IsUnitRendered(10));
+        EXPECT_EQ(0, IsUnitRendered(11));
+        EXPECT_EQ(-1, IsUnitRendered(12));
+
+        // still known while the next frame hasn't asked yet, forgotten once it's out of view for a whole frame
+        Frame({});
+        EXPECT_EQ(1, IsUnitRendered(10));
+        Frame({});
+        EXPECT_EQ(-1, IsUnitRendered(10));
+    }
+
+    TEST_F(StatsTest, AverageFrameTimeIsSmoothed) {
+        Frame({});
+        Frame({});
+        world().AdvanceTime(180);
+        Frame({});
+
+        auto &stats = GetRuntimeStats();
+        EXPECT_FLOAT_EQ(200.0f, stats.frameMs);
+        EXPECT_GT(stats.averageFrameMs, 20.0f);
+        EXPECT_LT(stats.averageFrameMs, 40.0f);
+    }
+}
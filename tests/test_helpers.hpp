@@ -0,0 +1,39 @@
+#pragma once
+
+#include "render.hpp"
+#include "settings.hpp"
+#include "sim_object_manager.hpp"
+
+#include <gtest/gtest.h>
+
+namespace perf_boost {
+    // Fresh simulated world with the active player standing at the origin
+    class CoreTest : public ::testing::Test {
+    protected:
+        static constexpr uint64_t kPlayerGuid = 1;
+
+        void SetUp() override {
+            world().Reset();
+            applyDefaultSettings();
+            gPlayerUnit = nullptr;
+            gPlayerPosition = C3Vector();
+            gPlayerInCombat = false;
+            gPlayerInCity = false;
+            gViewFromCamera = false;
+
+            me = &world().SetActivePlayer(kPlayerGuid, C3Vector());
+        }
+
+        sim::SimObjectManager &world() { return sim::SimObjectManager::Instance(); }
+
+        C3Vector At(float x, float y = 0.0f, float z = 0.0f) {
+            C3Vector position;
+            position.x = x;
+            position.y = y;
+            position.z = z;
+            return position;
+        }
+
+        sim::SimObject *me = nullptr;
+    };
+}
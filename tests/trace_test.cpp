@@ -0,0 +1,213 @@
+#include "replay.hpp"
+#include "scenes.hpp"
+#include "spell_visuals.hpp"
+#include "test_helpers.hpp"
+#include "trace.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace perf_boost {
+    class TraceTest : public CoreTest {
+    protected:
+        void SetUp() override {
+            CoreTest::SetUp();
+            path = ::testing::TempDir() + "perf_boost_trace_test.pbtrace";
+        }
+
+        void TearDown() override {
+            StopTraceCapture();
+            std::remove(path.c_str());
+        }
+
+        // capture a few frames of the city scene and return what the core answered live
+        std::vector<uint8_t> CaptureCity() {
+            updateFromCvar("PB_PlayerRenderDist", "40");
+            auto players = sim::BuildCity(world(), 100, 7);
+            me = world().Find(kPlayerGuid);
+            world().SetRaidMark(1, players[0]->guid);
+            auto &fire = world().AddSpell(2121);
+            fire.Effect[1] = 27;
+
+            EXPECT_TRUE(StartTraceCapture(path));
+            std::vector<uint8_t> live;
+            for (int frame = 0; frame < 3; ++frame) {
+                me->position = At(frame * 15.0f);
+                world().AdvanceTime(16);
+                BeginFrame();
+                TraceFrame();
+                for (auto *player: players) {
+                    TraceShouldRender(player->ptr(), 1);
+                    live.push_back(shouldRenderObject(player->ptr(), 1) != 0 ? 1 : 0);
+                }
+                TraceVisual(TraceVisualKind::GroundEffect, players[1]->ptr(), &fire);
+                TraceUnitSignal(players[2]->guid, 1, "0x0000000000000003");
+                EndFrame();
+            }
+            StopTraceCapture();
+            return live;
+        }
+
+        // capture frames of ShouldRender queries for the objects and return what the core answered live
+        std::vector<uint8_t> Capture(const std::vector<sim::SimObject *> &objects, int frames) {
+            EXPECT_TRUE(StartTraceCapture(path));
+            std::vector<uint8_t> live;
+            for (int frame = 0; frame < frames; ++frame) {
+                world().AdvanceTime(16);
+                BeginFrame();
+                TraceFrame();
+                for (auto *object: objects) {
+                    TraceShouldRender(object->ptr(), 1);
+                    live.push_back(shouldRenderObject(object->ptr(), 1) != 0 ? 1 : 0);
+                }
+                EndFrame();
+            }
+            StopTraceCapture();
+            return live;
+        }
+
+        std::string path;
+    };
+
+    TEST_F(TraceTest, ReplayReproducesLiveDecisions) {
+        auto live = CaptureCity();
+
+        sim::Replayer replayer(world());
+        ASSERT_TRUE(replayer.Replay(path));
+
+        auto &stats = replayer.stats();
+        EXPECT_EQ(3u, stats.frames);
+        EXPECT_EQ(live, replayer.decisions());
+        EXPECT_EQ(3u, stats.groundEffect.calls);
+        EXPECT_EQ(3u, stats.unitSignal.calls);
+        EXPECT_EQ(3u, stats.unitSignal.hidden);
+        EXPECT_EQ(0u, stats.missingCasters);
+    }
+
+    TEST_F(TraceTest, OverridesReplaceRecordedSettings) {
+        CaptureCity();
+
+        sim::Replayer replayer(world());
+        replayer.SetOverride("PB_PlayerRenderDist", "-1");
+        ASSERT_TRUE(replayer.Replay(path));
+
+        EXPECT_EQ(0u, replayer.stats().shouldRender.hidden);
+        EXPECT_EQ(-1, playerRenderDist);
+    }
+
+    TEST_F(TraceTest, TruncatedTraceFails) {
+        CaptureCity();
+
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size() - 3);
+
+        sim::Replayer replayer(world());
+        EXPECT_FALSE(replayer.Replay(path));
+        EXPECT_GT(replayer.stats().records, 0u);
+    }
+
+    TEST_F(TraceTest, ReplayUsesTheRecordedCamera) {
+        updateFromCvar("PB_PlayerRenderDist", "25");
+        updateFromCvar("PB_CameraRelativeCulling", "1");
+        auto players = sim::BuildCity(world(), 100, 7);
+
+        ASSERT_TRUE(StartTraceCapture(path));
+        std::vector<uint8_t> live;
+        for (int frame = 0; frame < 3; ++frame) {
+            // swinging the camera around the player
+            float angle = frame * 2.0f;
+            world().SetCamera(At(-20.0f * std::cos(angle), -20.0f * std::sin(angle)),
+                              At(std::cos(angle), std::sin(angle)));
+            world().AdvanceTime(16);
+            BeginFrame();
+            TraceFrame();
+            for (auto *player: players) {
+                TraceShouldRender(player->ptr(), 1);
+                live.push_back(shouldRenderObject(player->ptr(), 1) != 0 ? 1 : 0);
+            }
+            EndFrame();
+        }
+        StopTraceCapture();
+
+        sim::Replayer replayer(world());
+        ASSERT_TRUE(replayer.Replay(path));
+        EXPECT_EQ(live, replayer.decisions());
+        EXPECT_GT(replayer.stats().shouldRender.hidden, 0u);
+    }
+
+    TEST_F(TraceTest, OnlyUnitsRecordUnitFields) {
+        // what UnitGetFields would read past the end of a corpse's descriptor
+        auto &corpse = world().AddCorpse(30, At(5.0f));
+        corpse.unitFieldsLoaded = true;
+        corpse.unitFields.health = 5;
+
+        ASSERT_TRUE(StartTraceCapture(path));
+        TraceShouldRender(corpse.ptr(), 1);
+        StopTraceCapture();
+
+        TraceReader reader;
+        ASSERT_TRUE(reader.Open(path));
+        TraceRecord record;
+        while (reader.Next(record) && record.type != TraceRecordType::ShouldRender) {
+        }
+        ASSERT_EQ(TraceRecordType::ShouldRender, record.type);
+        EXPECT_EQ(corpse.guid, record.unit.guid);
+        EXPECT_EQ(0, record.unit.bits & TRACE_UNIT_FIELDS_LOADED);
+        EXPECT_EQ(0u, record.unit.health);
+    }
+
+    TEST_F(TraceTest, ReplayHidesGameObjects) {
+        updateFromCvar("PB_GameObjectRenderDists", "chair:20,fishingnode:20");
+        std::vector<sim::SimObject *> objects = {
+                &world().AddGameObject(10, GAMEOBJECT_TYPE_CHAIR, At(15.0f)),
+                &world().AddGameObject(11, GAMEOBJECT_TYPE_CHAIR, At(25.0f)),
+                &world().AddGameObject(12, GAMEOBJECT_TYPE_CHAIR, At(30.0f)),
+                &world().AddGameObject(13, GAMEOBJECT_TYPE_FISHINGNODE, At(30.0f)),
+                &world().AddGameObject(14, GAMEOBJECT_TYPE_CHAIR, At(40.0f)),
+        };
+        objects[2]->gameObjectFields.dynamicFlags = GAMEOBJECT_DYNFLAG_ACTIVATE;
+        objects[3]->gameObjectFields.createdBy = kPlayerGuid;
+        objects[4]->gameObjectFieldsLoaded = false;
+
+        auto live = Capture(objects, 1);
+        EXPECT_EQ(std::vector<uint8_t>({1, 0, 1, 1, 1}), live);
+
+        sim::Replayer replayer(world());
+        ASSERT_TRUE(replayer.Replay(path));
+        EXPECT_EQ(live, replayer.decisions());
+    }
+
+    TEST_F(TraceTest, ReplayKeepsTheOwnCorpse) {
+        updateFromCvar("PB_CorpseBudget", "1");
+        auto &other = world().AddCorpse(20, At(10.0f));
+        auto &mine = world().AddCorpse(21, At(30.0f));
+        mine.corpseOwner = kPlayerGuid;
+
+        auto live = Capture({&other, &mine}, 3);
+        EXPECT_EQ(std::vector<uint8_t>({1, 1, 1, 1, 1, 1}), live);
+
+        sim::Replayer replayer(world());
+        ASSERT_TRUE(replayer.Replay(path));
+        EXPECT_EQ(live, replayer.decisions());
+    }
+
+    TEST_F(TraceTest, ReplayRanksTheTargetAndGroup) {
+        updateFromCvar("PB_UnitBudget", "2");
+        auto &close = world().AddPlayer(30, "Close", At(5.0f));
+        auto &target = world().AddPlayer(31, "Target", At(30.0f));
+        auto &member = world().AddPlayer(32, "Member", At(40.0f));
+        me->unitFields.target = target.guid;
+        world().SetGroup({member.guid});
+
+        // the first frame admits everyone, ranking starts from its scores
+        auto live = Capture({&close, &target, &member}, 3);
+        EXPECT_EQ(std::vector<uint8_t>({0, 1, 1}), std::vector<uint8_t>(live.end() - 3, live.end()));
+
+        sim::Replayer replayer(world());
+        ASSERT_TRUE(replayer.Replay(path));
+        EXPECT_EQ(live, replayer.decisions());
+    }
+}
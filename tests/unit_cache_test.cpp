@@ -0,0 +1,122 @@
+#include "test_helpers.hpp"
+#include "unit_cache.hpp"
+
+namespace perf_boost {
+    class UnitCacheTest : public CoreTest {
+    protected:
+        void SetUp() override {
+            CoreTest::SetUp();
+            BeginFrame();
+        }
+
+        UNIT_CLASS ClassOf(sim::SimObject &object) {
+            return GetUnitClass(object.ptr(), object.guid).unitClass;
+        }
+
+        sim::SimObject &AddControlled(uint64_t guid, uint64_t summonedBy, uint32_t petNameTimestamp) {
+            auto &unit = world().AddUnit(guid, 60, At(5.0f));
+            unit.unitFields.flags = UNIT_FLAG_PLAYER_CONTROLLED;
+            unit.unitFields.summonedBy = summonedBy;
+            unit.unitFields.petNameTimestamp = petNameTimestamp;
+            return unit;
+        }
+    };
+
+    TEST_F(UnitCacheTest, ClassifiesEveryKind) {
+        EXPECT_EQ(UNIT_CLASS_PLAYER, ClassOf(world().AddPlayer(10, "Other", At(5.0f))));
+        EXPECT_EQ(UNIT_CLASS_CORPSE, ClassOf(world().AddCorpse(11, At(5.0f))));
+        EXPECT_EQ(UNIT_CLASS_PET, ClassOf(AddControlled(12, 50, 1)));
+        EXPECT_EQ(UNIT_CLASS_SUMMON, ClassOf(AddControlled(13, 50, 0)));
+        EXPECT_EQ(UNIT_CLASS_OWN_SUMMON, ClassOf(AddControlled(14, kPlayerGuid, 1)));
+        EXPECT_EQ(UNIT_CLASS_TRASH, ClassOf(world().AddUnit(15, 62, At(5.0f))));
+        EXPECT_EQ(UNIT_CLASS_BOSS, ClassOf(world().AddUnit(16, 63, At(5.0f))));
+
+        auto &loading = world().AddUnit(17, 60, At(5.0f));
+        loading.unitFieldsLoaded = false;
+        EXPECT_EQ(UNIT_CLASS_UNKNOWN, ClassOf(loading));
+        // everything but the unit still loading
+        EXPECT_EQ(7u, UnitClassCacheSize());
+    }
+
+    TEST_F(UnitCacheTest, CachedUntilFreed) {
+        auto &mob = world().AddUnit(20, 60, At(5.0f));
+        EXPECT_EQ(UNIT_CLASS_TRASH, ClassOf(mob));
+
+        mob.unitFields.level = 63;
+        EXPECT_EQ(UNIT_CLASS_TRASH, ClassOf(mob));
+
+        // a new object with the same guid starts fresh
+        auto &respawned = world().AddUnit(20, 63, At(5.0f));
+        EXPECT_EQ(UNIT_CLASS_BOSS, ClassOf(respawned));
+
+        world().Remove(20);
+        EXPECT_EQ(0u, UnitClassCacheSize());
+    }
+
+    TEST_F(UnitCacheTest, RefreshedOnMindControlAndAge) {
+        auto &mob = world().AddUnit(20, 60, At(5.0f));
+        EXPECT_EQ(UNIT_CLASS_TRASH, ClassOf(mob));
+
+        mob.unitFields.flags |= UNIT_FLAG_PLAYER_CONTROLLED;
+        mob.unitFields.summonedBy = 50;
+        EXPECT_EQ(UNIT_CLASS_SUMMON, ClassOf(mob));
+
+        mob.unitFields.petNameTimestamp = 1;
+        EXPECT_EQ(UNIT_CLASS_SUMMON, ClassOf(mob));
+        world().AdvanceTime(10000);
+        BeginFrame();
+        EXPECT_EQ(UNIT_CLASS_PET, ClassOf(mob));
+    }
+
+    TEST_F(UnitCacheTest, OwnSummonsFollowTheActivePlayer) {
+        auto &totem = AddControlled(20, kPlayerGuid, 0);
+        EXPECT_EQ(UNIT_CLASS_OWN_SUMMON, ClassOf(totem));
+
+        world().SetActivePlayer(2, At(0.0f));
+        BeginFrame();
+        EXPECT_EQ(UNIT_CLASS_SUMMON, ClassOf(totem));
+    }
+
+    TEST_F(UnitCacheTest, AttackabilityCheckedOncePerFactionOrFlagChange) {
+        auto &enemy = world().AddPlayer(10, "Enemy", At(5.0f));
+        enemy.hostile = true;
+        enemy.unitFields.factionTemplate = 2;
+
+        for (int frame = 0; frame < 3; ++frame) {
+            BeginFrame();
+            EXPECT_TRUE(PlayerCanAttackUnit(enemy.ptr(), enemy.guid));
+        }
+        EXPECT_EQ(1u, world().attackChecks());
+
+        // e.g. leaving the duel or dropping the pvp flag
+        enemy.hostile = false;
+        enemy.unitFields.flags |= UNIT_FLAG_PVP;
+        EXPECT_FALSE(PlayerCanAttackUnit(enemy.ptr(), enemy.guid));
+        EXPECT_EQ(2u, world().attackChecks());
+
+        // our own flags change the answer for everyone
+        enemy.hostile = true;
+        world().Find(kPlayerGuid)->unitFields.flags |= UNIT_FLAG_PVP;
+        EXPECT_TRUE(PlayerCanAttackUnit(enemy.ptr(), enemy.guid));
+        EXPECT_EQ(3u, world().attackChecks());
+
+        // and a freed object starts over
+        world().Remove(10);
+        auto &respawned = world().AddPlayer(10, "Enemy", At(5.0f));
+        EXPECT_FALSE(PlayerCanAttackUnit(respawned.ptr(), respawned.guid));
+        EXPECT_EQ(4u, world().attackChecks());
+    }
+
+    TEST_F(UnitCacheTest, AttackabilityKeptAcrossTheClassRefresh) {
+        auto &mob = world().AddUnit(20, 60, At(5.0f));
+        mob.hostile = true;
+        EXPECT_EQ(UNIT_CLASS_TRASH, ClassOf(mob));
+        EXPECT_TRUE(PlayerCanAttackUnit(mob.ptr(), mob.guid));
+
+        world().AdvanceTime(5000);
+        BeginFrame();
+        EXPECT_EQ(UNIT_CLASS_TRASH, ClassOf(mob));
+        EXPECT_TRUE(PlayerCanAttackUnit(mob.ptr(), mob.guid));
+        EXPECT_EQ(1u, world().attackChecks());
+    }
+}
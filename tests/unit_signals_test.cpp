@@ -0,0 +1,24 @@
+#include "test_helpers.hpp"
+#include "unit_signals.hpp"
+
+namespace perf_boost {
+    using UnitSignalsTest = CoreTest;
+
+    TEST_F(UnitSignalsTest, FiltersSpammyEventsForRawGuids) {
+        EXPECT_TRUE(shouldFilterGuidEvent("0xF130001234", 0));
+        EXPECT_TRUE(shouldFilterGuidEvent("0xF130001234", 181));
+        EXPECT_TRUE(shouldFilterGuidEvent("0xF130001234", 183));
+        EXPECT_TRUE(shouldFilterGuidEvent("0xF130001234", 345));
+
+        EXPECT_FALSE(shouldFilterGuidEvent("0xF130001234", 182));
+        EXPECT_FALSE(shouldFilterGuidEvent("0xF130001234", 185));
+    }
+
+    TEST_F(UnitSignalsTest, KeepsUnitTokensAndHonorsCvar) {
+        EXPECT_FALSE(shouldFilterGuidEvent("raid12", 0));
+        EXPECT_FALSE(shouldFilterGuidEvent("target", 100));
+
+        updateFromCvar("PB_FilterGuidEvents", "0");
+        EXPECT_FALSE(shouldFilterGuidEvent("0xF130001234", 0));
+    }
+}
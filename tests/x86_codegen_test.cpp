@@ -0,0 +1,195 @@
+#include "x86_codegen.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace perf_boost {
+    namespace {
+        const uint32_t kFunction = 0x00607da0;
+        const uint32_t kTrampoline = 0x10000000;
+        const uint32_t kHandler = 0x10002000;
+
+        struct Instruction {
+            uint32_t address;
+            std::string text;
+        };
+
+        bool HaveObjdump() {
+            return std::system("objdump --version > /dev/null 2>&1") == 0;
+        }
+
+        // the bytes as objdump sees them at address, text with runs of whitespace collapsed
+        std::vector<Instruction> Disassemble(const std::vector<uint8_t> &code, uint32_t address) {
+            std::string path = ::testing::TempDir() + "perf_boost_x86_codegen_test.bin";
+            std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(code.data()), code.size());
+
+            std::ostringstream command;
+            command << "objdump -D -b binary -m i386 -M intel --adjust-vma=0x" << std::hex << address << " " << path;
+            std::vector<Instruction> instructions;
+            FILE *pipe = popen(command.str().c_str(), "r");
+            char line[256];
+            while (pipe && std::fgets(line, sizeof(line), pipe)) {
+                // "  607da0:\t55                   \tpush   ebp", long encodings continue without text on the next line
+                std::string text(line);
+                auto firstTab = text.find(":\t");
+                auto secondTab = text.find('\t', firstTab + 2);
+                if (firstTab == std::string::npos || secondTab == std::string::npos) {
+                    continue;
+                }
+
+                Instruction instruction;
+                instruction.address = static_cast<uint32_t>(std::stoul(text.substr(0, firstTab), nullptr, 16));
+                std::istringstream words(text.substr(secondTab + 1));
+                std::string word;
+                while (words >> word) {
+                    instruction.text += (instruction.text.empty() ? "" : " ") + word;
+                }
+                instructions.push_back(instruction);
+            }
+            if (pipe) {
+                pclose(pipe);
+            }
+            std::remove(path.c_str());
+            return instructions;
+        }
+
+        std::vector<std::string> Texts(const std::vector<Instruction> &instructions) {
+            std::vector<std::string> texts;
+            for (const auto &instruction: instructions) {
+                texts.push_back(instruction.text);
+            }
+            return texts;
+        }
+
+        std::vector<uint8_t> Trampoline(std::vector<uint8_t> function, size_t &stolen) {
+            function.resize(function.size() + 16, kInt3Opcode);
+            std::vector<uint8_t> trampoline(kMaxTrampolineSize, kInt3Opcode);
+            stolen = BuildTrampoline(function.data(), kFunction, trampoline.data(), kTrampoline);
+            trampoline.resize(stolen + kRel32Size);
+            return trampoline;
+        }
+    }
+
+    TEST(X86CodegenTest, LengthsMatchObjdump) {
+        if (!HaveObjdump()) {
+            GTEST_SKIP() << "objdump not installed";
+        }
+
+        // prologues and bodies of the sort found at the start of client functions
+        std::vector<uint8_t> code{
+                0x55,                                     // push ebp
+                0x8B, 0xEC,                               // mov ebp, esp
+                0x83, 0xEC, 0x10,                         // sub esp, 0x10
+                0x81, 0xEC, 0x00, 0x01, 0x00, 0x00,       // sub esp, 0x100
+                0x53, 0x56, 0x57,                         // push ebx/esi/edi
+                0x8B, 0xF1,                               // mov esi, ecx
+                0x8B, 0x44, 0x24, 0x08,                   // mov eax, [esp+8]
+                0x8B, 0x4D, 0xFC,                         // mov ecx, [ebp-4]
+                0x8B, 0x86, 0x10, 0x01, 0x00, 0x00,       // mov eax, [esi+0x110]
+                0x8B, 0x04, 0x8D, 0x00, 0x10, 0x40, 0x00, // mov eax, [ecx*4+0x401000]
+                0xA1, 0x00, 0x10, 0x40, 0x00,             // mov eax, [0x401000]
+                0x64, 0xA1, 0x00, 0x00, 0x00, 0x00,       // mov eax, fs:[0]
+                0x6A, 0xFF,                               // push -1
+                0x68, 0x00, 0x10, 0x40, 0x00,             // push 0x401000
+                0xC7, 0x45, 0xFC, 0x00, 0x00, 0x00, 0x00, // mov dword [ebp-4], 0
+                0x66, 0xC7, 0x06, 0x01, 0x00,             // mov word [esi], 1
+                0xF7, 0xC1, 0x01, 0x00, 0x00, 0x00,       // test ecx, 1
+                0xF7, 0xD8,                               // neg eax
+                0x85, 0xC9,                               // test ecx, ecx
+                0x33, 0xC0,                               // xor eax, eax
+                0x3D, 0x00, 0x01, 0x00, 0x00,             // cmp eax, 0x100
+                0x8D, 0x4C, 0x24, 0x10,                   // lea ecx, [esp+0x10]
+                0x0F, 0xB6, 0x46, 0x04,                   // movzx eax, byte [esi+4]
+                0xC1, 0xE0, 0x04,                         // shl eax, 4
+                0xFF, 0x74, 0x24, 0x04,                   // push [esp+4]
+                0xFF, 0x15, 0x00, 0x10, 0x40, 0x00,       // call [0x401000]
+                0xB8, 0x01, 0x00, 0x00, 0x00,             // mov eax, 1
+                0xE8, 0x00, 0x00, 0x00, 0x00,             // call next
+                0x90,                                     // nop
+        };
+
+        std::vector<uint32_t> ours;
+        for (size_t offset = 0; offset < code.size();) {
+            size_t length = X86InstructionLength(code.data() + offset);
+            ASSERT_NE(0u, length) << "at offset " << offset;
+            ours.push_back(kFunction + static_cast<uint32_t>(offset));
+            offset += length;
+        }
+
+        std::vector<uint32_t> theirs;
+        for (const auto &instruction: Disassemble(code, kFunction)) {
+            theirs.push_back(instruction.address);
+        }
+        EXPECT_EQ(theirs, ours);
+    }
+
+    TEST(X86CodegenTest, TrampolineRunsStolenInstructionsThenJumpsBack) {
+        if (!HaveObjdump()) {
+            GTEST_SKIP() << "objdump not installed";
+        }
+
+        size_t stolen = 0;
+        auto trampoline = Trampoline({0x55, 0x8B, 0xEC, 0x83, 0xEC, 0x10, 0x56}, stolen);
+        EXPECT_EQ(6u, stolen);
+
+        std::vector<std::string> expected{"push ebp", "mov ebp,esp", "sub esp,0x10", "jmp 0x607da6"};
+        EXPECT_EQ(expected, Texts(Disassemble(trampoline, kTrampoline)));
+    }
+
+    TEST(X86CodegenTest, RelativeCallsAreRelocated) {
+        if (!HaveObjdump()) {
+            GTEST_SKIP() << "objdump not installed";
+        }
+
+        // call 0x401000, mov eax, [ecx+8]
+        std::vector<uint8_t> function{0xE8, 0x00, 0x00, 0x00, 0x00, 0x8B, 0x41, 0x08};
+        WriteRel32(function.data(), kFunction, kCallRel32Opcode, 0x00401000);
+
+        size_t stolen = 0;
+        auto trampoline = Trampoline(function, stolen);
+        EXPECT_EQ(5u, stolen);
+
+        std::vector<std::string> expected{"call 0x401000", "jmp 0x607da5"};
+        EXPECT_EQ(expected, Texts(Disassemble(trampoline, kTrampoline)));
+    }
+
+    TEST(X86CodegenTest, DetourJumpsToHandlerAndPadsTheRest) {
+        if (!HaveObjdump()) {
+            GTEST_SKIP() << "objdump not installed";
+        }
+
+        std::vector<uint8_t> function{0x55, 0x8B, 0xEC, 0x83, 0xEC, 0x10, 0x56};
+        WriteDetourJump(function.data(), kFunction, kHandler, 6);
+
+        std::vector<std::string> expected{"jmp 0x10002000", "int3", "push esi"};
+        EXPECT_EQ(expected, Texts(Disassemble(function, kFunction)));
+    }
+
+    TEST(X86CodegenTest, Rel32RoundTripsBackwards) {
+        uint8_t code[kRel32Size];
+        WriteRel32(code, kTrampoline, kJmpRel32Opcode, kFunction);
+        EXPECT_EQ(kJmpRel32Opcode, code[0]);
+        EXPECT_EQ(kFunction, Rel32Target(code, kTrampoline));
+    }
+
+    TEST(X86CodegenTest, RefusesCodeThatCantMove) {
+        size_t stolen = 0;
+        // push ebp, je +2 would jump back into the overwritten bytes
+        Trampoline({0x55, 0x74, 0x02, 0x8B, 0xEC, 0x90}, stolen);
+        EXPECT_EQ(0u, stolen);
+
+        // ret before the jump fits
+        Trampoline({0x33, 0xC0, 0xC3}, stolen);
+        EXPECT_EQ(0u, stolen);
+
+        // call rel16
+        uint8_t prefixed[] = {0x66, 0xE8, 0x00, 0x00};
+        EXPECT_EQ(0u, X86InstructionLength(prefixed));
+    }
+}
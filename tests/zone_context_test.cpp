@@ -0,0 +1,61 @@
+#include "test_helpers.hpp"
+#include "unit_cache.hpp"
+#include "zone_context.hpp"
+
+namespace perf_boost {
+    class ZoneContextTest : public CoreTest {
+    };
+
+    TEST_F(ZoneContextTest, BuiltInTable) {
+        EXPECT_EQ(ZONE_CONTEXT_CITY, ClassifyArea(1537));
+        EXPECT_EQ(ZONE_CONTEXT_CITY, ClassifyArea(75));
+        EXPECT_EQ(ZONE_CONTEXT_RAID, ClassifyArea(3456));
+        EXPECT_EQ(ZONE_CONTEXT_DUNGEON, ClassifyArea(1584));
+        EXPECT_EQ(ZONE_CONTEXT_BATTLEGROUND, ClassifyArea(3277));
+        EXPECT_EQ(ZONE_CONTEXT_OUTDOOR, ClassifyArea(12));
+        EXPECT_EQ(ZONE_CONTEXT_OUTDOOR, ClassifyArea(0));
+    }
+
+    TEST_F(ZoneContextTest, OverridesWinOverTable) {
+        updateFromCvar("PB_ZoneContexts", "1519:outdoor, 33:city,bad,44:nowhere");
+
+        ASSERT_EQ(2u, zoneContextOverrides.size());
+        EXPECT_EQ(ZONE_CONTEXT_OUTDOOR, ClassifyArea(1519));
+        EXPECT_EQ(ZONE_CONTEXT_CITY, ClassifyArea(33));
+        EXPECT_EQ(ZONE_CONTEXT_CITY, ClassifyArea(1537));
+    }
+
+    TEST_F(ZoneContextTest, ChangesReportedOnce) {
+        world().SetZoneAreaId(1537);
+        EXPECT_TRUE(UpdateZoneContext());
+        EXPECT_FALSE(UpdateZoneContext());
+        EXPECT_EQ(ZONE_CONTEXT_CITY, CurrentZone().context);
+
+        // unrelated settings don't count as a change, reclassifying the current zone does
+        updateFromCvar("PB_PlayerRenderDist", "50");
+        EXPECT_FALSE(UpdateZoneContext());
+        updateFromCvar("PB_ZoneContexts", "1537:outdoor");
+        EXPECT_TRUE(UpdateZoneContext());
+        EXPECT_EQ(ZONE_CONTEXT_OUTDOOR, CurrentZone().context);
+
+        world().SetZoneAreaId(3456);
+        EXPECT_TRUE(UpdateZoneContext());
+        EXPECT_EQ(3456u, CurrentZone().areaId);
+        EXPECT_EQ(ZONE_CONTEXT_RAID, CurrentZone().context);
+    }
+
+    TEST_F(ZoneContextTest, ZoneChangeDropsUnitCache) {
+        world().AddUnit(10, 60, At(5.0f));
+        BeginFrame();
+        shouldRenderObject(world().Find(10)->ptr(), 1);
+        EXPECT_EQ(1u, UnitClassCacheSize());
+
+        BeginFrame();
+        EXPECT_EQ(1u, UnitClassCacheSize());
+
+        world().SetZoneAreaId(1637);
+        BeginFrame();
+        EXPECT_EQ(0u, UnitClassCacheSize());
+        EXPECT_TRUE(gPlayerInCity);
+    }
+}
@@ -0,0 +1,77 @@
+// Replays a trace captured in game with /run SetCVar("PB_CaptureTrace", 1) and reports what perf_boost decided and
+// how long it took.  Any PB_Name=value arguments override the recorded settings.
+//
+//   perf_boost_replay perf_boost_1700000000.pbtrace PB_PlayerRenderDist=40
+
+#include "replay.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using perf_boost::sim::ReplayCounter;
+using perf_boost::sim::Replayer;
+using perf_boost::sim::SimObjectManager;
+
+namespace {
+    void PrintCounter(const char *name, const ReplayCounter &counter) {
+        if (counter.calls == 0) {
+            return;
+        }
+
+        double hiddenPercent = 100.0 * counter.hidden / counter.calls;
+        double averageNs = static_cast<double>(counter.nanoseconds) / counter.calls;
+        std::printf("%-22s %10llu calls %10llu hidden (%5.1f%%) %10.3f ms total %8.1f ns/call\n", name,
+                    static_cast<unsigned long long>(counter.calls), static_cast<unsigned long long>(counter.hidden),
+                    hiddenPercent, counter.nanoseconds / 1e6, averageNs);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <trace.pbtrace> [PB_Name=value ...]\n", argv[0]);
+        return 2;
+    }
+
+    Replayer replayer(SimObjectManager::Instance());
+    for (int i = 2; i < argc; ++i) {
+        auto separator = std::strchr(argv[i], '=');
+        if (!separator) {
+            std::fprintf(stderr, "ignoring %s, expected PB_Name=value\n", argv[i]);
+            continue;
+        }
+        replayer.SetOverride(std::string(argv[i], separator), separator + 1);
+    }
+
+    bool complete = replayer.Replay(argv[1]);
+    auto &stats = replayer.stats();
+    if (stats.records == 0 && !complete) {
+        std::fprintf(stderr, "unable to read trace %s\n", argv[1]);
+        return 1;
+    }
+    if (!complete) {
+        std::fprintf(stderr, "trace is truncated, reporting the %llu records read\n",
+                     static_cast<unsigned long long>(stats.records));
+    }
+
+    std::printf("%llu records, %llu frames\n", static_cast<unsigned long long>(stats.records),
+                static_cast<unsigned long long>(stats.frames));
+    PrintCounter("ShouldRender", stats.shouldRender);
+    PrintCounter("Spell visual", stats.spellVisual);
+    PrintCounter("Ground effect", stats.groundEffect);
+    PrintCounter("Aura visual", stats.auraVisual);
+    PrintCounter("Channel visual", stats.channelVisual);
+    PrintCounter("Dynamic object visual", stats.dynamicObjectVisual);
+    PrintCounter("Unit signal", stats.unitSignal);
+
+    std::printf("%llu ShouldRender answers changed by perf_boost", static_cast<unsigned long long>(stats.changedByPerfBoost));
+    if (stats.frames > 0) {
+        std::printf(", %.1f per frame", static_cast<double>(stats.changedByPerfBoost) / stats.frames);
+    }
+    std::printf("\n");
+    if (stats.missingCasters > 0) {
+        std::printf("%llu visuals skipped, caster never seen\n", static_cast<unsigned long long>(stats.missingCasters));
+    }
+
+    return complete ? 0 : 1;
+}